@@ -2,6 +2,30 @@
 #ifndef ALGO_H
 #define ALGO_H
 
+#include "configure.h"
+#include "iterator_imp.h"
+#include <algorithm>
+
+STL_BEGIN_NAMESPACE
+
+//被搜索的区间是否比目标区间短
+//只有两个都是随机访问迭代器时才能直接比较长度
+template<class ForwardIter1,class ForwardIter2>
+inline bool __search_too_short(ForwardIter1,ForwardIter1,
+                               ForwardIter2,ForwardIter2,
+                               forward_iterator_tag,forward_iterator_tag)
+{
+    return false;
+}
+
+template<class RandomAccessIter1,class RandomAccessIter2>
+inline bool __search_too_short(RandomAccessIter1 first1,RandomAccessIter1 last1,
+                               RandomAccessIter2 first2,RandomAccessIter2 last2,
+                               random_access_iterator_tag,random_access_iterator_tag)
+{
+    return (last1 - first1) < (last2 - first2);
+}
+
 //在[first1,last1]中寻找第一次出现[first2,last2]的位置
 template<class ForwardIter1,class ForwardIter2,class BinaryPred>
 ForwardIter1 search(ForwardIter1 first1,ForwardIter1 last1,
@@ -12,6 +36,10 @@ ForwardIter1 search(ForwardIter1 first1,ForwardIter1 last1,
     if(first1 == last1 || first2 == last2)
         return first1;
 
+    if(__search_too_short(first1,last1,first2,last2,
+                          iterator_category(first1),iterator_category(first2)))
+        return last1;
+
     //被搜索的对象只有一个元素
     ForwardIter2 tmp(first2);
     ++tmp;
@@ -34,14 +62,6 @@ ForwardIter1 search(ForwardIter1 first1,ForwardIter1 last1,
     while(first1 != last1)
     {
         //定位第1个相等的元素
-        while(first1 != last1)
-        {
-            if(predicate(*first1,*first2))
-                break;
-            ++first1;
-        }
-
-        //这与上面重复
         while(first1 != last1 && !predicate(*first1,*first2))
             ++first1;
 
@@ -74,38 +94,76 @@ ForwardIter1 search(ForwardIter1 first1,ForwardIter1 last1,
 }
 
 //在first1到last1中寻找first2到last2最后出现的位置
+//前向迭代器：反复向前搜索，保留最后一次的结果
 template<class ForwardIter1,class ForwardIter2,
          class BinaryPredicate>
-ForwardIter1 find_end(ForwardIter1 first1,ForwardIter1 last1,
-                      ForwardIter2 first2,ForwardIter2 last2,
-                      BinaryPredicate comp)
+ForwardIter1 __find_end(ForwardIter1 first1,ForwardIter1 last1,
+                        ForwardIter2 first2,ForwardIter2 last2,
+                        BinaryPredicate comp,
+                        forward_iterator_tag,forward_iterator_tag)
 {
-    //被查找的字符串为空
-    if(first2 == last2)
+    ForwardIter1 result = last1;
+    while(1)
     {
-        return last1;
-    }
-    else
-    {
-        ForwardIter1 result = last1;
-        while(1)
+        ForwardIter1 new_result = search(first1,last1,first2,last2,comp);
+
+        //找到最后一个目标数据或者没有找到目标数据
+        if(new_result == last1)
+            return result;
+        else
         {
-            ForwardIter1 new_result = search(first1,last1,first2,last2,comp);
-
-            //找到最后一个目标数据或者没有找到目标数据
-            if(new_result == last1)
-                return result;
-            else
-            {
-                //保留本次搜索结果
-                result = new_result;
-                first1 = new_result;
-                ++first1;
-            }
+            //保留本次搜索结果
+            result = new_result;
+            first1 = new_result;
+            ++first1;
         }
     }
 }
 
+//双向迭代器：用逆向迭代器从后向前搜索一次
+template<class BidirectionalIter1,class BidirectionalIter2,
+         class BinaryPredicate>
+BidirectionalIter1 __find_end(BidirectionalIter1 first1,BidirectionalIter1 last1,
+                              BidirectionalIter2 first2,BidirectionalIter2 last2,
+                              BinaryPredicate comp,
+                              bidirectional_iterator_tag,bidirectional_iterator_tag)
+{
+    typedef iterator_traits<BidirectionalIter1> traits1;
+    typedef iterator_traits<BidirectionalIter2> traits2;
+    typedef reverse_iterator<BidirectionalIter1,typename traits1::value_type,
+                             typename traits1::reference,
+                             typename traits1::difference_type> RevIter1;
+    typedef reverse_iterator<BidirectionalIter2,typename traits2::value_type,
+                             typename traits2::reference,
+                             typename traits2::difference_type> RevIter2;
+
+    RevIter1 rlast1(first1);
+    RevIter2 rlast2(first2);
+    RevIter1 rresult = search(RevIter1(last1),rlast1,RevIter2(last2),rlast2,comp);
+
+    if(rresult == rlast1)
+        return last1;
+
+    //rresult.base()是匹配区间的结束位置
+    BidirectionalIter1 result = rresult.base();
+    advance(result,-distance(first2,last2));
+    return result;
+}
+
+template<class ForwardIter1,class ForwardIter2,
+         class BinaryPredicate>
+inline ForwardIter1 find_end(ForwardIter1 first1,ForwardIter1 last1,
+                             ForwardIter2 first2,ForwardIter2 last2,
+                             BinaryPredicate comp)
+{
+    //被查找的字符串为空
+    if(first2 == last2)
+        return last1;
+
+    return __find_end(first1,last1,first2,last2,comp,
+                      iterator_category(first1),iterator_category(first2));
+}
+
 //在[first1,last1]中找到第一个在[first2,last2]中任意一个字符
 template<class InputIter,class ForwardIter,class BinaryPredicate>
 InputIter __find_first_of(InputIter first1,InputIter last1,
@@ -138,4 +196,29 @@ InputIter __find_first_not_of(InputIter first1,InputIter last1,
     return last1;
 }
 
+//反转[first,last)
+template<class BidirectionalIter>
+void reverse(BidirectionalIter first,BidirectionalIter last)
+{
+    while(first != last && first != --last)
+    {
+        std::swap(*first,*last);
+        ++first;
+    }
+}
+
+//把[middle,last)移到[first,middle)之前，两段各自的顺序不变：
+//先分别反转两段，再整体反转
+template<class BidirectionalIter>
+void rotate(BidirectionalIter first,BidirectionalIter middle,BidirectionalIter last)
+{
+    if(first == middle || middle == last)
+        return;
+    reverse(first,middle);
+    reverse(middle,last);
+    reverse(first,last);
+}
+
+STL_END_NAMESPACE
+
 #endif // ALGO_H
@@ -4,6 +4,15 @@
 #define ALGOBASE_H
 
 #include "configure.h"
+#include "type_traits.h"
+#include "iterator_imp.h"
+#include <string.h>
+#include <limits.h>
+
+#if defined(__SSE2__) && defined(__GNUC__)
+#   include <emmintrin.h>
+#   define STL_SSE2_MISMATCH
+#endif
 
 STL_BEGIN_NAMESPACE
 
@@ -37,6 +46,72 @@ inline OutputIter fill_n(OutputIter first,Size n,const Tp& value)
     return first;
 }
 
+//平凡类型的填充：先把值复制到局部变量，循环中没有别名，编译器可以向量化
+template<class Tp,class Size>
+inline Tp* __fill_n_trivial(Tp* first,Size n,const Tp x)
+{
+    for(;n > 0;--n,++first)
+        *first = x;
+    return first;
+}
+
+//单字节类型使用memset
+template<class Size>
+inline char* __fill_n_trivial(char* first,Size n,const char x)
+{
+    if(n <= 0)
+        return first;
+    memset(first,(unsigned char)x,(size_t)n);
+    return first + n;
+}
+
+template<class Size>
+inline signed char* __fill_n_trivial(signed char* first,Size n,const signed char x)
+{
+    if(n <= 0)
+        return first;
+    memset(first,(unsigned char)x,(size_t)n);
+    return first + n;
+}
+
+template<class Size>
+inline unsigned char* __fill_n_trivial(unsigned char* first,Size n,const unsigned char x)
+{
+    if(n <= 0)
+        return first;
+    memset(first,x,(size_t)n);
+    return first + n;
+}
+
+template<class Tp,class Size,class Up>
+inline Tp* __fill_n_aux(Tp* first,Size n,const Up& value,__false_type)
+{
+    for(;n > 0;--n,++first)
+        *first = value;
+    return first;
+}
+
+template<class Tp,class Size,class Up>
+inline Tp* __fill_n_aux(Tp* first,Size n,const Up& value,__true_type)
+{
+    return __fill_n_trivial(first,n,Tp(value));
+}
+
+//指针区间：按赋值操作是否平凡分派
+template<class Tp,class Up>
+inline void fill(Tp* first,Tp* last,const Up& value)
+{
+    typedef typename __type_traits<Tp>::has_trivial_assignment_operator trivial_assign;
+    __fill_n_aux(first,last - first,value,trivial_assign());
+}
+
+template<class Tp,class Size,class Up>
+inline Tp* fill_n(Tp* first,Size n,const Up& value)
+{
+    typedef typename __type_traits<Tp>::has_trivial_assignment_operator trivial_assign;
+    return __fill_n_aux(first,n,value,trivial_assign());
+}
+
 //将first到last元素以result开始向后复制
 template<class InputIter,class OutputIter>
 inline OutputIter copy(InputIter first,InputIter last,OutputIter result)
@@ -55,17 +130,352 @@ inline OutputIter copy_backward(InputIter first,InputIter last,OutputIter result
     return result;
 }
 
-template<class InputIter,class Distance>
-inline void distance(InputIter first,InputIter last,Distance& n)
+//将first到last的元素移动到result开始的区域，元素之间的赋值使用移动赋值
+template<class InputIter,class OutputIter>
+inline OutputIter move(InputIter first,InputIter last,OutputIter result)
+{
+    for(;first != last;++first,++result)
+        *result = STL_MOVE(*first);
+    return result;
+}
+
+//将first到last的元素移动到以result结束的区域，从后向前移动
+template<class InputIter,class OutputIter>
+inline OutputIter move_backward(InputIter first,InputIter last,OutputIter result)
+{
+    for(;first != last;)
+        *--result = STL_MOVE(*--last);
+    return result;
+}
+
+//平凡类型的复制：按字节复制，区间可以重叠
+//空区间不调用memmove：目标可能是分配0个元素得到的空指针
+template<class Tp>
+inline Tp* __copy_trivial(const Tp* first,const Tp* last,Tp* result)
+{
+    const ptrdiff_t n = last - first;
+    if(n > 0 && result != 0)
+        memmove((void*)result,(const void*)first,n * sizeof(Tp));
+    return result + n;
+}
+
+template<class Tp>
+inline Tp* __copy_backward_trivial(const Tp* first,const Tp* last,Tp* result)
+{
+    const ptrdiff_t n = last - first;
+    if(n > 0)
+        memmove((void*)(result - n),(const void*)first,n * sizeof(Tp));
+    return result - n;
+}
+
+template<class Tp>
+inline Tp* __copy_aux(const Tp* first,const Tp* last,Tp* result,__false_type)
+{
+    for(;first != last;++first,++result)
+        *result = *first;
+    return result;
+}
+
+template<class Tp>
+inline Tp* __copy_aux(const Tp* first,const Tp* last,Tp* result,__true_type)
+{
+    return __copy_trivial(first,last,result);
+}
+
+template<class Tp>
+inline Tp* __copy_backward_aux(const Tp* first,const Tp* last,Tp* result,__false_type)
+{
+    for(;first != last;)
+        *--result = *--last;
+    return result;
+}
+
+template<class Tp>
+inline Tp* __copy_backward_aux(const Tp* first,const Tp* last,Tp* result,__true_type)
+{
+    return __copy_backward_trivial(first,last,result);
+}
+
+//指针区间：赋值操作平凡时使用memmove
+template<class Tp>
+inline Tp* copy(const Tp* first,const Tp* last,Tp* result)
+{
+    typedef typename __type_traits<Tp>::has_trivial_assignment_operator trivial_assign;
+    return __copy_aux(first,last,result,trivial_assign());
+}
+
+template<class Tp>
+inline Tp* copy(Tp* first,Tp* last,Tp* result)
+{
+    typedef typename __type_traits<Tp>::has_trivial_assignment_operator trivial_assign;
+    return __copy_aux((const Tp*)first,(const Tp*)last,result,trivial_assign());
+}
+
+template<class Tp>
+inline Tp* copy_backward(const Tp* first,const Tp* last,Tp* result)
+{
+    typedef typename __type_traits<Tp>::has_trivial_assignment_operator trivial_assign;
+    return __copy_backward_aux(first,last,result,trivial_assign());
+}
+
+template<class Tp>
+inline Tp* copy_backward(Tp* first,Tp* last,Tp* result)
+{
+    typedef typename __type_traits<Tp>::has_trivial_assignment_operator trivial_assign;
+    return __copy_backward_aux((const Tp*)first,(const Tp*)last,result,trivial_assign());
+}
+
+template<class Tp>
+inline Tp* __move_aux(Tp* first,Tp* last,Tp* result,__false_type)
+{
+    for(;first != last;++first,++result)
+        *result = STL_MOVE(*first);
+    return result;
+}
+
+template<class Tp>
+inline Tp* __move_aux(Tp* first,Tp* last,Tp* result,__true_type)
+{
+    return __copy_trivial((const Tp*)first,(const Tp*)last,result);
+}
+
+template<class Tp>
+inline Tp* __move_backward_aux(Tp* first,Tp* last,Tp* result,__false_type)
+{
+    for(;first != last;)
+        *--result = STL_MOVE(*--last);
+    return result;
+}
+
+template<class Tp>
+inline Tp* __move_backward_aux(Tp* first,Tp* last,Tp* result,__true_type)
+{
+    return __copy_backward_trivial((const Tp*)first,(const Tp*)last,result);
+}
+
+//指针区间：赋值操作平凡时移动就是memmove
+template<class Tp>
+inline Tp* move(Tp* first,Tp* last,Tp* result)
+{
+    typedef typename __type_traits<Tp>::has_trivial_assignment_operator trivial_assign;
+    return __move_aux(first,last,result,trivial_assign());
+}
+
+template<class Tp>
+inline Tp* move_backward(Tp* first,Tp* last,Tp* result)
+{
+    typedef typename __type_traits<Tp>::has_trivial_assignment_operator trivial_assign;
+    return __move_backward_aux(first,last,result,trivial_assign());
+}
+
+//////////////////////////////////////////
+//equal()和lexicographical_compare()函数
+
+//first1到last1与first2开始的区间是否相等
+template<class InputIter1,class InputIter2>
+inline bool equal(InputIter1 first1,InputIter1 last1,InputIter2 first2)
+{
+    for(;first1 != last1;++first1,++first2)
+        if(!(*first1 == *first2))
+            return false;
+    return true;
+}
+
+template<class InputIter1,class InputIter2,class BinaryPredicate>
+inline bool equal(InputIter1 first1,InputIter1 last1,InputIter2 first2,
+                  BinaryPredicate pred)
 {
-    n = 0;
-    while(first != last)
+    for(;first1 != last1;++first1,++first2)
+        if(!pred(*first1,*first2))
+            return false;
+    return true;
+}
+
+template<class Tp>
+inline bool __equal_aux(const Tp* first1,const Tp* last1,const Tp* first2,
+                        __false_type)
+{
+    for(;first1 != last1;++first1,++first2)
+        if(!(*first1 == *first2))
+            return false;
+    return true;
+}
+
+//整数相等等价于所有字节相等
+template<class Tp>
+inline bool __equal_aux(const Tp* first1,const Tp* last1,const Tp* first2,
+                        __true_type)
+{
+    const size_t n = (last1 - first1) * sizeof(Tp);
+    return n == 0 || memcmp(first1,first2,n) == 0;
+}
+
+//指针区间：整数类型使用memcmp
+template<class Tp>
+inline bool equal(const Tp* first1,const Tp* last1,const Tp* first2)
+{
+    typedef typename __is_integer<Tp>::integral integral;
+    return __equal_aux(first1,last1,first2,integral());
+}
+
+template<class Tp>
+inline bool equal(Tp* first1,Tp* last1,Tp* first2)
+{
+    typedef typename __is_integer<Tp>::integral integral;
+    return __equal_aux((const Tp*)first1,(const Tp*)last1,(const Tp*)first2,
+                       integral());
+}
+
+//返回两段内存中第一个不相同的字节的位置，全部相同时返回n
+//支持SSE2时每次比较32字节
+inline size_t __mismatch_bytes(const void* p1,const void* p2,size_t n)
+{
+    const unsigned char* a = (const unsigned char*)p1;
+    const unsigned char* b = (const unsigned char*)p2;
+    size_t i = 0;
+
+#ifdef STL_SSE2_MISMATCH
+    for(;i + 32 <= n;i += 32)
+    {
+        const __m128i eq0 = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(a + i)),
+                                           _mm_loadu_si128((const __m128i*)(b + i)));
+        const __m128i eq1 = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(a + i + 16)),
+                                           _mm_loadu_si128((const __m128i*)(b + i + 16)));
+        if(_mm_movemask_epi8(_mm_and_si128(eq0,eq1)) != 0xFFFF)
+        {
+            const unsigned mask0 = (unsigned)_mm_movemask_epi8(eq0) ^ 0xFFFFu;
+            if(mask0 != 0)
+                return i + __builtin_ctz(mask0);
+            return i + 16 + __builtin_ctz((unsigned)_mm_movemask_epi8(eq1) ^ 0xFFFFu);
+        }
+    }
+
+    if(i + 16 <= n)
+    {
+        const __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(a + i)),
+                                          _mm_loadu_si128((const __m128i*)(b + i)));
+        const unsigned mask = (unsigned)_mm_movemask_epi8(eq) ^ 0xFFFFu;
+        if(mask != 0)
+            return i + __builtin_ctz(mask);
+        i += 16;
+    }
+#endif
+
+    for(;i < n;++i)
+        if(a[i] != b[i])
+            return i;
+    return n;
+}
+
+//first1到last1是否按字典序小于first2到last2
+template<class InputIter1,class InputIter2>
+bool lexicographical_compare(InputIter1 first1,InputIter1 last1,
+                             InputIter2 first2,InputIter2 last2)
+{
+    for(;first1 != last1 && first2 != last2;++first1,++first2)
     {
-        ++first;
-        ++n;
+        if(*first1 < *first2)
+            return true;
+        if(*first2 < *first1)
+            return false;
     }
+    return first1 == last1 && first2 != last2;
 }
 
+template<class InputIter1,class InputIter2,class Compare>
+bool lexicographical_compare(InputIter1 first1,InputIter1 last1,
+                             InputIter2 first2,InputIter2 last2,
+                             Compare comp)
+{
+    for(;first1 != last1 && first2 != last2;++first1,++first2)
+    {
+        if(comp(*first1,*first2))
+            return true;
+        if(comp(*first2,*first1))
+            return false;
+    }
+    return first1 == last1 && first2 != last2;
+}
+
+//整数区间：先按字节找到第一个不相同的元素，再比较这个元素
+template<class Tp>
+inline bool __lexicographical_compare_integral(const Tp* first1,const Tp* last1,
+                                               const Tp* first2,const Tp* last2)
+{
+    const size_t n1 = last1 - first1;
+    const size_t n2 = last2 - first2;
+    const size_t n = n1 < n2 ? n1 : n2;
+    const size_t i = __mismatch_bytes(first1,first2,n * sizeof(Tp)) / sizeof(Tp);
+
+    if(i < n)
+        return first1[i] < first2[i];
+    return n1 < n2;
+}
+
+//无符号单字节类型的字典序就是memcmp的顺序
+inline bool __lexicographical_compare_integral(const unsigned char* first1,
+                                               const unsigned char* last1,
+                                               const unsigned char* first2,
+                                               const unsigned char* last2)
+{
+    const size_t n1 = last1 - first1;
+    const size_t n2 = last2 - first2;
+    const size_t n = n1 < n2 ? n1 : n2;
+    const int cmp = n == 0 ? 0 : memcmp(first1,first2,n);
+    return cmp != 0 ? cmp < 0 : n1 < n2;
+}
+
+#if CHAR_MIN == 0
+inline bool __lexicographical_compare_integral(const char* first1,const char* last1,
+                                               const char* first2,const char* last2)
+{
+    return __lexicographical_compare_integral((const unsigned char*)first1,
+                                              (const unsigned char*)last1,
+                                              (const unsigned char*)first2,
+                                              (const unsigned char*)last2);
+}
+#endif
+
+template<class Tp>
+inline bool __lexicographical_compare_aux(const Tp* first1,const Tp* last1,
+                                          const Tp* first2,const Tp* last2,
+                                          __false_type)
+{
+    for(;first1 != last1 && first2 != last2;++first1,++first2)
+    {
+        if(*first1 < *first2)
+            return true;
+        if(*first2 < *first1)
+            return false;
+    }
+    return first1 == last1 && first2 != last2;
+}
+
+template<class Tp>
+inline bool __lexicographical_compare_aux(const Tp* first1,const Tp* last1,
+                                          const Tp* first2,const Tp* last2,
+                                          __true_type)
+{
+    return __lexicographical_compare_integral(first1,last1,first2,last2);
+}
+
+//指针区间：整数类型使用memcmp或者SIMD查找第一个不相同的元素
+template<class Tp>
+inline bool lexicographical_compare(const Tp* first1,const Tp* last1,
+                                    const Tp* first2,const Tp* last2)
+{
+    typedef typename __is_integer<Tp>::integral integral;
+    return __lexicographical_compare_aux(first1,last1,first2,last2,integral());
+}
+
+template<class Tp>
+inline bool lexicographical_compare(Tp* first1,Tp* last1,Tp* first2,Tp* last2)
+{
+    typedef typename __is_integer<Tp>::integral integral;
+    return __lexicographical_compare_aux((const Tp*)first1,(const Tp*)last1,
+                                         (const Tp*)first2,(const Tp*)last2,
+                                         integral());
+}
 
 STL_END_NAMESPACE
 
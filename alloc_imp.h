@@ -5,7 +5,10 @@
 #define ALLOC_IMP_H
 
 #include "configure.h"
+#include "type_traits.h"
+#include <stddef.h>
 #include <stdlib.h>
+#include <string.h>
 
 STL_BEGIN_NAMESPACE
 
@@ -48,8 +51,8 @@ public:
         free(p);
     }
 
-    //重新分配内存
-    static void reallocate(void *p,size_t old_sz,size_t new_sz)
+    //重新分配内存，可能原地扩充，大块内存由realloc使用mremap搬移
+    static void* reallocate(void *p,size_t old_sz,size_t new_sz)
     {
         void* result = realloc(p,new_sz);
         if(result == 0)
@@ -57,6 +60,26 @@ public:
 
         return result;
     }
+
+    //申请n字节时malloc至少提供的字节数，容器扩容时可以用满。
+    //按glibc的块格式做的保守估计：加上一个size_t的头部后按2个size_t对齐，
+    //最小4个size_t。堆上的块与malloc_usable_size相等；mmap的块按页分配，
+    //实际更大，但mmap阈值是动态调整的，不能据此假设，所以也只返回这个下界
+    static size_t good_size(size_t n)
+    {
+#ifdef __GLIBC__
+        const size_t header = sizeof(size_t);
+        const size_t align = 2 * sizeof(size_t);
+        if(n > (size_t)-1 - header - align)
+            return n;
+        size_t chunk = (n + header + align - 1) & ~(align - 1);
+        if(chunk < 4 * header)
+            chunk = 4 * header;
+        return chunk - header;
+#else
+        return n;
+#endif
+    }
 };
 
 template <int inst>
@@ -77,7 +100,313 @@ void* malloc_alloc_template<inst>::s_oom_realloc(void* p,size_t n)
 
 //这里没有搞明白为什么一定要使用模板，使用类也可以
 typedef malloc_alloc_template<0> malloc_alloc;
+
+
+///////////////////////////
+//自旋锁，保护内存池的全局数据
+//静态对象零初始化后即为未加锁状态
+struct STL_mutex_lock
+{
+    volatile int lock;
+
+    void acquire()
+    {
+#ifdef STL_THREADS
+        while(__sync_lock_test_and_set(&lock,1))
+        {
+            //只读等待，减少总线争用
+            while(lock)
+                ;
+        }
+#endif
+    }
+
+    void release()
+    {
+#ifdef STL_THREADS
+        __sync_lock_release(&lock);
+#endif
+    }
+};
+
+
+///////////////////////////
+//第二级分配器：小对象内存池
+//小于等于MAX_BYTES的内存从自由链表分配，自由链表为空时从内存池中
+//一次切出多个对象补充；大于MAX_BYTES的内存直接交给malloc_alloc。
+//释放的小对象只回到自由链表，不会还给系统。
+enum {ALIGN = 8};                           //小对象按8字节对齐
+enum {MAX_BYTES = 128};                     //小对象上限
+enum {NFREELISTS = MAX_BYTES / ALIGN};      //自由链表个数
+
+template<bool threads,int inst>
+class default_alloc_template
+{
+private:
+    //将bytes上调至8的倍数
+    static size_t round_up(size_t bytes)
+    {
+        return (bytes + ALIGN - 1) & ~((size_t)ALIGN - 1);
+    }
+
+    //自由链表节点，未分配时存放下一个节点的地址
+    union obj
+    {
+        union obj* free_list_link;
+        char client_data[1];
+    };
+
+    //根据bytes选择自由链表，从0开始
+    static size_t freelist_index(size_t bytes)
+    {
+        return (bytes + ALIGN - 1) / ALIGN - 1;
+    }
+
+    //自由链表为空时，返回一个大小为n的对象，并补充自由链表
+    static void* s_refill(size_t n);
+
+    //从内存池中分配nobjs个size大小的对象，内存不足时nobjs会被减少
+    static char* s_chunk_alloc(size_t size,int& nobjs);
+
+    static obj* volatile s_free_list[NFREELISTS];
+
+    //内存池的起止位置，只在s_chunk_alloc中变化
+    static char* s_start_free;
+    static char* s_end_free;
+    static size_t s_heap_size;
+
+    static STL_mutex_lock s_lock;
+
+    //多线程版本在作用域内持有锁
+    class lock_guard
+    {
+    public:
+        lock_guard() { if(threads) s_lock.acquire(); }
+        ~lock_guard() { if(threads) s_lock.release(); }
+    };
+    friend class lock_guard;
+
+public:
+    //分配内存
+    static void* allocate(size_t n)
+    {
+        if(n > (size_t)MAX_BYTES)
+            return malloc_alloc::allocate(n);
+
+        obj* volatile* my_free_list = s_free_list + freelist_index(n);
+        lock_guard guard;
+        obj* result = *my_free_list;
+        if(result == 0)
+            return s_refill(round_up(n));
+
+        *my_free_list = result->free_list_link;
+        return result;
+    }
+
+    //释放内存，n必须与分配时相同
+    static void deallocate(void* p,size_t n)
+    {
+        if(n > (size_t)MAX_BYTES)
+        {
+            malloc_alloc::deallocate(p,n);
+            return;
+        }
+
+        obj* q = (obj*)p;
+        obj* volatile* my_free_list = s_free_list + freelist_index(n);
+        lock_guard guard;
+        q->free_list_link = *my_free_list;
+        *my_free_list = q;
+    }
+
+    //重新分配内存，新旧大小都超过MAX_BYTES时使用realloc
+    static void* reallocate(void* p,size_t old_sz,size_t new_sz);
+
+    //申请n字节时实际提供的字节数：小对象为所在自由链表的大小
+    static size_t good_size(size_t n)
+    {
+        return n > (size_t)MAX_BYTES ? malloc_alloc::good_size(n) : round_up(n);
+    }
+};
+
+template<bool threads,int inst>
+void* default_alloc_template<threads,inst>::reallocate(void* p,size_t old_sz,size_t new_sz)
+{
+    if(old_sz > (size_t)MAX_BYTES && new_sz > (size_t)MAX_BYTES)
+        return malloc_alloc::reallocate(p,old_sz,new_sz);
+
+    //属于同一个自由链表
+    if(p != 0 && round_up(old_sz) == round_up(new_sz))
+        return p;
+
+    void* result = allocate(new_sz);
+    if(p != 0)
+    {
+        memcpy(result,p,new_sz > old_sz ? old_sz : new_sz);
+        deallocate(p,old_sz);
+    }
+    return result;
+}
+
+template<bool threads,int inst>
+void* default_alloc_template<threads,inst>::s_refill(size_t n)
+{
+    //默认一次取20个对象，第1个返回给调用者，其余挂到自由链表上
+    int nobjs = 20;
+    char* chunk = s_chunk_alloc(n,nobjs);
+
+    if(nobjs == 1)
+        return chunk;
+
+    obj* volatile* my_free_list = s_free_list + freelist_index(n);
+    obj* result = (obj*)chunk;
+    obj* next_obj = (obj*)(chunk + n);
+    obj* current_obj;
+    *my_free_list = next_obj;
+
+    for(int i = 1;;i++)
+    {
+        current_obj = next_obj;
+        next_obj = (obj*)((char*)next_obj + n);
+        if(nobjs - 1 == i)
+        {
+            current_obj->free_list_link = 0;
+            break;
+        }
+        else
+        {
+            current_obj->free_list_link = next_obj;
+        }
+    }
+
+    return result;
+}
+
+template<bool threads,int inst>
+char* default_alloc_template<threads,inst>::s_chunk_alloc(size_t size,int& nobjs)
+{
+    char* result;
+    size_t total_bytes = size * nobjs;
+    size_t bytes_left = s_end_free - s_start_free;
+
+    if(bytes_left >= total_bytes)
+    {
+        //内存池足够
+        result = s_start_free;
+        s_start_free += total_bytes;
+        return result;
+    }
+    else if(bytes_left >= size)
+    {
+        //内存池至少能提供一个对象
+        nobjs = (int)(bytes_left / size);
+        total_bytes = size * nobjs;
+        result = s_start_free;
+        s_start_free += total_bytes;
+        return result;
+    }
+    else
+    {
+        //新申请的大小为需求的两倍再加上随分配次数增长的附加量
+        size_t bytes_to_get = 2 * total_bytes + round_up(s_heap_size >> 4);
+
+        //内存池中的零头挂到对应的自由链表上
+        if(bytes_left > 0)
+        {
+            obj* volatile* my_free_list = s_free_list + freelist_index(bytes_left);
+            ((obj*)s_start_free)->free_list_link = *my_free_list;
+            *my_free_list = (obj*)s_start_free;
+        }
+
+        s_start_free = (char*)malloc(bytes_to_get);
+        if(s_start_free == 0)
+        {
+            //系统内存不足，从更大的自由链表中借一个对象充当内存池
+            obj* volatile* my_free_list;
+            obj* p;
+            for(size_t i = size;i <= (size_t)MAX_BYTES;i += ALIGN)
+            {
+                my_free_list = s_free_list + freelist_index(i);
+                p = *my_free_list;
+                if(p != 0)
+                {
+                    *my_free_list = p->free_list_link;
+                    s_start_free = (char*)p;
+                    s_end_free = s_start_free + i;
+                    return s_chunk_alloc(size,nobjs);
+                }
+            }
+
+            //实在没有内存，交给第一级分配器处理（抛出异常）
+            s_end_free = 0;
+            s_start_free = (char*)malloc_alloc::allocate(bytes_to_get);
+        }
+
+        s_heap_size += bytes_to_get;
+        s_end_free = s_start_free + bytes_to_get;
+        return s_chunk_alloc(size,nobjs);
+    }
+}
+
+template<bool threads,int inst>
+char* default_alloc_template<threads,inst>::s_start_free = 0;
+
+template<bool threads,int inst>
+char* default_alloc_template<threads,inst>::s_end_free = 0;
+
+template<bool threads,int inst>
+size_t default_alloc_template<threads,inst>::s_heap_size = 0;
+
+template<bool threads,int inst>
+STL_mutex_lock default_alloc_template<threads,inst>::s_lock;
+
+template<bool threads,int inst>
+typename default_alloc_template<threads,inst>::obj* volatile
+default_alloc_template<threads,inst>::s_free_list[NFREELISTS] =
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};
+
+#ifdef STL_THREADS
+#   define STL_NODE_ALLOCATOR_THREADS true
+#else
+#   define STL_NODE_ALLOCATOR_THREADS false
+#endif
+
+typedef default_alloc_template<STL_NODE_ALLOCATOR_THREADS,0> default_alloc;
+
+//容器默认使用的分配器，定义STL_USE_MALLOC时直接使用malloc
+#ifdef STL_USE_MALLOC
 typedef malloc_alloc alloc;
+#else
+typedef default_alloc alloc;
+#endif
+
+///////////////////////////
+//固定容量容器（static_vector、fixed_string）使用的分配器：
+//元素全部保存在对象内部，N为容量；需要申请内存说明超出了容量，抛出length_error
+#ifndef THROW_LENGTH_ERROR
+#   if !defined(STL_USE_EXCEPTIONS)
+#       include <stdio.h>
+#       define THROW_LENGTH_ERROR(what) fprintf(stderr,"%s\n",what);exit(1)
+#   else
+#       include <stdexcept>
+#       define THROW_LENGTH_ERROR(what) throw std::length_error(what)
+#   endif
+#endif
+
+template<size_t N>
+class fixed_capacity_alloc
+{
+public:
+    static void* allocate(size_t)
+    {
+        THROW_LENGTH_ERROR("fixed capacity exceeded");
+        return 0;
+    }
+
+    static void deallocate(void*,size_t)
+    {
+    }
+};
 
 
 
@@ -113,6 +442,90 @@ public:
     }
 };
 
+
+//分配器特性
+//has_reallocate：分配器提供reallocate(p,old_sz,new_sz)，可以原地扩充内存
+//good_size(n)：申请n字节时分配器实际提供的字节数，不知道时为n
+template<class Alloc>
+struct alloc_traits
+{
+    typedef __false_type has_reallocate;
+
+    static size_t good_size(size_t n)
+    {
+        return n;
+    }
+};
+
+template<int inst>
+struct alloc_traits<malloc_alloc_template<inst> >
+{
+    typedef __true_type has_reallocate;
+
+    static size_t good_size(size_t n)
+    {
+        return malloc_alloc_template<inst>::good_size(n);
+    }
+};
+
+template<bool threads,int inst>
+struct alloc_traits<default_alloc_template<threads,inst> >
+{
+    typedef __true_type has_reallocate;
+
+    static size_t good_size(size_t n)
+    {
+        return default_alloc_template<threads,inst>::good_size(n);
+    }
+};
+
+//保存分配器实例的封装，供容器的基类使用
+//分配器是私有基类：只有静态函数的分配器（alloc、malloc_alloc等）经空基类优化后
+//不占空间；有状态的分配器（例如polymorphic_allocator）随容器一起保存。
+//Alloc::allocate和Alloc::deallocate静态函数和成员函数都可以。
+template<class Tp,class Alloc>
+class alloc_holder : private Alloc
+{
+public:
+    alloc_holder(const Alloc& a)
+        : Alloc(a) {}
+
+    const Alloc& get_allocator() const
+    {
+        return *this;
+    }
+
+    //分配n个Tp类型对象的内存空间
+    Tp* allocate(size_t n)
+    {
+        return n == 0 ? 0 : (Tp*) Alloc::allocate(n * sizeof(Tp));
+    }
+
+    //释放n个Tp类型对象的内存空间
+    void deallocate(Tp* p,size_t n)
+    {
+        if(n != 0)
+            Alloc::deallocate(p,n * sizeof(Tp));
+    }
+
+    //把p的空间从old_n个对象调整为new_n个对象，只能用于可以按位搬移的Tp，
+    //并且alloc_traits<Alloc>::has_reallocate为真
+    Tp* reallocate(Tp* p,size_t old_n,size_t new_n)
+    {
+        if(old_n == 0)
+            return allocate(new_n);
+        return (Tp*) Alloc::reallocate(p,old_n * sizeof(Tp),new_n * sizeof(Tp));
+    }
+
+    //交换分配器
+    void swap_allocator(alloc_holder& x)
+    {
+        Alloc tmp = *this;
+        static_cast<Alloc&>(*this) = static_cast<const Alloc&>(x);
+        static_cast<Alloc&>(x) = tmp;
+    }
+};
+
 STL_END_NAMESPACE
 
 
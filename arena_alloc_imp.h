@@ -0,0 +1,224 @@
+//arena_alloc_imp.h
+//单调内存区分配器：顺序分配，释放为空操作，作用域结束时一次性回收
+
+#ifndef ARENA_ALLOC_IMP_H
+#define ARENA_ALLOC_IMP_H
+
+#include "configure.h"
+#include "alloc_imp.h"
+
+STL_BEGIN_NAMESPACE
+
+///////////////////////////
+//内存区
+//内存块串成链表，新块的大小按几何级数增长。分配只移动指针，
+//单个对象的释放只回收最后一次分配，其余内存在reset()或析构时统一释放。
+class arena
+{
+private:
+    //块头，数据紧跟在块头之后
+    struct block
+    {
+        block* prev;
+        size_t size;
+    };
+
+    block* m_head;          //最新的块
+    char* m_cur;            //当前块中的空闲位置
+    char* m_end;            //当前块的结束位置
+    size_t m_next_size;     //下一个块的数据大小
+    size_t m_initial_size;
+    size_t m_used;          //已分配的字节数
+
+    //不可复制
+    arena(const arena&);
+    arena& operator=(const arena&);
+
+    static size_t round_up(size_t bytes)
+    {
+        return (bytes + ALIGN - 1) & ~((size_t)ALIGN - 1);
+    }
+
+    //申请一个至少能容纳n字节的新块
+    void grow(size_t n)
+    {
+        size_t size = m_next_size;
+        while(size < n)
+            size *= 2;
+
+        block* b = (block*)malloc_alloc::allocate(sizeof(block) + size);
+        b->prev = m_head;
+        b->size = size;
+        m_head = b;
+        m_cur = (char*)(b + 1);
+        m_end = m_cur + size;
+        m_next_size = size * 2;
+    }
+
+public:
+    explicit arena(size_t initial_size = 4096)
+        : m_head(0),m_cur(0),m_end(0),
+          m_next_size(round_up(initial_size ? initial_size : (size_t)ALIGN)),
+          m_initial_size(m_next_size),m_used(0)
+    {}
+
+    ~arena()
+    {
+        release();
+    }
+
+    void* allocate(size_t n)
+    {
+        n = round_up(n);
+        if((size_t)(m_end - m_cur) < n)
+            grow(n);
+
+        void* result = m_cur;
+        m_cur += n;
+        m_used += n;
+        return result;
+    }
+
+    //只有最后一次分配能被回收，例如vector扩容前刚分配的缓冲区
+    void deallocate(void* p,size_t n)
+    {
+        n = round_up(n);
+        if((char*)p + n == m_cur)
+        {
+            m_cur = (char*)p;
+            m_used -= n;
+        }
+    }
+
+    //回收全部对象，保留最大（最新）的块供下次使用
+    void reset()
+    {
+        if(m_head == 0)
+            return;
+
+        block* b = m_head->prev;
+        while(b != 0)
+        {
+            block* prev = b->prev;
+            malloc_alloc::deallocate(b,sizeof(block) + b->size);
+            b = prev;
+        }
+
+        m_head->prev = 0;
+        m_cur = (char*)(m_head + 1);
+        m_end = m_cur + m_head->size;
+        m_used = 0;
+    }
+
+    //归还所有内存
+    void release()
+    {
+        while(m_head != 0)
+        {
+            block* prev = m_head->prev;
+            malloc_alloc::deallocate(m_head,sizeof(block) + m_head->size);
+            m_head = prev;
+        }
+
+        m_cur = m_end = 0;
+        m_next_size = m_initial_size;
+        m_used = 0;
+    }
+
+    //已分配给对象的字节数
+    size_t bytes_used() const
+    {
+        return m_used;
+    }
+
+    //从系统申请的字节数
+    size_t bytes_reserved() const
+    {
+        size_t total = 0;
+        for(block* b = m_head;b != 0;b = b->prev)
+            total += b->size;
+        return total;
+    }
+};
+
+
+///////////////////////////
+//内存区分配器，可以作为容器的Alloc参数
+//从当前线程最近的arena_scope所绑定的arena中分配，deallocate只回收最后一次分配。
+//容器必须在arena_scope结束之前析构。
+template<int inst>
+class arena_alloc_template
+{
+private:
+#ifdef STL_THREAD_LOCAL
+    static STL_THREAD_LOCAL arena* s_current;
+#else
+    static arena* s_current;
+#endif
+
+    template<int> friend class arena_scope_template;
+
+public:
+    static arena* current()
+    {
+        return s_current;
+    }
+
+    static void* allocate(size_t n)
+    {
+        //没有活动的arena_scope
+        if(s_current == 0)
+        {
+            THROW_BAD_ALLOC;
+        }
+
+        return s_current->allocate(n);
+    }
+
+    static void deallocate(void* p,size_t n)
+    {
+        if(s_current != 0)
+            s_current->deallocate(p,n);
+    }
+};
+
+template<int inst>
+#ifdef STL_THREAD_LOCAL
+STL_THREAD_LOCAL
+#endif
+arena* arena_alloc_template<inst>::s_current = 0;
+
+
+///////////////////////////
+//作用域：构造时把arena设为当前线程的分配源，析构时reset()并恢复之前的arena。
+//作用域可以嵌套，嵌套的作用域应使用不同的arena。
+template<int inst>
+class arena_scope_template
+{
+private:
+    arena& m_arena;
+    arena* m_prev;
+
+    arena_scope_template(const arena_scope_template&);
+    arena_scope_template& operator=(const arena_scope_template&);
+
+public:
+    explicit arena_scope_template(arena& a)
+        : m_arena(a),m_prev(arena_alloc_template<inst>::s_current)
+    {
+        arena_alloc_template<inst>::s_current = &a;
+    }
+
+    ~arena_scope_template()
+    {
+        arena_alloc_template<inst>::s_current = m_prev;
+        m_arena.reset();
+    }
+};
+
+typedef arena_alloc_template<0> arena_alloc;
+typedef arena_scope_template<0> arena_scope;
+
+STL_END_NAMESPACE
+
+#endif // ARENA_ALLOC_IMP_H
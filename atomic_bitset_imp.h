@@ -0,0 +1,249 @@
+//atomic_bitset_imp.h
+//多线程共享的bitset：每个word为std::atomic<unsigned long>，
+//置位、清除、翻转使用fetch_or/fetch_and/fetch_xor，多个线程同时修改同一个word不会丢失bit。
+//每个操作可以指定内存序，例如只需要去重的访问标记使用memory_order_relaxed。
+//count、find_first等读取多个word的操作不是原子快照
+
+#ifndef ATOMIC_BITSET_IMP_H
+#define ATOMIC_BITSET_IMP_H
+
+#include "configure.h"
+#include "bitset_imp.h"
+
+#ifndef STL_CXX11
+#   error "atomic_bitset_imp.h requires C++11 atomic"
+#endif
+
+#include <atomic>
+
+STL_BEGIN_NAMESPACE
+
+template<size_t Nb>
+class atomic_bitset
+{
+private:
+    enum {Nw = BITSET_WORDS(Nb)};
+    typedef Base_bitset<Nw> Base;
+    typedef unsigned long WordT;
+
+public:
+    atomic_bitset()
+    {
+        for(size_t i = 0;i < Nw;i++)
+            m_words[i].store(0,std::memory_order_relaxed);
+    }
+
+    size_t size() const
+    {
+        return Nb;
+    }
+
+public: //单个bit
+    bool test(size_t pos,std::memory_order order = std::memory_order_seq_cst) const
+    {
+        check_pos(pos);
+        return (word(pos).load(order) & Base::maskbit(pos)) != 0;
+    }
+
+    //置1，返回原来的值
+    bool test_and_set(size_t pos,std::memory_order order = std::memory_order_seq_cst)
+    {
+        check_pos(pos);
+        return (word(pos).fetch_or(Base::maskbit(pos),order) & Base::maskbit(pos)) != 0;
+    }
+
+    //置0，返回原来的值
+    bool test_and_reset(size_t pos,std::memory_order order = std::memory_order_seq_cst)
+    {
+        check_pos(pos);
+        return (word(pos).fetch_and(~Base::maskbit(pos),order) & Base::maskbit(pos)) != 0;
+    }
+
+    //翻转，返回原来的值
+    bool test_and_flip(size_t pos,std::memory_order order = std::memory_order_seq_cst)
+    {
+        check_pos(pos);
+        return (word(pos).fetch_xor(Base::maskbit(pos),order) & Base::maskbit(pos)) != 0;
+    }
+
+    atomic_bitset& set(size_t pos,std::memory_order order = std::memory_order_seq_cst)
+    {
+        test_and_set(pos,order);
+        return *this;
+    }
+
+    atomic_bitset& reset(size_t pos,std::memory_order order = std::memory_order_seq_cst)
+    {
+        test_and_reset(pos,order);
+        return *this;
+    }
+
+    atomic_bitset& flip(size_t pos,std::memory_order order = std::memory_order_seq_cst)
+    {
+        test_and_flip(pos,order);
+        return *this;
+    }
+
+    bool operator[](size_t pos) const
+    {
+        return (word(pos).load(std::memory_order_relaxed) & Base::maskbit(pos)) != 0;
+    }
+
+public: //整个word，i为word的下标，超出Nb的bit不能置1
+    size_t num_words() const
+    {
+        return Nw;
+    }
+
+    WordT load_word(size_t i,std::memory_order order = std::memory_order_seq_cst) const
+    {
+        return m_words[i].load(order);
+    }
+
+    void store_word(size_t i,WordT x,std::memory_order order = std::memory_order_seq_cst)
+    {
+        m_words[i].store(x,order);
+    }
+
+    //返回原来的word
+    WordT fetch_or_word(size_t i,WordT mask,std::memory_order order = std::memory_order_seq_cst)
+    {
+        return m_words[i].fetch_or(mask,order);
+    }
+
+    WordT fetch_and_word(size_t i,WordT mask,std::memory_order order = std::memory_order_seq_cst)
+    {
+        return m_words[i].fetch_and(mask,order);
+    }
+
+    WordT fetch_xor_word(size_t i,WordT mask,std::memory_order order = std::memory_order_seq_cst)
+    {
+        return m_words[i].fetch_xor(mask,order);
+    }
+
+public: //全部bit
+    void reset(std::memory_order order = std::memory_order_seq_cst)
+    {
+        for(size_t i = 0;i < Nw;i++)
+            m_words[i].store(0,order);
+    }
+
+    size_t count(std::memory_order order = std::memory_order_relaxed) const
+    {
+        size_t n = 0;
+        for(size_t i = 0;i < Nw;i++)
+            n += __popcount_word(m_words[i].load(order));
+        return n;
+    }
+
+    bool any(std::memory_order order = std::memory_order_relaxed) const
+    {
+        for(size_t i = 0;i < Nw;i++)
+            if(m_words[i].load(order) != 0)
+                return true;
+        return false;
+    }
+
+    bool none(std::memory_order order = std::memory_order_relaxed) const
+    {
+        return !any(order);
+    }
+
+    //复制到普通的bitset
+    bitset<Nb> to_bitset(std::memory_order order = std::memory_order_acquire) const
+    {
+        bitset<Nb> result;
+        for(size_t i = 0;i < Nw;i++)
+        {
+            for(WordT w = m_words[i].load(order);w != 0;w &= w - 1)
+                result.unchecked_set(i * BITS_PER_WORD + __ctz_word(w));
+        }
+        return result;
+    }
+
+public: //查找，没有找到返回Nb
+    size_t find_first(std::memory_order order = std::memory_order_relaxed) const
+    {
+        for(size_t i = 0;i < Nw;i++)
+        {
+            const WordT w = m_words[i].load(order);
+            if(w != 0)
+                return i * BITS_PER_WORD + __ctz_word(w);
+        }
+        return Nb;
+    }
+
+    size_t find_first_zero(std::memory_order order = std::memory_order_relaxed) const
+    {
+        for(size_t i = 0;i < Nw;i++)
+        {
+            const WordT free = ~m_words[i].load(order) & valid_mask(i);
+            if(free != 0)
+                return i * BITS_PER_WORD + __ctz_word(free);
+        }
+        return Nb;
+    }
+
+    //找到一个为0的bit并置1，返回它的位置，全部为1时返回Nb。
+    //从hint所在的word开始循环查找，多个线程使用不同的hint可以减少在同一个word上的竞争。
+    //对word使用compare_exchange，不加锁；每个位置只会被一个线程得到
+    size_t find_first_zero_and_set(size_t hint = 0,
+                                   std::memory_order order = std::memory_order_acq_rel)
+    {
+        const size_t start = hint < Nb ? Base::whichword(hint) : 0;
+        for(size_t n = 0;n < Nw;n++)
+        {
+            const size_t i = (start + n) % Nw;
+            WordT w = m_words[i].load(std::memory_order_relaxed);
+            for(;;)
+            {
+                const WordT free = ~w & valid_mask(i);
+                if(free == 0)
+                    break;
+                const WordT bit = free & (~free + 1);
+                //失败时w更新为当前的值，重新选择
+                if(m_words[i].compare_exchange_weak(w,w | bit,order,std::memory_order_relaxed))
+                    return i * BITS_PER_WORD + __ctz_word(bit);
+            }
+        }
+        return Nb;
+    }
+
+private:
+    atomic_bitset(const atomic_bitset&);
+    atomic_bitset& operator=(const atomic_bitset&);
+
+    std::atomic<WordT>& word(size_t pos)
+    {
+        return m_words[Base::whichword(pos)];
+    }
+
+    const std::atomic<WordT>& word(size_t pos) const
+    {
+        return m_words[Base::whichword(pos)];
+    }
+
+    //第i个word中属于bitset的bit
+    static WordT valid_mask(size_t i)
+    {
+        const size_t extra = Nb % BITS_PER_WORD;
+        if(Nb == 0)
+            return 0;
+        if(i + 1 < Nw || extra == 0)
+            return ~static_cast<WordT>(0);
+        return ~(~static_cast<WordT>(0) << extra);
+    }
+
+    void check_pos(size_t pos) const
+    {
+        if(pos >= Nb)
+            STL_THROW(out_of_range("atomic_bitset"));
+    }
+
+private:
+    std::atomic<WordT> m_words[Nw];
+};
+
+STL_END_NAMESPACE
+
+#endif // ATOMIC_BITSET_IMP_H
@@ -0,0 +1,61 @@
+//bench_alloc.cpp
+//比较malloc_alloc和default_alloc在小对象频繁创建销毁时的开销
+//编译：g++ -O2 -I.. bench_alloc.cpp -o bench_alloc
+
+#include "../string_imp.h"
+#include "../vector_imp.h"
+#include "bench_timer.h"
+
+using namespace mini_stl;
+
+const int kRounds = 2000;
+const int kLive = 1000;
+
+//每轮创建kLive个短字符串然后全部销毁
+template<class Alloc>
+void bench_string_churn(const char* name)
+{
+    typedef basic_string<char,Alloc> string_type;
+    typedef simple_alloc<string_type,Alloc> node_alloc;
+
+    string_type* strs = node_alloc::allocate(kLive);
+    double begin = bench_now();
+    for(int r = 0;r < kRounds;r++)
+    {
+        for(int i = 0;i < kLive;i++)
+            construct(strs + i,"request-key");
+        for(int i = 0;i < kLive;i++)
+            strs[i].append("-suffix");
+        bench_keep(strs[r % kLive]);
+        for(int i = 0;i < kLive;i++)
+            destroy(strs + i);
+    }
+    bench_report(name,bench_now() - begin,(double)kRounds * kLive);
+    node_alloc::deallocate(strs,kLive);
+}
+
+//小vector的创建、增长和销毁
+template<class Alloc>
+void bench_vector_churn(const char* name)
+{
+    double begin = bench_now();
+    for(int r = 0;r < kRounds * kLive / 10;r++)
+    {
+        vector<int,Alloc> vect;
+        for(int i = 0;i < 10;i++)
+            vect.push_back(i);
+        bench_keep(vect[r % 10]);
+    }
+    bench_report(name,bench_now() - begin,(double)kRounds * kLive / 10);
+}
+
+int main()
+{
+    bench_string_churn<malloc_alloc>("string churn / malloc_alloc");
+    bench_string_churn<default_alloc>("string churn / default_alloc");
+    bench_string_churn<default_alloc_template<false,0> >("string churn / default_alloc(no lock)");
+    bench_vector_churn<malloc_alloc>("vector<int> churn / malloc_alloc");
+    bench_vector_churn<default_alloc>("vector<int> churn / default_alloc");
+    bench_vector_churn<default_alloc_template<false,0> >("vector<int> churn / default_alloc(no lock)");
+    return 0;
+}
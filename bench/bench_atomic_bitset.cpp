@@ -0,0 +1,128 @@
+//bench_atomic_bitset.cpp
+//多线程共享的访问标记：atomic_bitset的test_and_set与bitset加锁对比，
+//以及find_first_zero_and_set从hint开始分配id（加锁版本每次从头扫描word），线程数从1开始翻倍
+//编译：g++ -std=c++11 -O2 -pthread -I.. bench_atomic_bitset.cpp -o bench_atomic_bitset
+
+#include "../atomic_bitset_imp.h"
+#include "bench_timer.h"
+#include <thread>
+#include <mutex>
+#include <vector>
+
+using namespace mini_stl;
+
+const size_t kBits = 1 << 20;
+const size_t kOps = 1 << 22;
+
+static atomic_bitset<kBits> shared;
+static bitset<kBits> locked;
+static std::mutex lock;
+
+static void mark_atomic(unsigned seed,size_t ops,size_t* wins)
+{
+    size_t n = 0;
+    for(size_t i = 0;i < ops;i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        n += !shared.test_and_set(seed % kBits,std::memory_order_relaxed);
+    }
+    *wins = n;
+}
+
+static void mark_locked(unsigned seed,size_t ops,size_t* wins)
+{
+    size_t n = 0;
+    for(size_t i = 0;i < ops;i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        std::lock_guard<std::mutex> guard(lock);
+        if(!locked.unchecked_test(seed % kBits))
+        {
+            locked.unchecked_set(seed % kBits);
+            ++n;
+        }
+    }
+    *wins = n;
+}
+
+static void alloc_atomic(size_t hint,size_t* got)
+{
+    size_t n = 0;
+    while(shared.find_first_zero_and_set(hint) != kBits)
+        ++n;
+    *got = n;
+}
+
+static void alloc_locked(size_t,size_t* got)
+{
+    size_t n = 0;
+    for(;;)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        const unsigned long* w = locked.data();
+        size_t i = 0;
+        while(i < locked.num_words() && ~w[i] == 0)
+            ++i;
+        if(i == locked.num_words())
+            break;
+        locked.unchecked_set(i * BITS_PER_WORD + __ctz_word(~w[i]));
+        ++n;
+    }
+    *got = n;
+}
+
+static void run(const char* name,void (*fn)(unsigned,size_t,size_t*),int nthreads)
+{
+    shared.reset();
+    locked.reset();
+    std::vector<std::thread> threads;
+    std::vector<size_t> wins(nthreads);
+    double begin = bench_now();
+    for(int t = 0;t < nthreads;t++)
+        threads.push_back(std::thread(fn,t + 1,kOps / nthreads,&wins[t]));
+    for(int t = 0;t < nthreads;t++)
+        threads[t].join();
+
+    char label[96];
+    snprintf(label,sizeof(label),"%s threads=%d",name,nthreads);
+    bench_report(label,bench_now() - begin,(double)kOps);
+}
+
+static void run_alloc(const char* name,void (*fn)(size_t,size_t*),int nthreads,size_t limit)
+{
+    shared.reset();
+    locked.reset();
+    //只分配最后limit个位置
+    for(size_t i = 0;i + limit < kBits;i++)
+    {
+        shared.set(i,std::memory_order_relaxed);
+        locked.unchecked_set(i);
+    }
+
+    std::vector<std::thread> threads;
+    std::vector<size_t> got(nthreads);
+    double begin = bench_now();
+    for(int t = 0;t < nthreads;t++)
+        threads.push_back(std::thread(fn,kBits - limit + t * (limit / nthreads),&got[t]));
+    for(int t = 0;t < nthreads;t++)
+        threads[t].join();
+
+    char label[96];
+    snprintf(label,sizeof(label),"%s threads=%d",name,nthreads);
+    bench_report(label,bench_now() - begin,(double)limit);
+}
+
+int main()
+{
+    for(int t = 1;t <= 8;t *= 2)
+    {
+        run("atomic test_and_set",mark_atomic,t);
+        run("mutex + bitset",mark_locked,t);
+    }
+    for(int t = 1;t <= 8;t *= 2)
+    {
+        run_alloc("atomic find_first_zero_and_set",alloc_atomic,t,1 << 14);
+        run_alloc("mutex + word scan",alloc_locked,t,1 << 14);
+    }
+    return 0;
+}
@@ -0,0 +1,69 @@
+//bench_bitset_count.cpp
+//bitset::count和find_first/find_next遍历，与std::bitset对比
+//编译：g++ -O2 -I.. bench_bitset_count.cpp -o bench_bitset_count
+
+#include "../bitset_imp.h"
+#include "bench_timer.h"
+#include <bitset>
+
+template<size_t Nb>
+void run()
+{
+    mini_stl::bitset<Nb> bits;
+    std::bitset<Nb> std_bits;
+    unsigned seed = 1;
+    for(size_t i = 0;i < Nb / 4;i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        bits.set((seed >> 8) % Nb);
+        std_bits.set((seed >> 8) % Nb);
+    }
+
+    const size_t rounds = 400000000 / Nb + 1;
+    char label[80];
+    size_t hits;
+    double begin;
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t r = 0;r < rounds;r++)
+    {
+        bench_keep(&bits);
+        hits += bits.count();
+    }
+    snprintf(label,sizeof(label),"mini_stl::bitset<%lu>::count",(unsigned long)Nb);
+    bench_report(label,bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t r = 0;r < rounds;r++)
+    {
+        bench_keep(&std_bits);
+        hits += std_bits.count();
+    }
+    snprintf(label,sizeof(label),"std::bitset<%lu>::count",(unsigned long)Nb);
+    bench_report(label,bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t r = 0;r < rounds / 16 + 1;r++)
+    {
+        bench_keep(&bits);
+        for(size_t i = bits.find_first();i < Nb;i = bits.find_next(i))
+            hits += i;
+    }
+    snprintf(label,sizeof(label),"mini_stl::bitset<%lu> find_next loop",(unsigned long)Nb);
+    bench_report(label,bench_now() - begin,(double)(rounds / 16 + 1));
+    bench_keep(hits);
+}
+
+int main()
+{
+    run<64>();
+    run<512>();
+    run<4096>();
+    run<65536>();
+    return 0;
+}
@@ -0,0 +1,93 @@
+//bench_bitset_fused.cpp
+//两个bitset的Jaccard相似度：count_and/count_or与(a & b).count()/(a | b).count()对比，
+//以及intersects的提前返回，std::bitset作为参照
+//编译：g++ -O2 -I.. bench_bitset_fused.cpp -o bench_bitset_fused
+
+#include "../bitset_imp.h"
+#include "bench_timer.h"
+#include <bitset>
+
+template<size_t Nb>
+void run()
+{
+    mini_stl::bitset<Nb> a,b;
+    std::bitset<Nb> sa,sb;
+    unsigned seed = 1;
+    for(size_t i = 0;i < Nb / 4;i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        a.set((seed >> 8) % Nb);
+        sa.set((seed >> 8) % Nb);
+        seed = seed * 1103515245 + 12345;
+        b.set((seed >> 8) % Nb);
+        sb.set((seed >> 8) % Nb);
+    }
+
+    const size_t rounds = 400000000 / Nb + 1;
+    char label[80];
+    size_t hits;
+    double begin;
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t r = 0;r < rounds;r++)
+    {
+        bench_keep(&a);
+        hits += a.count_and(b) * 1000 / (a.count_or(b) + 1);
+    }
+    snprintf(label,sizeof(label),"jaccard count_and/count_or <%lu>",(unsigned long)Nb);
+    bench_report(label,bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t r = 0;r < rounds;r++)
+    {
+        bench_keep(&a);
+        hits += (a & b).count() * 1000 / ((a | b).count() + 1);
+    }
+    snprintf(label,sizeof(label),"jaccard temporaries <%lu>",(unsigned long)Nb);
+    bench_report(label,bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t r = 0;r < rounds;r++)
+    {
+        bench_keep(&sa);
+        hits += (sa & sb).count() * 1000 / ((sa | sb).count() + 1);
+    }
+    snprintf(label,sizeof(label),"jaccard std::bitset <%lu>",(unsigned long)Nb);
+    bench_report(label,bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t r = 0;r < rounds;r++)
+    {
+        bench_keep(&a);
+        hits += a.intersects(b);
+    }
+    snprintf(label,sizeof(label),"intersects <%lu>",(unsigned long)Nb);
+    bench_report(label,bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t r = 0;r < rounds;r++)
+    {
+        bench_keep(&a);
+        hits += (a & b).any();
+    }
+    snprintf(label,sizeof(label),"(a & b).any() <%lu>",(unsigned long)Nb);
+    bench_report(label,bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+}
+
+int main()
+{
+    run<256>();
+    run<4096>();
+    run<65536>();
+    return 0;
+}
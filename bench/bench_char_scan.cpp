@@ -0,0 +1,112 @@
+//bench_char_scan.cpp
+//单字符扫描：按行切分、统计分隔符、按两个分隔符切分，与std::string对比
+//文本为4MB的模拟日志，行长为随机的20到200字节，行内用','分隔字段
+//编译：g++ -O2 -I.. bench_char_scan.cpp -o bench_char_scan
+
+#include "../string_imp.h"
+#include "bench_timer.h"
+#include <string>
+#include <algorithm>
+
+static mini_stl::string make_log(size_t n)
+{
+    mini_stl::string s;
+    s.reserve(n);
+    unsigned seed = 1;
+    size_t line_left = 0;
+    while(s.size() < n)
+    {
+        seed = seed * 1103515245 + 12345;
+        if(line_left == 0)
+        {
+            s.push_back('\n');
+            line_left = 20 + (seed >> 16) % 180;
+        }
+        else
+        {
+            s.push_back((seed >> 16) % 24 == 0 ? ',' : char('a' + (seed >> 16) % 26));
+            --line_left;
+        }
+    }
+    return s;
+}
+
+int main()
+{
+    const mini_stl::string text = make_log(4 << 20);
+    const std::string std_text(text.c_str(),text.size());
+    const size_t rounds = 50;
+    size_t hits;
+    double begin;
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t r = 0;r < rounds;r++)
+        for(size_t pos = 0;(pos = text.find('\n',pos)) != mini_stl::string::npos;++pos)
+            ++hits;
+    bench_report("mini_stl::find('\\n') lines",bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t r = 0;r < rounds;r++)
+        for(size_t pos = 0;(pos = std_text.find('\n',pos)) != std::string::npos;++pos)
+            ++hits;
+    bench_report("std::string::find('\\n') lines",bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t r = 0;r < rounds;r++)
+        for(size_t pos = text.size();
+            pos != 0 && (pos = text.rfind('\n',pos - 1)) != mini_stl::string::npos;)
+            ++hits;
+    bench_report("mini_stl::rfind('\\n') lines",bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t r = 0;r < rounds;r++)
+        for(size_t pos = std_text.size();
+            pos != 0 && (pos = std_text.rfind('\n',pos - 1)) != std::string::npos;)
+            ++hits;
+    bench_report("std::string::rfind('\\n') lines",bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t r = 0;r < rounds;r++)
+    {
+        bench_keep(text.c_str());
+        hits += text.count(',');
+    }
+    bench_report("mini_stl::string::count(',')",bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t r = 0;r < rounds;r++)
+    {
+        bench_keep(std_text.c_str());
+        hits += std::count(std_text.begin(),std_text.end(),',');
+    }
+    bench_report("std::count(',')",bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t r = 0;r < rounds;r++)
+        for(size_t pos = 0;(pos = text.find_any_of2(',','\n',pos)) != mini_stl::string::npos;++pos)
+            ++hits;
+    bench_report("mini_stl::find_any_of2 fields",bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t r = 0;r < rounds;r++)
+        for(size_t pos = 0;(pos = std_text.find_first_of(",\n",pos)) != std::string::npos;++pos)
+            ++hits;
+    bench_report("std::string::find_first_of fields",bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+    return 0;
+}
@@ -0,0 +1,78 @@
+//bench_char_set.cpp
+//find_first_of/find_first_not_of/find_last_of：按分隔符集合切分文本，与std::string对比
+//集合分别为5个字符（pcmpestri）和41个字符（位图），char_set在循环外构造一次
+//编译：g++ -O2 -I.. bench_char_set.cpp -o bench_char_set
+
+#include "../string_imp.h"
+#include "bench_timer.h"
+#include <string>
+
+static mini_stl::string make_text(size_t n)
+{
+    mini_stl::string s;
+    s.reserve(n);
+    unsigned seed = 1;
+    while(s.size() < n)
+    {
+        seed = seed * 1103515245 + 12345;
+        const unsigned r = (seed >> 16) % 64;
+        s.push_back(r == 0 ? ';' : r == 1 ? ' ' : char('a' + r % 26));
+    }
+    return s;
+}
+
+static void run(const mini_stl::string& text,const char* delims)
+{
+    const std::string std_text(text.c_str(),text.size());
+    const mini_stl::char_set set(delims);
+    const size_t rounds = 20;
+    char label[96];
+    size_t hits;
+    double begin;
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t r = 0;r < rounds;r++)
+        for(size_t pos = 0;(pos = text.find_first_of(set,pos)) != mini_stl::string::npos;++pos)
+            ++hits;
+    snprintf(label,sizeof(label),"mini_stl::find_first_of set=%lu",(unsigned long)set.size());
+    bench_report(label,bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t r = 0;r < rounds;r++)
+        for(size_t pos = 0;(pos = std_text.find_first_of(delims,pos)) != std::string::npos;++pos)
+            ++hits;
+    snprintf(label,sizeof(label),"std::string::find_first_of set=%lu",(unsigned long)set.size());
+    bench_report(label,bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t r = 0;r < rounds;r++)
+        for(size_t pos = text.size();
+            pos != 0 && (pos = text.find_last_of(set,pos - 1)) != mini_stl::string::npos;)
+            ++hits;
+    snprintf(label,sizeof(label),"mini_stl::find_last_of set=%lu",(unsigned long)set.size());
+    bench_report(label,bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t r = 0;r < rounds;r++)
+        for(size_t pos = text.size();
+            pos != 0 && (pos = std_text.find_last_of(delims,pos - 1)) != std::string::npos;)
+            ++hits;
+    snprintf(label,sizeof(label),"std::string::find_last_of set=%lu",(unsigned long)set.size());
+    bench_report(label,bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+}
+
+int main()
+{
+    const mini_stl::string text = make_text(4 << 20);
+    run(text,"; \t\r\n");
+    run(text,"; \t\r\n0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ");
+    return 0;
+}
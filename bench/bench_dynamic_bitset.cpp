@@ -0,0 +1,134 @@
+//bench_dynamic_bitset.cpp
+//dynamic_bitset与std::vector<bool>对比：随机置位、随机测试、count、按位与、遍历置1的bit
+//编译：g++ -O2 -I.. bench_dynamic_bitset.cpp -o bench_dynamic_bitset
+
+#include "../dynamic_bitset_imp.h"
+#include "bench_timer.h"
+#include <vector>
+#include <algorithm>
+
+static void run(size_t n)
+{
+    mini_stl::dynamic_bitset<> a(n),b(n);
+    std::vector<bool> va(n),vb(n);
+    const size_t ops = 1 << 22;
+    char label[96];
+    size_t hits;
+    double begin;
+    unsigned seed;
+
+    seed = 1;
+    begin = bench_now();
+    for(size_t i = 0;i < ops;i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        a.unchecked_set(seed % n);
+        b.unchecked_set((seed >> 3) % n);
+    }
+    snprintf(label,sizeof(label),"dynamic_bitset set n=%lu",(unsigned long)n);
+    bench_report(label,bench_now() - begin,(double)ops);
+
+    seed = 1;
+    begin = bench_now();
+    for(size_t i = 0;i < ops;i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        va[seed % n] = true;
+        vb[(seed >> 3) % n] = true;
+    }
+    snprintf(label,sizeof(label),"vector<bool> set n=%lu",(unsigned long)n);
+    bench_report(label,bench_now() - begin,(double)ops);
+
+    hits = 0;
+    seed = 2;
+    begin = bench_now();
+    for(size_t i = 0;i < ops;i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        hits += a[seed % n];
+    }
+    snprintf(label,sizeof(label),"dynamic_bitset test n=%lu",(unsigned long)n);
+    bench_report(label,bench_now() - begin,(double)ops);
+    bench_keep(hits);
+
+    hits = 0;
+    seed = 2;
+    begin = bench_now();
+    for(size_t i = 0;i < ops;i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        hits += va[seed % n];
+    }
+    snprintf(label,sizeof(label),"vector<bool> test n=%lu",(unsigned long)n);
+    bench_report(label,bench_now() - begin,(double)ops);
+    bench_keep(hits);
+
+    const size_t rounds = 2000000000 / n + 1;
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t r = 0;r < rounds;r++)
+    {
+        bench_keep(&a);
+        hits += a.count();
+    }
+    snprintf(label,sizeof(label),"dynamic_bitset count n=%lu",(unsigned long)n);
+    bench_report(label,bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t r = 0;r < rounds / 16 + 1;r++)
+    {
+        bench_keep(&va);
+        hits += std::count(va.begin(),va.end(),true);
+    }
+    snprintf(label,sizeof(label),"vector<bool> count n=%lu",(unsigned long)n);
+    bench_report(label,bench_now() - begin,(double)(rounds / 16 + 1));
+    bench_keep(hits);
+
+    begin = bench_now();
+    for(size_t r = 0;r < rounds;r++)
+    {
+        bench_keep(&a);
+        a &= b;
+    }
+    snprintf(label,sizeof(label),"dynamic_bitset &= n=%lu",(unsigned long)n);
+    bench_report(label,bench_now() - begin,(double)rounds);
+
+    begin = bench_now();
+    for(size_t r = 0;r < rounds / 16 + 1;r++)
+    {
+        bench_keep(&va);
+        for(size_t i = 0;i < n;i++)
+            va[i] = va[i] && vb[i];
+    }
+    snprintf(label,sizeof(label),"vector<bool> &= n=%lu",(unsigned long)n);
+    bench_report(label,bench_now() - begin,(double)(rounds / 16 + 1));
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t r = 0;r < rounds / 16 + 1;r++)
+        for(size_t i = b.find_first();i != mini_stl::dynamic_bitset<>::npos;i = b.find_next(i))
+            hits += i;
+    snprintf(label,sizeof(label),"dynamic_bitset find_next n=%lu",(unsigned long)n);
+    bench_report(label,bench_now() - begin,(double)(rounds / 16 + 1));
+    bench_keep(hits);
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t r = 0;r < rounds / 16 + 1;r++)
+        for(size_t i = 0;i < n;i++)
+            if(vb[i])
+                hits += i;
+    snprintf(label,sizeof(label),"vector<bool> scan n=%lu",(unsigned long)n);
+    bench_report(label,bench_now() - begin,(double)(rounds / 16 + 1));
+    bench_keep(hits);
+}
+
+int main()
+{
+    run(1 << 16);
+    run(1 << 24);
+    return 0;
+}
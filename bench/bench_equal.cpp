@@ -0,0 +1,80 @@
+//bench_equal.cpp
+//equal和lexicographical_compare：与std::equal、std::lexicographical_compare对比
+//两个区间只有最后一个元素不同
+//编译：g++ -O2 -I.. bench_equal.cpp -o bench_equal
+
+#include "../vector_imp.h"
+#include "bench_timer.h"
+#include <algorithm>
+
+template<class Tp>
+void run(const char* type,size_t n)
+{
+    mini_stl::vector<Tp> x(n,Tp(7));
+    mini_stl::vector<Tp> y(n,Tp(7));
+    y[n - 1] = Tp(9);
+
+    const size_t rounds = 200000000 / (n * sizeof(Tp)) + 1;
+    const Tp* xb = x.begin();
+    const Tp* xe = x.end();
+    const Tp* yb = y.begin();
+    const Tp* ye = y.end();
+    char label[80];
+    size_t hits;
+    double begin;
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t i = 0;i < rounds;i++)
+    {
+        bench_keep(xb);
+        hits += mini_stl::equal(xb,xe,yb);
+    }
+    snprintf(label,sizeof(label),"mini_stl::equal %s n=%lu",type,(unsigned long)n);
+    bench_report(label,bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t i = 0;i < rounds;i++)
+    {
+        bench_keep(xb);
+        hits += std::equal(xb,xe,yb);
+    }
+    snprintf(label,sizeof(label),"std::equal %s n=%lu",type,(unsigned long)n);
+    bench_report(label,bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t i = 0;i < rounds;i++)
+    {
+        bench_keep(xb);
+        hits += mini_stl::lexicographical_compare(xb,xe,yb,ye);
+    }
+    snprintf(label,sizeof(label),"mini_stl::lex_compare %s n=%lu",type,(unsigned long)n);
+    bench_report(label,bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t i = 0;i < rounds;i++)
+    {
+        bench_keep(xb);
+        hits += std::lexicographical_compare(xb,xe,yb,ye);
+    }
+    snprintf(label,sizeof(label),"std::lex_compare %s n=%lu",type,(unsigned long)n);
+    bench_report(label,bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+}
+
+int main()
+{
+    const size_t sizes[] = {16,256,4096,65536};
+    for(size_t i = 0;i < sizeof(sizes) / sizeof(sizes[0]);i++)
+    {
+        run<unsigned char>("uchar",sizes[i]);
+        run<int>("int",sizes[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,60 @@
+//bench_fixed_capacity.cpp
+//热路径上的临时缓冲区：static_vector与vector，fixed_string与string
+//固定容量的容器从不申请内存
+//编译：g++ -O2 -I.. bench_fixed_capacity.cpp -o bench_fixed_capacity
+
+#include "../small_vector_imp.h"
+#include "../string_imp.h"
+#include "bench_timer.h"
+
+using namespace mini_stl;
+
+//每轮收集不超过16个下标，求和
+template<class Vector>
+void scratch_vector(const char* name,size_t rounds)
+{
+    long total = 0;
+    double begin = bench_now();
+    for(size_t r = 0;r < rounds;r++)
+    {
+        Vector picked;
+        for(int i = 0;i < 16;i++)
+            if((r >> (i & 7)) & 1)
+                picked.push_back(i);
+        for(typename Vector::const_iterator iter = picked.begin();iter != picked.end();++iter)
+            total += *iter;
+    }
+    const double elapsed = bench_now() - begin;
+    bench_keep(total);
+    bench_report(name,elapsed,(double)rounds);
+}
+
+//每轮拼接一个超过15个字符的键，再查找其中的分隔符
+template<class String>
+void scratch_string(const char* name,size_t rounds)
+{
+    size_t total = 0;
+    double begin = bench_now();
+    for(size_t r = 0;r < rounds;r++)
+    {
+        String key("tenant/");
+        key.append("region-");
+        key.push_back((char)('a' + r % 26));
+        key.append("/shard/");
+        key.append(r % 5 + 1,'0');
+        total += key.find('/',8) + key.size();
+    }
+    const double elapsed = bench_now() - begin;
+    bench_keep(total);
+    bench_report(name,elapsed,(double)rounds);
+}
+
+int main()
+{
+    const size_t rounds = 10000000;
+    scratch_vector<vector<int> >("vector<int>",rounds);
+    scratch_vector<static_vector<int,16> >("static_vector<int,16>",rounds);
+    scratch_string<string>("string",rounds);
+    scratch_string<fixed_string<64> >("fixed_string<64>",rounds);
+    return 0;
+}
@@ -0,0 +1,105 @@
+//bench_growth_policy.cpp
+//vector扩容策略对比：push_back的吞吐量、容量的浪费和峰值内存
+//1.many：10万个vector<int>，最终大小在1到300之间随机
+//2.big：一个大vector<int>增长到n个元素
+//每种情况在子进程中运行，分别统计峰值RSS
+//编译：g++ -O2 -I.. bench_growth_policy.cpp -o bench_growth_policy
+//运行：./bench_growth_policy [元素个数]
+
+#include "../vector_imp.h"
+#include "bench_timer.h"
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace mini_stl;
+
+static double peak_rss_mb()
+{
+    rusage usage;
+    getrusage(RUSAGE_SELF,&usage);
+    return usage.ru_maxrss / 1024.0;
+}
+
+template<class Growth>
+void many(const char* name)
+{
+    typedef vector<int,alloc,Growth> vector_type;
+    const size_t count = 100000;
+    vector_type* vects = new vector_type[count];
+
+    size_t elements = 0;
+    unsigned seed = 1;
+    double begin = bench_now();
+    for(size_t v = 0;v < count;v++)
+    {
+        seed = seed * 1103515245 + 12345;
+        const size_t n = 1 + (seed >> 8) % 300;
+        for(size_t i = 0;i < n;i++)
+            vects[v].push_back((int)i);
+        elements += n;
+    }
+    const double elapsed = bench_now() - begin;
+
+    size_t capacity = 0;
+    for(size_t v = 0;v < count;v++)
+        capacity += vects[v].capacity();
+
+    char label[96];
+    snprintf(label,sizeof(label),"many %s",name);
+    bench_report(label,elapsed,(double)elements);
+    printf("%-40s %9.1f%% unused capacity, %.1f MB peak RSS\n","",
+           100.0 * (capacity - elements) / capacity,peak_rss_mb());
+    bench_keep(vects);
+}
+
+template<class Growth>
+void big(const char* name,size_t n)
+{
+    double begin = bench_now();
+    vector<int,alloc,Growth> vect;
+    for(size_t i = 0;i < n;i++)
+        vect.push_back((int)i);
+    const double elapsed = bench_now() - begin;
+    bench_keep(vect[n / 2]);
+
+    char label[96];
+    snprintf(label,sizeof(label),"big %s",name);
+    bench_report(label,elapsed,(double)n);
+    printf("%-40s %9.1f%% unused capacity, %.1f MB peak RSS, data %.1f MB\n","",
+           100.0 * (vect.capacity() - n) / vect.capacity(),peak_rss_mb(),
+           n * sizeof(int) / 1048576.0);
+}
+
+template<class Growth>
+void run_in_child(const char* name,size_t n)
+{
+    fflush(stdout);
+    pid_t pid = fork();
+    if(pid == 0)
+    {
+        if(n == 0)
+            many<Growth>(name);
+        else
+            big<Growth>(name,n);
+        fflush(stdout);
+        _exit(0);
+    }
+    int status;
+    waitpid(pid,&status,0);
+}
+
+int main(int argc,char* argv[])
+{
+    size_t n = argc > 1 ? strtoul(argv[1],0,10) : (size_t)100000000;
+    for(int k = 0;k < 2;k++)
+    {
+        const size_t size = k == 0 ? 0 : n;
+        run_in_child<growth_double>("growth_double",size);
+        run_in_child<growth_golden>("growth_golden",size);
+        run_in_child<growth_fit<growth_double> >("growth_fit<growth_double>",size);
+        run_in_child<growth_fit<growth_golden> >("growth_fit<growth_golden>",size);
+    }
+    return 0;
+}
@@ -0,0 +1,75 @@
+//bench_rank_select.cpp
+//rank_select的随机rank1/select1/select0，与直接对前缀做popcount的rank对比，以及索引的额外空间
+//编译：g++ -O2 -I.. bench_rank_select.cpp -o bench_rank_select
+
+#include "../rank_select_imp.h"
+#include "bench_timer.h"
+
+static void run(size_t n,unsigned density)
+{
+    mini_stl::dynamic_bitset<> d(n);
+    unsigned seed = 1;
+    for(size_t i = 0;i < n;i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        if((seed >> 16) % 100 < density)
+            d.unchecked_set(i);
+    }
+
+    char label[96];
+    double begin = bench_now();
+    mini_stl::rank_select rs(d);
+    snprintf(label,sizeof(label),"build n=%lu density=%u%%",(unsigned long)n,density);
+    bench_report(label,bench_now() - begin,1.0);
+    printf("%-40s %10.2f%%\n","index overhead",100.0 * rs.memory_usage() / (n / 8));
+
+    const size_t ops = 1 << 22;
+    size_t hits = 0;
+
+    begin = bench_now();
+    for(size_t i = 0;i < ops;i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        hits += rs.rank1(seed % n);
+    }
+    bench_report("rank1",bench_now() - begin,(double)ops);
+    bench_keep(hits);
+
+    begin = bench_now();
+    for(size_t i = 0;i < ops;i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        hits += rs.select1(seed % rs.count());
+    }
+    bench_report("select1",bench_now() - begin,(double)ops);
+    bench_keep(hits);
+
+    begin = bench_now();
+    for(size_t i = 0;i < ops;i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        hits += rs.select0(seed % (n - rs.count()));
+    }
+    bench_report("select0",bench_now() - begin,(double)ops);
+    bench_keep(hits);
+
+    //没有索引时rank需要对前缀计数
+    const size_t slow_ops = ops / 1024;
+    begin = bench_now();
+    for(size_t i = 0;i < slow_ops;i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        const size_t pos = seed % n;
+        hits += mini_stl::__popcount_words(d.data(),pos / BITS_PER_WORD);
+    }
+    bench_report("prefix popcount rank",bench_now() - begin,(double)slow_ops);
+    bench_keep(hits);
+}
+
+int main()
+{
+    run(1 << 20,50);
+    run(1 << 28,50);
+    run(1 << 28,2);
+    return 0;
+}
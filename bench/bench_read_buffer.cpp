@@ -0,0 +1,75 @@
+//bench_read_buffer.cpp
+//I/O缓冲区：resize(n)先清零再被read()覆盖，resize_default_init和append_uninitialized省去清零
+//read()用memcpy模拟内核复制，每轮复用同一个缓冲区
+//编译：g++ -O2 -I.. bench_read_buffer.cpp -o bench_read_buffer
+//运行：./bench_read_buffer [MB]
+
+#include "../vector_imp.h"
+#include "../string_imp.h"
+#include "bench_timer.h"
+#include <stdlib.h>
+
+using namespace mini_stl;
+
+static char* g_source;
+
+//模拟从套接字读取n字节
+static void fake_read(char* dest,size_t n)
+{
+    memcpy(dest,g_source,n);
+}
+
+enum fill_mode {FILL_RESIZE,FILL_DEFAULT_INIT,FILL_APPEND};
+
+template<class Buffer>
+void run(const char* name,fill_mode mode,size_t bytes,int rounds)
+{
+    Buffer buf;
+    buf.reserve(bytes);
+    double begin = bench_now();
+    for(int r = 0;r < rounds;r++)
+    {
+        buf.clear();
+        if(mode == FILL_RESIZE)
+        {
+            buf.resize(bytes);
+            fake_read(&buf[0],bytes);
+        }
+        else if(mode == FILL_DEFAULT_INIT)
+        {
+            buf.resize_default_init(bytes);
+            fake_read(&buf[0],bytes);
+        }
+        else
+        {
+            //分4次读取
+            for(size_t i = 0;i < 4;i++)
+            {
+                fake_read(buf.append_uninitialized(bytes / 4),bytes / 4);
+                buf.commit(bytes / 4);
+            }
+        }
+        bench_keep(buf[bytes - 1]);
+    }
+    const double elapsed = bench_now() - begin;
+
+    printf("%-40s %10.3f ms/read %10.2f GB/s\n",name,elapsed * 1e3 / rounds,
+           bytes * (double)rounds / elapsed / 1e9);
+}
+
+int main(int argc,char* argv[])
+{
+    const size_t bytes = (argc > 1 ? strtoul(argv[1],0,10) : 64) << 20;
+    const int rounds = 50;
+    g_source = (char*)malloc(bytes);
+    memset(g_source,'x',bytes);
+
+    run<vector<char> >("vector<char> resize",FILL_RESIZE,bytes,rounds);
+    run<vector<char> >("vector<char> resize_default_init",FILL_DEFAULT_INIT,bytes,rounds);
+    run<vector<char> >("vector<char> append_uninitialized",FILL_APPEND,bytes,rounds);
+    run<string>("string resize",FILL_RESIZE,bytes,rounds);
+    run<string>("string resize_default_init",FILL_DEFAULT_INIT,bytes,rounds);
+    run<string>("string append_uninitialized",FILL_APPEND,bytes,rounds);
+    free(g_source);
+    return 0;
+}
@@ -0,0 +1,103 @@
+//bench_roaring.cpp
+//倒排索引的求交集：roaring_bitmap与有序std::vector<unsigned>的归并对比，
+//包括稀疏和稠密的文档ID集合，以及占用的字节数
+//编译：g++ -O2 -I.. bench_roaring.cpp -o bench_roaring
+
+#include "../roaring_imp.h"
+#include "bench_timer.h"
+#include <vector>
+#include <algorithm>
+#include <iterator>
+
+static void make_ids(std::vector<unsigned>& ids,size_t n,unsigned universe,unsigned seed)
+{
+    ids.clear();
+    ids.reserve(n);
+    for(size_t i = 0;i < n;i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        ids.push_back((unsigned)(((unsigned long long)seed * 2654435761u) % universe));
+    }
+    std::sort(ids.begin(),ids.end());
+    ids.erase(std::unique(ids.begin(),ids.end()),ids.end());
+}
+
+static void run(size_t na,size_t nb,unsigned universe)
+{
+    std::vector<unsigned> va,vb,out;
+    make_ids(va,na,universe,1);
+    make_ids(vb,nb,universe,2);
+
+    mini_stl::roaring_bitmap ra,rb;
+    for(size_t i = 0;i < va.size();i++)
+        ra.add(va[i]);
+    for(size_t i = 0;i < vb.size();i++)
+        rb.add(vb[i]);
+
+    char label[96];
+    const size_t rounds = 200000000 / (na + nb) + 1;
+    size_t hits = 0;
+    double begin;
+
+    begin = bench_now();
+    for(size_t r = 0;r < rounds;r++)
+    {
+        bench_keep(&ra);
+        hits += (ra & rb).cardinality();
+    }
+    snprintf(label,sizeof(label),"roaring and %lu/%lu in 2^%d",
+             (unsigned long)na,(unsigned long)nb,universe == 0xFFFFFFFFu ? 32 : 24);
+    bench_report(label,bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+
+    begin = bench_now();
+    for(size_t r = 0;r < rounds;r++)
+    {
+        bench_keep(&va);
+        out.clear();
+        std::set_intersection(va.begin(),va.end(),vb.begin(),vb.end(),std::back_inserter(out));
+        hits += out.size();
+    }
+    snprintf(label,sizeof(label),"sorted vector and %lu/%lu",(unsigned long)na,(unsigned long)nb);
+    bench_report(label,bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+
+    begin = bench_now();
+    for(size_t r = 0;r < rounds;r++)
+    {
+        bench_keep(&ra);
+        hits += (ra | rb).cardinality();
+    }
+    snprintf(label,sizeof(label),"roaring or %lu/%lu",(unsigned long)na,(unsigned long)nb);
+    bench_report(label,bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+
+    begin = bench_now();
+    for(size_t r = 0;r < rounds;r++)
+    {
+        bench_keep(&va);
+        out.clear();
+        std::set_union(va.begin(),va.end(),vb.begin(),vb.end(),std::back_inserter(out));
+        hits += out.size();
+    }
+    snprintf(label,sizeof(label),"sorted vector or %lu/%lu",(unsigned long)na,(unsigned long)nb);
+    bench_report(label,bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+
+    const size_t raw = va.size() * sizeof(unsigned);
+    const size_t before = ra.serialized_size();
+    ra.run_optimize();
+    printf("%-40s %10lu bytes (vector %lu, after run_optimize %lu)\n","roaring serialized",
+           (unsigned long)before,(unsigned long)raw,(unsigned long)ra.serialized_size());
+}
+
+int main()
+{
+    //2^32范围内的稀疏集合
+    run(2000000,2000000,0xFFFFFFFFu);
+    run(20000,2000000,0xFFFFFFFFu);
+    //2^24范围内的稠密集合
+    run(2000000,2000000,1u << 24);
+    run(8000000,4000000,1u << 24);
+    return 0;
+}
@@ -0,0 +1,92 @@
+//bench_small_vector.cpp
+//small_vector与vector：每条记录一个很短的数组，构造、填充、遍历再析构
+//元素个数不超过N时small_vector不申请内存；超过N时与vector相同
+//编译：g++ -O2 -I.. bench_small_vector.cpp -o bench_small_vector
+
+#include "../small_vector_imp.h"
+#include "bench_timer.h"
+
+using namespace mini_stl;
+
+static size_t g_allocations = 0;
+
+//统计申请次数的分配器
+struct counting_alloc
+{
+    static void* allocate(size_t n)
+    {
+        ++g_allocations;
+        return alloc::allocate(n);
+    }
+
+    static void deallocate(void* p,size_t n)
+    {
+        alloc::deallocate(p,n);
+    }
+};
+
+//每条记录max_size以内随机个元素
+template<class Vector>
+void records(const char* name,size_t rounds,size_t max_size)
+{
+    g_allocations = 0;
+    long total = 0;
+    unsigned seed = 1;
+    double begin = bench_now();
+    for(size_t r = 0;r < rounds;r++)
+    {
+        seed = seed * 1103515245 + 12345;
+        const int n = (int)((seed >> 8) % (max_size + 1));
+        Vector record;
+        for(int i = 0;i < n;i++)
+            record.push_back(i);
+        for(typename Vector::const_iterator iter = record.begin();iter != record.end();++iter)
+            total += *iter;
+    }
+    const double elapsed = bench_now() - begin;
+    bench_keep(total);
+
+    char label[96];
+    snprintf(label,sizeof(label),"%s, 0..%d",name,(int)max_size);
+    bench_report(label,elapsed,(double)rounds);
+    printf("%-40s %10.2f allocations/record\n","",(double)g_allocations / rounds);
+}
+
+//一批记录同时存在：vector<记录>整体构造和复制
+template<class Vector>
+void batch(const char* name,size_t count,size_t rounds)
+{
+    g_allocations = 0;
+    double begin = bench_now();
+    for(size_t r = 0;r < rounds;r++)
+    {
+        vector<Vector> table(count);
+        for(size_t i = 0;i < count;i++)
+            for(size_t k = 0;k < i % 8;k++)
+                table[i].push_back((int)k);
+        vector<Vector> copy(table);
+        bench_keep(copy[count - 1][0]);
+    }
+    const double elapsed = bench_now() - begin;
+
+    char label[96];
+    snprintf(label,sizeof(label),"batch %s",name);
+    bench_report(label,elapsed,(double)(count * rounds));
+    printf("%-40s %10.2f allocations/record\n","",(double)g_allocations / (count * rounds));
+}
+
+int main()
+{
+    typedef vector<int,counting_alloc> plain_vector;
+    typedef small_vector<int,8,counting_alloc> inline_vector;
+
+    const size_t rounds = 10000000;
+    records<plain_vector>("vector<int>",rounds,7);
+    records<inline_vector>("small_vector<int,8>",rounds,7);
+    records<plain_vector>("vector<int>",rounds,16);
+    records<inline_vector>("small_vector<int,8>",rounds,16);
+
+    batch<plain_vector>("vector<int>",1000,2000);
+    batch<inline_vector>("small_vector<int,8>",1000,2000);
+    return 0;
+}
@@ -0,0 +1,110 @@
+//bench_string_search.cpp
+//string::find/rfind：模式串长度 x 被查找串长度的矩阵，与朴素的search和std::string对比
+//文本由小字母表随机生成，模式串不出现在文本中，每次都要扫描整个文本；
+//最后一组是周期文本"aaa...a"中查找"aa...ab"，朴素查找为平方复杂度
+//编译：g++ -O2 -I.. bench_string_search.cpp -o bench_string_search
+
+#include "../string_imp.h"
+#include "bench_timer.h"
+#include <string>
+
+static void run(const char* kind,const mini_stl::string& hay,const mini_stl::string& pat)
+{
+    const std::string std_hay(hay.c_str(),hay.size());
+    const std::string std_pat(pat.c_str(),pat.size());
+    const size_t rounds = 200000000 / hay.size() + 1;
+    char label[96];
+    size_t hits;
+    double begin;
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t i = 0;i < rounds;i++)
+    {
+        bench_keep(hay.c_str());
+        hits += hay.find(pat);
+    }
+    snprintf(label,sizeof(label),"mini_stl::find %s h=%lu n=%lu",kind,
+             (unsigned long)hay.size(),(unsigned long)pat.size());
+    bench_report(label,bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t i = 0;i < rounds;i++)
+    {
+        bench_keep(hay.c_str());
+        hits += hay.rfind(pat);
+    }
+    snprintf(label,sizeof(label),"mini_stl::rfind %s h=%lu n=%lu",kind,
+             (unsigned long)hay.size(),(unsigned long)pat.size());
+    bench_report(label,bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+
+    //朴素查找是平方复杂度，周期文本只跑很少几轮
+    const size_t naive_rounds = kind[0] == 'p' ? 1 : rounds;
+    hits = 0;
+    begin = bench_now();
+    for(size_t i = 0;i < naive_rounds;i++)
+    {
+        bench_keep(hay.c_str());
+        hits += mini_stl::search(hay.begin(),hay.end(),pat.begin(),pat.end(),
+                                 mini_stl::char_eq) - hay.begin();
+    }
+    snprintf(label,sizeof(label),"mini_stl::search %s h=%lu n=%lu",kind,
+             (unsigned long)hay.size(),(unsigned long)pat.size());
+    bench_report(label,bench_now() - begin,(double)naive_rounds);
+    bench_keep(hits);
+
+    hits = 0;
+    begin = bench_now();
+    for(size_t i = 0;i < rounds;i++)
+    {
+        bench_keep(std_hay.c_str());
+        hits += std_hay.find(std_pat);
+    }
+    snprintf(label,sizeof(label),"std::string::find %s h=%lu n=%lu",kind,
+             (unsigned long)hay.size(),(unsigned long)pat.size());
+    bench_report(label,bench_now() - begin,(double)rounds);
+    bench_keep(hits);
+}
+
+static mini_stl::string random_text(size_t n,unsigned& seed)
+{
+    mini_stl::string s;
+    s.reserve(n);
+    for(size_t i = 0;i < n;i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        s.push_back(char('a' + (seed >> 16) % 16));
+    }
+    return s;
+}
+
+int main()
+{
+    const size_t hays[] = {4096,65536,4 << 20};
+    const size_t pats[] = {2,8,32,128,1024};
+    unsigned seed = 1;
+
+    for(size_t h = 0;h < sizeof(hays) / sizeof(hays[0]);h++)
+    {
+        const mini_stl::string hay = random_text(hays[h],seed);
+        for(size_t p = 0;p < sizeof(pats) / sizeof(pats[0]);p++)
+        {
+            //'z'不在字母表中，保证模式串不出现
+            mini_stl::string pat = random_text(pats[p] - 1,seed);
+            pat.push_back('z');
+            run("random",hay,pat);
+        }
+    }
+
+    for(size_t p = 0;p < sizeof(pats) / sizeof(pats[0]);p++)
+    {
+        const mini_stl::string hay(65536,'a');
+        mini_stl::string pat(pats[p] - 1,'a');
+        pat.push_back('b');
+        run("periodic",hay,pat);
+    }
+    return 0;
+}
@@ -0,0 +1,56 @@
+//bench_string_sso.cpp
+//短字符串优化：不超过15个字符的字符串构造、复制、追加都不申请内存
+//编译：g++ -O2 -I.. bench_string_sso.cpp -o bench_string_sso
+
+#include "../string_imp.h"
+#include "bench_timer.h"
+
+using namespace mini_stl;
+
+static size_t g_allocations = 0;
+
+//统计申请次数的分配器
+struct counting_alloc
+{
+    static void* allocate(size_t n)
+    {
+        ++g_allocations;
+        return alloc::allocate(n);
+    }
+
+    static void deallocate(void* p,size_t n)
+    {
+        alloc::deallocate(p,n);
+    }
+};
+
+typedef basic_string<char,counting_alloc> counted_string;
+
+//构造一个字符串，复制一次，再追加一个字符
+void run(const char* name,const char* text,size_t rounds)
+{
+    g_allocations = 0;
+    size_t total = 0;
+    double begin = bench_now();
+    for(size_t i = 0;i < rounds;i++)
+    {
+        counted_string key(text);
+        counted_string copy(key);
+        copy.push_back('x');
+        total += copy.size();
+        bench_keep(total);
+    }
+    double elapsed = bench_now() - begin;
+    bench_report(name,elapsed,(double)rounds);
+    printf("%-40s %10.2f allocations per op\n","",(double)g_allocations / rounds);
+}
+
+int main()
+{
+    const size_t rounds = 10000000;
+    run("empty string","",rounds);
+    run("8 chars","token_01",rounds);
+    run("14 chars (+1 fits inline)","short_key_0001",rounds);
+    run("32 chars (heap)","a key that lives on the heap 001",rounds);
+    return 0;
+}
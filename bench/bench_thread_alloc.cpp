@@ -0,0 +1,109 @@
+//bench_thread_alloc.cpp
+//多线程下小对象分配释放的吞吐量，线程数从1开始翻倍
+//1.local：每个线程分配并释放自己的对象
+//2.cross：每个线程释放相邻线程分配的对象
+//编译：g++ -std=c++11 -O2 -pthread -I.. bench_thread_alloc.cpp -o bench_thread_alloc
+
+#include "../thread_alloc_imp.h"
+#include "../vector_imp.h"
+#include "bench_timer.h"
+#include <thread>
+#include <vector>
+
+using namespace mini_stl;
+
+const int kObjects = 4096;
+const int kRounds = 200;
+
+static size_t object_size(int i)
+{
+    return 8 + (i * 7) % 120;
+}
+
+template<class Alloc>
+void local_churn()
+{
+    void* ptrs[kObjects];
+    for(int r = 0;r < kRounds;r++)
+    {
+        for(int i = 0;i < kObjects;i++)
+            ptrs[i] = Alloc::allocate(object_size(i));
+        for(int i = 0;i < kObjects;i++)
+            Alloc::deallocate(ptrs[i],object_size(i));
+    }
+}
+
+template<class Alloc>
+double run_local(int nthreads)
+{
+    std::vector<std::thread> threads;
+    double begin = bench_now();
+    for(int t = 0;t < nthreads;t++)
+        threads.push_back(std::thread(local_churn<Alloc>));
+    for(int t = 0;t < nthreads;t++)
+        threads[t].join();
+    return bench_now() - begin;
+}
+
+//两阶段：所有线程先分配，然后各自释放下一个线程的对象
+template<class Alloc>
+double run_cross(int nthreads)
+{
+    std::vector<std::vector<void*> > slots(nthreads,std::vector<void*>(kObjects));
+    double elapsed = 0;
+    for(int r = 0;r < kRounds / 10;r++)
+    {
+        std::vector<std::thread> threads;
+        double begin = bench_now();
+        for(int t = 0;t < nthreads;t++)
+        {
+            threads.push_back(std::thread([&slots,t]()
+            {
+                for(int i = 0;i < kObjects;i++)
+                    slots[t][i] = Alloc::allocate(object_size(i));
+            }));
+        }
+        for(int t = 0;t < nthreads;t++)
+            threads[t].join();
+        threads.clear();
+
+        for(int t = 0;t < nthreads;t++)
+        {
+            threads.push_back(std::thread([&slots,t,nthreads]()
+            {
+                std::vector<void*>& victim = slots[(t + 1) % nthreads];
+                for(int i = 0;i < kObjects;i++)
+                    Alloc::deallocate(victim[i],object_size(i));
+            }));
+        }
+        for(int t = 0;t < nthreads;t++)
+            threads[t].join();
+        elapsed += bench_now() - begin;
+    }
+    return elapsed;
+}
+
+template<class Alloc>
+void bench(const char* name)
+{
+    const int max_threads = (int)std::thread::hardware_concurrency();
+    char label[128];
+    for(int n = 1;n <= (max_threads > 1 ? max_threads : 1);n *= 2)
+    {
+        snprintf(label,sizeof(label),"%s local x%d",name,n);
+        bench_report(label,run_local<Alloc>(n),2.0 * kRounds * kObjects * n);
+    }
+    for(int n = 2;n <= (max_threads > 2 ? max_threads : 2);n *= 2)
+    {
+        snprintf(label,sizeof(label),"%s cross x%d",name,n);
+        bench_report(label,run_cross<Alloc>(n),2.0 * kRounds / 10 * kObjects * n);
+    }
+}
+
+int main()
+{
+    bench<malloc_alloc>("malloc_alloc");
+    bench<default_alloc>("default_alloc");
+    bench<thread_alloc>("thread_alloc");
+    return 0;
+}
@@ -0,0 +1,31 @@
+//bench_timer.h
+//基准测试使用的计时工具
+
+#ifndef BENCH_TIMER_H
+#define BENCH_TIMER_H
+
+#include <stdio.h>
+#include <time.h>
+
+//返回单调时钟的秒数
+inline double bench_now()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC,&ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+//阻止编译器把结果优化掉
+template<class Tp>
+inline void bench_keep(const Tp& value)
+{
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+//输出一行结果：名称，总时间，每次操作的纳秒数
+inline void bench_report(const char* name,double seconds,double ops)
+{
+    printf("%-40s %10.3f ms %10.2f ns/op\n",name,seconds * 1e3,seconds * 1e9 / ops);
+}
+
+#endif // BENCH_TIMER_H
@@ -0,0 +1,60 @@
+//bench_vector_middle.cpp
+//vector中间位置插入和删除：元素搬移由copy_backward/copy完成，
+//平凡类型使用memmove，非平凡类型逐个赋值
+//编译：g++ -O2 -I.. bench_vector_middle.cpp -o bench_vector_middle
+
+#include "../vector_imp.h"
+#include "bench_timer.h"
+
+using namespace mini_stl;
+
+//与int大小相同，但赋值操作不平凡，搬移时逐个赋值
+struct boxed_int
+{
+    int value;
+    boxed_int(int v = 0) : value(v) {}
+    boxed_int(const boxed_int& x) : value(x.value) {}
+    boxed_int& operator=(const boxed_int& x)
+    {
+        value = x.value;
+        return *this;
+    }
+};
+
+template<class Tp>
+void middle_insert_erase(const char* name,size_t n)
+{
+    vector<Tp> vect(n,Tp(1));
+    vect.reserve(n + 1);
+
+    //每次插入和删除搬移n/2个元素，总搬移量保持在2亿个元素左右
+    size_t rounds = 200000000 / n;
+    if(rounds < 10)
+        rounds = 10;
+    if(rounds > 200000)
+        rounds = 200000;
+
+    double begin = bench_now();
+    for(size_t i = 0;i < rounds;i++)
+    {
+        vect.insert(vect.begin() + n / 2,Tp((int)i));
+        vect.erase(vect.begin() + n / 2);
+    }
+    double elapsed = bench_now() - begin;
+    bench_keep(vect[n / 2]);
+
+    char label[64];
+    snprintf(label,sizeof(label),"%s n=%lu",name,(unsigned long)n);
+    bench_report(label,elapsed,(double)rounds * 2);
+}
+
+int main()
+{
+    const size_t sizes[] = {1000,10000,100000,1000000,10000000};
+    for(size_t i = 0;i < sizeof(sizes) / sizeof(sizes[0]);i++)
+    {
+        middle_insert_erase<int>("vector<int> insert+erase",sizes[i]);
+        middle_insert_erase<boxed_int>("vector<boxed_int> insert+erase",sizes[i]);
+    }
+    return 0;
+}
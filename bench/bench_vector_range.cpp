@@ -0,0 +1,148 @@
+//bench_vector_range.cpp
+//按迭代器区间构造和插入：与逐个push_back/insert比较时间和申请次数
+//前向迭代器（std::list、变换迭代器）一次分配；输入迭代器在末尾分摊扩容，最后旋转一次
+//编译：g++ -O2 -I.. bench_vector_range.cpp -o bench_vector_range
+
+#include "../vector_imp.h"
+#include "bench_timer.h"
+#include <list>
+
+using namespace mini_stl;
+
+static size_t g_allocations = 0;
+
+//统计申请次数的分配器
+struct counting_alloc
+{
+    static void* allocate(size_t n)
+    {
+        ++g_allocations;
+        return alloc::allocate(n);
+    }
+
+    static void deallocate(void* p,size_t n)
+    {
+        alloc::deallocate(p,n);
+    }
+};
+
+typedef vector<int,counting_alloc> int_vector;
+
+//前向迭代器：返回下标的平方
+struct square_iterator
+{
+    typedef forward_iterator_tag iterator_category;
+    typedef int value_type;
+    typedef ptrdiff_t difference_type;
+    typedef const int* pointer;
+    typedef int reference;
+
+    int index;
+
+    explicit square_iterator(int i) : index(i) {}
+    int operator*() const { return index * index; }
+    square_iterator& operator++() { ++index; return *this; }
+    bool operator!=(const square_iterator& x) const { return index != x.index; }
+    bool operator==(const square_iterator& x) const { return index == x.index; }
+};
+
+//输入迭代器：只能遍历一次
+struct input_counter
+{
+    typedef input_iterator_tag iterator_category;
+    typedef int value_type;
+    typedef ptrdiff_t difference_type;
+    typedef const int* pointer;
+    typedef const int& reference;
+
+    int value;
+
+    explicit input_counter(int v) : value(v) {}
+    const int& operator*() const { return value; }
+    input_counter& operator++() { ++value; return *this; }
+    bool operator!=(const input_counter& x) const { return value != x.value; }
+    bool operator==(const input_counter& x) const { return value == x.value; }
+};
+
+static void report(const char* name,double elapsed,size_t ops)
+{
+    bench_report(name,elapsed,(double)ops);
+    printf("%-40s %10lu allocations\n","",(unsigned long)g_allocations);
+}
+
+int main()
+{
+    const int n = 1 << 22;
+    const int rounds = 10;
+    std::list<int> lst;
+    for(int i = 0;i < n;i++)
+        lst.push_back(i);
+
+    double begin;
+
+    g_allocations = 0;
+    begin = bench_now();
+    for(int r = 0;r < rounds;r++)
+    {
+        int_vector vect;
+        for(std::list<int>::const_iterator iter = lst.begin();iter != lst.end();++iter)
+            vect.push_back(*iter);
+        bench_keep(vect[n - 1]);
+    }
+    report("list push_back loop",bench_now() - begin,(size_t)n * rounds);
+
+    g_allocations = 0;
+    begin = bench_now();
+    for(int r = 0;r < rounds;r++)
+    {
+        int_vector vect(lst.begin(),lst.end());
+        bench_keep(vect[n - 1]);
+    }
+    report("list range constructor",bench_now() - begin,(size_t)n * rounds);
+
+    g_allocations = 0;
+    begin = bench_now();
+    for(int r = 0;r < rounds;r++)
+    {
+        int_vector vect;
+        for(square_iterator iter(0);iter != square_iterator(n);++iter)
+            vect.push_back(*iter);
+        bench_keep(vect[n - 1]);
+    }
+    report("transform push_back loop",bench_now() - begin,(size_t)n * rounds);
+
+    g_allocations = 0;
+    begin = bench_now();
+    for(int r = 0;r < rounds;r++)
+    {
+        int_vector vect(square_iterator(0),square_iterator(n));
+        bench_keep(vect[n - 1]);
+    }
+    report("transform range constructor",bench_now() - begin,(size_t)n * rounds);
+
+    //输入区间插入到已有元素的前面：逐个insert每次都移动后面的元素
+    const int head = 1 << 16;
+    const int m = 1 << 12;
+    g_allocations = 0;
+    begin = bench_now();
+    for(int r = 0;r < rounds;r++)
+    {
+        int_vector vect(square_iterator(0),square_iterator(head));
+        int_vector::iterator pos = vect.begin() + 1;
+        for(input_counter iter(0);iter != input_counter(m);++iter)
+            pos = vect.insert(pos,*iter) + 1;
+        bench_keep(vect[m]);
+    }
+    report("input insert loop, front",bench_now() - begin,(size_t)m * rounds);
+
+    g_allocations = 0;
+    begin = bench_now();
+    for(int r = 0;r < rounds;r++)
+    {
+        int_vector vect(square_iterator(0),square_iterator(head));
+        vect.insert(vect.begin() + 1,input_counter(0),input_counter(m));
+        bench_keep(vect[m]);
+    }
+    report("input range insert, front",bench_now() - begin,(size_t)m * rounds);
+    return 0;
+}
@@ -0,0 +1,67 @@
+//bench_vector_realloc.cpp
+//大vector增长：realloc路径与分配-复制-释放路径的时间和峰值内存
+//每种情况在子进程中运行，分别统计峰值RSS
+//编译：g++ -O2 -I.. bench_vector_realloc.cpp -o bench_vector_realloc
+//运行：./bench_vector_realloc [元素个数]
+
+#include "../vector_imp.h"
+#include "bench_timer.h"
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace mini_stl;
+
+//与int大小相同，但复制构造函数不平凡，扩容时逐个复制
+struct boxed_int
+{
+    int value;
+    boxed_int(int v = 0) : value(v) {}
+    boxed_int(const boxed_int& x) : value(x.value) {}
+    boxed_int& operator=(const boxed_int& x)
+    {
+        value = x.value;
+        return *this;
+    }
+};
+
+template<class Tp>
+void grow(const char* name,size_t n)
+{
+    double begin = bench_now();
+    vector<Tp> vect;
+    for(size_t i = 0;i < n;i++)
+        vect.push_back(Tp((int)i));
+    double elapsed = bench_now() - begin;
+    bench_keep(vect[n / 2]);
+
+    rusage usage;
+    getrusage(RUSAGE_SELF,&usage);
+    bench_report(name,elapsed,(double)n);
+    printf("%-40s %10.1f MB peak RSS, data %.1f MB\n","",
+           usage.ru_maxrss / 1024.0,n * sizeof(Tp) / 1048576.0);
+}
+
+template<class Tp>
+void run_in_child(const char* name,size_t n)
+{
+    fflush(stdout);
+    pid_t pid = fork();
+    if(pid == 0)
+    {
+        grow<Tp>(name,n);
+        fflush(stdout);
+        _exit(0);
+    }
+    int status;
+    waitpid(pid,&status,0);
+}
+
+int main(int argc,char* argv[])
+{
+    size_t n = argc > 1 ? strtoul(argv[1],0,10) : (size_t)1 << 26;
+    run_in_child<int>("vector<int> push_back (realloc)",n);
+    run_in_child<boxed_int>("vector<boxed_int> push_back (copy)",n);
+    return 0;
+}
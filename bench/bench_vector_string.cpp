@@ -0,0 +1,65 @@
+//bench_vector_string.cpp
+//vector<string>增长：C++11中扩容搬移字符串、插入时移动字符串，不再复制字符
+//分别用C++98和C++11编译对比：
+//g++ -O2 -std=c++98 -I.. bench_vector_string.cpp -o bench_vector_string98
+//g++ -O2 -std=c++11 -I.. bench_vector_string.cpp -o bench_vector_string11
+//运行：./bench_vector_string11 [元素个数]
+
+#include "../vector_imp.h"
+#include "../string_imp.h"
+#include "bench_timer.h"
+#include <stdlib.h>
+
+using namespace mini_stl;
+
+//统计字符串申请的字节数，复制字符串时需要申请整个字符数组
+static size_t g_bytes = 0;
+
+struct counting_alloc
+{
+    static void* allocate(size_t n)
+    {
+        g_bytes += n;
+        return malloc_alloc::allocate(n);
+    }
+
+    static void deallocate(void* p,size_t n)
+    {
+        malloc_alloc::deallocate(p,n);
+    }
+};
+
+typedef basic_string<char,counting_alloc> counted_string;
+
+int main(int argc,char* argv[])
+{
+    const size_t n = argc > 1 ? strtoul(argv[1],0,10) : 1000000;
+    const counted_string payload("a string long enough to live on the heap, 64 bytes of payload..");
+
+    //push_back临时字符串
+    g_bytes = 0;
+    double begin = bench_now();
+    {
+        vector<counted_string> vect;
+        for(size_t i = 0;i < n;i++)
+            vect.push_back(counted_string(payload));
+        bench_keep(vect[n / 2].size());
+    }
+    bench_report("push_back(string temporary)",bench_now() - begin,(double)n);
+    printf("%-40s %10.1f string bytes allocated per element\n","",(double)g_bytes / n);
+
+    //在头部附近插入，每次插入都要搬移后面的元素
+    const size_t m = n / 100;
+    g_bytes = 0;
+    begin = bench_now();
+    {
+        vector<counted_string> vect;
+        for(size_t i = 0;i < m;i++)
+            vect.insert(vect.begin(),counted_string(payload));
+        bench_keep(vect[m / 2].size());
+    }
+    bench_report("insert(begin, string temporary)",bench_now() - begin,(double)m);
+    printf("%-40s %10.1f string bytes allocated per element\n","",(double)g_bytes / m);
+
+    return 0;
+}
@@ -0,0 +1,364 @@
+//bitops.h
+//单个word的位运算：popcount、ctz（最低位的1）、clz（最高位的1）、select（第k个1），
+//以及word数组的popcount和两个word数组按位运算后的popcount。
+//GCC/Clang使用内建函数，其他编译器使用移位实现；
+//x86上数组popcount在运行时检测CPU，依次选择AVX-512 VPOPCNTDQ、AVX2、POPCNT
+
+#ifndef BITOPS_H
+#define BITOPS_H
+
+#include "configure.h"
+#include <stddef.h>
+#include <limits.h>
+
+//x86上按CPU分派，需要target属性（GCC 5之后的immintrin.h可以在任何编译选项下使用）
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) \
+    && (defined(__clang__) || __GNUC__ >= 5)
+#   include <immintrin.h>
+#   define STL_X86_DISPATCH
+#   if defined(__clang__) || __GNUC__ >= 8
+#       define STL_AVX512_POPCNT
+#   endif
+#endif
+
+STL_BEGIN_NAMESPACE
+
+//////////////////////////////
+//CPU特性，只检测一次
+#ifdef STL_X86_DISPATCH
+inline bool __cpu_has_popcnt()
+{
+    static const bool has = (__builtin_cpu_init(),__builtin_cpu_supports("popcnt") != 0);
+    return has;
+}
+
+inline bool __cpu_has_sse42()
+{
+    static const bool has = (__builtin_cpu_init(),__builtin_cpu_supports("sse4.2") != 0);
+    return has;
+}
+
+inline bool __cpu_has_avx2()
+{
+    static const bool has = (__builtin_cpu_init(),__builtin_cpu_supports("avx2") != 0);
+    return has;
+}
+
+#ifdef STL_AVX512_POPCNT
+inline bool __cpu_has_avx512_popcnt()
+{
+    static const bool has = (__builtin_cpu_init(),
+                             __builtin_cpu_supports("avx512f") != 0
+                             && __builtin_cpu_supports("avx512vpopcntdq") != 0);
+    return has;
+}
+#endif
+#endif // STL_X86_DISPATCH
+
+
+//////////////////////////////
+//单个word
+inline size_t __popcount_word(unsigned long x)
+{
+#if defined(__GNUC__)
+    return __builtin_popcountl(x);
+#else
+    //每2位、4位、8位分别求和，最后用乘法把各字节加到最高字节
+    const unsigned long m1 = ~0UL / 3;
+    const unsigned long m2 = ~0UL / 5;
+    const unsigned long m4 = ~0UL / 17;
+    x = x - ((x >> 1) & m1);
+    x = (x & m2) + ((x >> 2) & m2);
+    x = (x + (x >> 4)) & m4;
+    return (size_t)((x * (~0UL / 255)) >> ((sizeof(unsigned long) - 1) * CHAR_BIT));
+#endif
+}
+
+//最低位的1的位置，x不能为0
+inline size_t __ctz_word(unsigned long x)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzl(x);
+#else
+    size_t n = 0;
+    while((x & 1UL) == 0)
+    {
+        x >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+//最高位的1之前0的个数，x不能为0
+inline size_t __clz_word(unsigned long x)
+{
+#if defined(__GNUC__)
+    return __builtin_clzl(x);
+#else
+    size_t n = 0;
+    const unsigned long top = 1UL << (sizeof(unsigned long) * CHAR_BIT - 1);
+    while((x & top) == 0)
+    {
+        x <<= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+//第k个（从0开始）为1的bit的位置，k必须小于x中1的个数
+inline size_t __select_word_generic(unsigned long x,size_t k)
+{
+    //先按字节跳过，再在字节内逐个去掉最低位的1
+    size_t base = 0;
+    for(;;base += CHAR_BIT,x >>= CHAR_BIT)
+    {
+        const size_t n = __popcount_word(x & 0xFFUL);
+        if(k < n)
+            break;
+        k -= n;
+    }
+    for(;k > 0;--k)
+        x &= x - 1;
+    return base + __ctz_word(x);
+}
+
+#if defined(STL_X86_DISPATCH) && defined(__x86_64__)
+inline bool __cpu_has_bmi2()
+{
+    static const bool has = (__builtin_cpu_init(),__builtin_cpu_supports("bmi2") != 0);
+    return has;
+}
+
+//pdep把第k个1放到第k位以外的位置全部清空
+__attribute__((target("bmi2")))
+inline size_t __select_word_bmi2(unsigned long x,size_t k)
+{
+    return __builtin_ctzll(_pdep_u64(1ULL << k,x));
+}
+#endif
+
+inline size_t __select_word(unsigned long x,size_t k)
+{
+#if defined(STL_X86_DISPATCH) && defined(__x86_64__)
+    if(__cpu_has_bmi2())
+        return __select_word_bmi2(x,k);
+#endif
+    return __select_word_generic(x,k);
+}
+
+
+//////////////////////////////
+//word数组的popcount
+inline size_t __popcount_words_generic(const unsigned long* w,size_t n)
+{
+    size_t result = 0;
+    for(size_t i = 0;i < n;i++)
+        result += __popcount_word(w[i]);
+    return result;
+}
+
+#ifdef STL_X86_DISPATCH
+__attribute__((target("popcnt")))
+inline size_t __popcount_words_popcnt(const unsigned long* w,size_t n)
+{
+    size_t result = 0;
+    for(size_t i = 0;i < n;i++)
+        result += __builtin_popcountl(w[i]);
+    return result;
+}
+
+//每个字节的高低4位分别用pshufb查16项的表，再用sad把字节加到64位
+__attribute__((target("avx2")))
+inline __m256i __popcount_m256(__m256i x)
+{
+    const __m256i table = _mm256_setr_epi8(0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4,
+                                           0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4);
+    const __m256i low4 = _mm256_set1_epi8(0x0f);
+    const __m256i lo = _mm256_shuffle_epi8(table,_mm256_and_si256(x,low4));
+    const __m256i hi = _mm256_shuffle_epi8(table,_mm256_and_si256(_mm256_srli_epi16(x,4),low4));
+    return _mm256_sad_epu8(_mm256_add_epi8(lo,hi),_mm256_setzero_si256());
+}
+
+//4个64位的和按64位相加，_mm_cvtsi128_si32只取低32位，超过2^31的和会出错；
+//_mm_cvtsi128_si64在32位x86上没有，所以存到内存里相加
+__attribute__((target("avx2")))
+inline size_t __reduce_add_m256(__m256i acc)
+{
+    unsigned long long lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes,acc);
+    return (size_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+}
+
+__attribute__((target("avx2,popcnt")))
+inline size_t __popcount_words_avx2(const unsigned long* w,size_t n)
+{
+    const unsigned char* p = (const unsigned char*)w;
+    size_t bytes = n * sizeof(unsigned long);
+
+    __m256i acc = _mm256_setzero_si256();
+    for(;bytes >= 32;bytes -= 32,p += 32)
+        acc = _mm256_add_epi64(acc,__popcount_m256(_mm256_loadu_si256((const __m256i*)p)));
+
+    const size_t result = __reduce_add_m256(acc);
+    return result + __popcount_words_popcnt((const unsigned long*)p,bytes / sizeof(unsigned long));
+}
+
+#ifdef STL_AVX512_POPCNT
+//循环结束后只做一次，存到内存里相加。GCC 12的_mm512_reduce_add_epi64和
+//_mm512_extracti64x4_epi64展开时都会报-Wuninitialized
+__attribute__((target("avx512f")))
+inline size_t __reduce_add_m512(__m512i acc)
+{
+    unsigned long long lanes[8];
+    _mm512_storeu_si512((void*)lanes,acc);
+    return (size_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3]
+                    + lanes[4] + lanes[5] + lanes[6] + lanes[7]);
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq,popcnt")))
+inline size_t __popcount_words_avx512(const unsigned long* w,size_t n)
+{
+    const unsigned char* p = (const unsigned char*)w;
+    size_t bytes = n * sizeof(unsigned long);
+
+    __m512i acc = _mm512_setzero_si512();
+    for(;bytes >= 64;bytes -= 64,p += 64)
+        acc = _mm512_add_epi64(acc,_mm512_popcnt_epi64(_mm512_loadu_si512((const void*)p)));
+
+    const size_t result = __reduce_add_m512(acc);
+    return result + __popcount_words_popcnt((const unsigned long*)p,bytes / sizeof(unsigned long));
+}
+#endif
+#endif // STL_X86_DISPATCH
+
+//少于一个向量的数组直接逐个计算
+inline size_t __popcount_words(const unsigned long* w,size_t n)
+{
+#ifdef STL_X86_DISPATCH
+#   ifdef STL_AVX512_POPCNT
+    if(n * sizeof(unsigned long) >= 64 && __cpu_has_avx512_popcnt())
+        return __popcount_words_avx512(w,n);
+#   endif
+    if(n * sizeof(unsigned long) >= 32 && __cpu_has_avx2())
+        return __popcount_words_avx2(w,n);
+    if(__cpu_has_popcnt())
+        return __popcount_words_popcnt(w,n);
+#endif
+    return __popcount_words_generic(w,n);
+}
+
+//////////////////////////////
+//两个word数组按位运算之后的popcount，不产生临时数组
+enum
+{
+    BITS_OP_AND,
+    BITS_OP_OR,
+    BITS_OP_XOR,
+    BITS_OP_ANDNOT      //a & ~b
+};
+
+template<int Op>
+inline unsigned long __bits_op_word(unsigned long a,unsigned long b)
+{
+    switch(Op)
+    {
+    case BITS_OP_AND: return a & b;
+    case BITS_OP_OR:  return a | b;
+    case BITS_OP_XOR: return a ^ b;
+    default:          return a & ~b;
+    }
+}
+
+template<int Op>
+inline size_t __popcount_words_op_generic(const unsigned long* a,const unsigned long* b,size_t n)
+{
+    size_t result = 0;
+    for(size_t i = 0;i < n;i++)
+        result += __popcount_word(__bits_op_word<Op>(a[i],b[i]));
+    return result;
+}
+
+#ifdef STL_X86_DISPATCH
+template<int Op>
+__attribute__((target("popcnt")))
+size_t __popcount_words_op_popcnt(const unsigned long* a,const unsigned long* b,size_t n)
+{
+    size_t result = 0;
+    for(size_t i = 0;i < n;i++)
+        result += __builtin_popcountl(__bits_op_word<Op>(a[i],b[i]));
+    return result;
+}
+
+template<int Op>
+__attribute__((target("avx2,popcnt")))
+size_t __popcount_words_op_avx2(const unsigned long* a,const unsigned long* b,size_t n)
+{
+    const size_t step = 32 / sizeof(unsigned long);
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for(;i + step <= n;i += step)
+    {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        const __m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+        __m256i z;
+        switch(Op)
+        {
+        case BITS_OP_AND: z = _mm256_and_si256(x,y); break;
+        case BITS_OP_OR:  z = _mm256_or_si256(x,y); break;
+        case BITS_OP_XOR: z = _mm256_xor_si256(x,y); break;
+        default:          z = _mm256_andnot_si256(y,x); break;
+        }
+        acc = _mm256_add_epi64(acc,__popcount_m256(z));
+    }
+    return __reduce_add_m256(acc) + __popcount_words_op_popcnt<Op>(a + i,b + i,n - i);
+}
+
+#ifdef STL_AVX512_POPCNT
+template<int Op>
+__attribute__((target("avx512f,avx512vpopcntdq,popcnt")))
+size_t __popcount_words_op_avx512(const unsigned long* a,const unsigned long* b,size_t n)
+{
+    const size_t step = 64 / sizeof(unsigned long);
+    __m512i acc = _mm512_setzero_si512();
+    size_t i = 0;
+    for(;i + step <= n;i += step)
+    {
+        const __m512i x = _mm512_loadu_si512((const void*)(a + i));
+        const __m512i y = _mm512_loadu_si512((const void*)(b + i));
+        __m512i z;
+        switch(Op)
+        {
+        case BITS_OP_AND: z = _mm512_and_si512(x,y); break;
+        case BITS_OP_OR:  z = _mm512_or_si512(x,y); break;
+        case BITS_OP_XOR: z = _mm512_xor_si512(x,y); break;
+        default:          z = _mm512_ternarylogic_epi64(x,y,y,0x30); break; //x & ~y
+        }
+        acc = _mm512_add_epi64(acc,_mm512_popcnt_epi64(z));
+    }
+    return __reduce_add_m512(acc) + __popcount_words_op_popcnt<Op>(a + i,b + i,n - i);
+}
+#endif
+#endif // STL_X86_DISPATCH
+
+//与__popcount_words相同的分派
+template<int Op>
+inline size_t __popcount_words_op(const unsigned long* a,const unsigned long* b,size_t n)
+{
+#ifdef STL_X86_DISPATCH
+#   ifdef STL_AVX512_POPCNT
+    if(n * sizeof(unsigned long) >= 64 && __cpu_has_avx512_popcnt())
+        return __popcount_words_op_avx512<Op>(a,b,n);
+#   endif
+    if(n * sizeof(unsigned long) >= 32 && __cpu_has_avx2())
+        return __popcount_words_op_avx2<Op>(a,b,n);
+    if(__cpu_has_popcnt())
+        return __popcount_words_op_popcnt<Op>(a,b,n);
+#endif
+    return __popcount_words_op_generic<Op>(a,b,n);
+}
+
+STL_END_NAMESPACE
+
+#endif // BITOPS_H
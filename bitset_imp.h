@@ -6,7 +6,10 @@
 
 #include "configure.h"
 #include "algobase.h"
+#include "bitops.h"
 #include <limits>
+#include <limits.h>
+#include <string.h>
 #include "string_imp.h"
 #include <stdexcept>
 
@@ -25,20 +28,233 @@ using std::invalid_argument;
 STL_BEGIN_NAMESPACE
 
 
+//////////////////////////////////////////////
+//word数组上的位运算，bitset和dynamic_bitset共用。
+//WordT为unsigned int或unsigned long（更窄的类型移位时会提升为int）；n为word的个数
+template<class WordT>
+inline void __bits_and(WordT* w,const WordT* x,size_t n)
+{
+    for(size_t i = 0;i < n;i++)
+        w[i] &= x[i];
+}
 
-//存储每个单字节数中bit为1的个数，例如2只有bit1为1，5有bit0和bit2为1
-template<bool dummy>
-struct Bit_count
+template<class WordT>
+inline void __bits_or(WordT* w,const WordT* x,size_t n)
 {
-    static unsigned char bit_count[256];
-};
+    for(size_t i = 0;i < n;i++)
+        w[i] |= x[i];
+}
 
-//存储每个单字节第1个bit为1的位置
-template<bool dummy>
-struct First_one
+template<class WordT>
+inline void __bits_xor(WordT* w,const WordT* x,size_t n)
 {
-    static unsigned char first_one[256];
-};
+    for(size_t i = 0;i < n;i++)
+        w[i] ^= x[i];
+}
+
+//w中去掉x中为1的bit
+template<class WordT>
+inline void __bits_andnot(WordT* w,const WordT* x,size_t n)
+{
+    for(size_t i = 0;i < n;i++)
+        w[i] &= ~x[i];
+}
+
+template<class WordT>
+inline void __bits_flip(WordT* w,size_t n)
+{
+    for(size_t i = 0;i < n;i++)
+        w[i] = ~w[i];
+}
+
+template<class WordT>
+inline bool __bits_is_equal(const WordT* w,const WordT* x,size_t n)
+{
+    for(size_t i = 0;i < n;i++)
+        if(w[i] != x[i])
+            return false;
+    return true;
+}
+
+template<class WordT>
+inline bool __bits_is_any(const WordT* w,size_t n)
+{
+    for(size_t i = 0;i < n;i++)
+        if(w[i] != static_cast<WordT>(0))
+            return true;
+    return false;
+}
+
+template<class WordT>
+inline size_t __bits_count(const WordT* w,size_t n)
+{
+    size_t result = 0;
+    for(size_t i = 0;i < n;i++)
+        result += __popcount_word(w[i]);
+    return result;
+}
+
+//unsigned long数组使用向量化的popcount
+inline size_t __bits_count(const unsigned long* w,size_t n)
+{
+    return __popcount_words(w,n);
+}
+
+//w和x按位运算（Op为BITS_OP_AND等）之后1的个数，不修改w和x
+template<int Op,class WordT>
+inline size_t __bits_count_op(const WordT* w,const WordT* x,size_t n)
+{
+    size_t result = 0;
+    for(size_t i = 0;i < n;i++)
+        result += __popcount_word(__bits_op_word<Op>(w[i],x[i]));
+    return result;
+}
+
+template<int Op>
+inline size_t __bits_count_op(const unsigned long* w,const unsigned long* x,size_t n)
+{
+    return __popcount_words_op<Op>(w,x,n);
+}
+
+//w和x有共同的1，每次检查4个word，找到后立即返回
+template<class WordT>
+inline bool __bits_intersects(const WordT* w,const WordT* x,size_t n)
+{
+    size_t i = 0;
+    for(;i + 4 <= n;i += 4)
+    {
+        if(((w[i] & x[i]) | (w[i + 1] & x[i + 1])
+            | (w[i + 2] & x[i + 2]) | (w[i + 3] & x[i + 3])) != static_cast<WordT>(0))
+            return true;
+    }
+    for(;i < n;i++)
+        if((w[i] & x[i]) != static_cast<WordT>(0))
+            return true;
+    return false;
+}
+
+//w中的1在x中都为1
+template<class WordT>
+inline bool __bits_is_subset(const WordT* w,const WordT* x,size_t n)
+{
+    size_t i = 0;
+    for(;i + 4 <= n;i += 4)
+    {
+        if(((w[i] & ~x[i]) | (w[i + 1] & ~x[i + 1])
+            | (w[i + 2] & ~x[i + 2]) | (w[i + 3] & ~x[i + 3])) != static_cast<WordT>(0))
+            return false;
+    }
+    for(;i < n;i++)
+        if((w[i] & ~x[i]) != static_cast<WordT>(0))
+            return false;
+    return true;
+}
+
+//向高位移动shift位，低位补0
+template<class WordT>
+void __bits_left_shift(WordT* w,size_t n,size_t shift)
+{
+    const size_t bits = sizeof(WordT) * CHAR_BIT;
+    //偏移的word
+    const size_t wshift = shift / bits;
+    //偏移的bit
+    const size_t offset = shift % bits;
+
+    if(shift == 0)
+        return;
+    if(wshift >= n)
+    {
+        fill(w,w + n,static_cast<WordT>(0));
+        return;
+    }
+
+    if(offset == 0)
+    {
+        for(size_t i = n - 1;i >= wshift;--i)
+            w[i] = w[i - wshift];
+    }
+    else
+    {
+        const size_t sub_offset = bits - offset;
+        for(size_t i = n - 1;i > wshift;--i)
+            w[i] = (w[i - wshift] << offset | w[i - wshift - 1] >> sub_offset);
+        w[wshift] = w[0] << offset;
+    }
+
+    fill(w,w + wshift,static_cast<WordT>(0));
+}
+
+//向低位移动shift位，高位补0
+template<class WordT>
+void __bits_right_shift(WordT* w,size_t n,size_t shift)
+{
+    const size_t bits = sizeof(WordT) * CHAR_BIT;
+    const size_t wshift = shift / bits;
+    const size_t offset = shift % bits;
+
+    if(shift == 0)
+        return;
+    if(wshift >= n)
+    {
+        fill(w,w + n,static_cast<WordT>(0));
+        return;
+    }
+
+    const size_t limit = n - wshift - 1;
+    if(offset == 0)
+    {
+        for(size_t i = 0;i <= limit;++i)
+            w[i] = w[i + wshift];
+    }
+    else
+    {
+        const size_t sub_offset = bits - offset;
+        for(size_t i = 0;i < limit;++i)
+            w[i] = (w[i + wshift] >> offset | w[i + wshift + 1] << sub_offset);
+        w[limit] = w[n - 1] >> offset;
+    }
+
+    fill(w + limit + 1,w + n,static_cast<WordT>(0));
+}
+
+//第一个为1的bit，没有时返回not_found
+template<class WordT>
+size_t __bits_find_first(const WordT* w,size_t n,size_t not_found)
+{
+    const size_t bits = sizeof(WordT) * CHAR_BIT;
+    for(size_t i = 0;i < n;i++)
+    {
+        if(w[i] != static_cast<WordT>(0))
+            return i * bits + __ctz_word(w[i]);
+    }
+    return not_found;
+}
+
+//prev之后第一个为1的bit
+template<class WordT>
+size_t __bits_find_next(const WordT* w,size_t n,size_t prev,size_t not_found)
+{
+    const size_t bits = sizeof(WordT) * CHAR_BIT;
+
+    //在非整word中搜索
+    ++prev;
+    if(prev >= n * bits)
+        return not_found;
+
+    size_t i = prev / bits;
+    //去掉prev之前的数据
+    const WordT thisword = w[i] >> (prev % bits);
+    if(thisword != static_cast<WordT>(0))
+        return prev + __ctz_word(thisword);
+
+    //在整word中搜索
+    for(++i;i < n;i++)
+    {
+        if(w[i] != static_cast<WordT>(0))
+            return i * bits + __ctz_word(w[i]);
+    }
+    return not_found;
+}
 
 //////////////////////////////////////////////
 //bitset基类
@@ -110,33 +326,35 @@ struct Base_bitset
     //逻辑操作
     void do_and(const Base_bitset<Nw>& x)
     {
-        for(size_t i = 0;i < Nw;i++)
-            w[i] &= x.w[i];
+        __bits_and(w,x.w,Nw);
     }
 
     void do_or(const Base_bitset<Nw>& x)
     {
-        for(size_t i = 0;i < Nw;i++)
-            w[i] |= x.w[i];
+        __bits_or(w,x.w,Nw);
     }
 
     void do_xor(const Base_bitset<Nw>& x)
     {
-        for(size_t i = 0;i < Nw;i++)
-            w[i] ^= x.w[i];
+        __bits_xor(w,x.w,Nw);
     }
 
     //向左偏移shift位
-    void do_left_shift(size_t shift);
+    void do_left_shift(size_t shift)
+    {
+        __bits_left_shift(w,Nw,shift);
+    }
 
     //向右偏移shift位
-    void do_right_shift(size_t shift);
+    void do_right_shift(size_t shift)
+    {
+        __bits_right_shift(w,Nw,shift);
+    }
 
     //全部取反
     void do_flip()
     {
-        for(size_t i = 0;i < Nw;i++)
-            w[i] = ~w[i];
+        __bits_flip(w,Nw);
     }
 
     //全部置1
@@ -155,177 +373,57 @@ struct Base_bitset
     //相等返回true
     bool is_equal(const Base_bitset<Nw>& x) const
     {
-        for(size_t i = 0;i < Nw;i++)
-            if(w[i] != x.w[i])
-                return false;
-        return true;
+        return __bits_is_equal(w,x.w,Nw);
     }
 
     //不为0返回true
     bool is_any() const
     {
-        for(size_t i = 0;i < Nw;i++)
-            if(w[i] != static_cast<WordT>(0))
-                return true;
-        return false;
+        return __bits_is_any(w,Nw);
     }
 
-    //获取bit为1的个数
+    //获取bit为1的个数，按word计算，多个word时使用向量指令
     size_t do_count() const
     {
-        size_t result = 0;
-        const unsigned char* byte_ptr = (const unsigned char*)w;
-        const unsigned char* end_ptr = (const unsigned char*)(w+Nw);
-
-        //通过查表计算一共有多少个1出现
-        while(byte_ptr < end_ptr)
-        {
-            result += Bit_count<true>::bit_count[*byte_ptr];
-            ++byte_ptr;
-        }
-
-        return result;
+        return __bits_count(w,Nw);
     }
 
-    unsigned long do_to_ulong() const;
-
-    //返回第个bit不为0的位置
-    size_t do_find_first(size_t not_found) const;
-
-    size_t do_find_next(size_t prev,size_t not_found) const;
-};
-
-template<size_t Nw>
-void Base_bitset<Nw>::do_left_shift(size_t shift)
-{
-    if(shift != 0)
+    //与x按位运算之后1的个数
+    template<int Op>
+    size_t do_count_op(const Base_bitset<Nw>& x) const
     {
-        //偏移的word
-        const size_t wshift = shift / BITS_PER_WORD;
-        //偏移的bit
-        const size_t offset = shift % BITS_PER_WORD;
-
-        if(offset == 0)
-        {
-            for(size_t n = Nw-1;n >= shift;--n)
-                w[n] = w[n-shift];
-        }
-        else
-        {
-            const size_t sub_offset = BITS_PER_WORD - offset;
-            for(size_t n = Nw-1;n > wshift;--n)
-                w[n] = (w[n-wshift] << offset | w[n-wshift-1] >> sub_offset);
-            w[wshift] = w[0] << offset;
-        }
-
-        fill(w+0,w+wshift,static_cast<WordT>(0));
-
+        return __bits_count_op<Op>(w,x.w,Nw);
     }
-}
 
-template<size_t Nw>
-void Base_bitset<Nw>::do_right_shift(size_t shift)
-{
-    if(shift != 0)
+    bool do_intersects(const Base_bitset<Nw>& x) const
     {
-        const size_t wshift = shift / BITS_PER_WORD;
-        const size_t offset = shift % BITS_PER_WORD;
-        const size_t limit = Nw - wshift - 1;
-
-        if(offset == 0)
-        {
-            for(size_t n = 0;n <= limit;++n)
-                w[n] = w[n+wshift];
-        }
-        else
-        {
-            const size_t sub_offset = BITS_PER_WORD - offset;
-
-            for(size_t n = 0;n < limit;++n)
-            {
-                w[n] = (w[n+wshift]>>offset | w[n+wshift+1] << sub_offset);
-            }
-            w[limit] = w[Nw-1] >> offset;
-        }
-
-        fill(w+limit+1,w+Nw,static_cast<WordT>(0));
+        return __bits_intersects(w,x.w,Nw);
     }
-}
-
-//返回word
-template<size_t Nw>
-unsigned long Base_bitset<Nw>::do_to_ulong() const
-{
-    return w[0];
-}
 
-template<size_t Nw>
-size_t Base_bitset<Nw>::do_find_first(size_t not_found) const
-{
-    for(size_t i = 0;i < Nw;i++)
+    bool do_is_subset_of(const Base_bitset<Nw>& x) const
     {
-        WordT thisword = w[i];
-        if(thisword != static_cast<WordT>(0))
-        {
-            for(size_t j = 0;j < sizeof(WordT);j++)
-            {
-                unsigned char this_byte = static_cast<unsigned char>(thisword & (~(unsigned char)0));
-                if(this_byte)
-                    return i * BITS_PER_WORD + j * CHAR_BIT + First_one<true>::first_one[this_byte];
-                thisword >>= CHAR_BIT;
-            }
-        }
+        return __bits_is_subset(w,x.w,Nw);
     }
 
-    return not_found;
-}
-
-template<size_t Nw>
-size_t Base_bitset<Nw>::do_find_next(size_t prev, size_t not_found) const
-{
-    //在非整word中搜索
-    ++prev;
-
-    if(prev >= Nw*BITS_PER_WORD)
-        return not_found;
-
-    size_t i = whichword(prev);
-    WordT thisword = w[i];
-
-    //prev之前的数据清零
-    thisword &= (~static_cast<WordT>(0)) << whichbit(prev);
+    unsigned long do_to_ulong() const;
 
-    if(thisword != static_cast<WordT>(0))
+    //返回第个bit不为0的位置
+    size_t do_find_first(size_t not_found) const
     {
-        thisword >>= whichbyte(prev) * CHAR_BIT;
-
-        for(size_t j = whichbyte(prev);j < sizeof(WordT);j++)
-        {
-            unsigned char this_byte = static_cast<unsigned char>(thisword & (~(unsigned char)0));
-            if(this_byte)
-                return i*BITS_PER_WORD+j*CHAR_BIT+First_one<true>::first_one[this_byte];
-            thisword >>= CHAR_BIT;
-        }
+        return __bits_find_first(w,Nw,not_found);
     }
 
-    //在整word中搜索
-    i++;
-    for(;i < Nw;i++)
+    size_t do_find_next(size_t prev,size_t not_found) const
     {
-        WordT thisword = w[i];
-        if(thisword != static_cast<WordT>(0))
-        {
-            for(size_t j = 0;j < sizeof(WordT);j++)
-            {
-                unsigned char this_byte = static_cast<unsigned char>(thisword & (~(unsigned char)0));
-                if(this_byte)
-                    return i*BITS_PER_WORD+j*CHAR_BIT+First_one<true>::first_one[this_byte];
-                thisword >>= CHAR_BIT;
-            }
-        }
+        return __bits_find_next(w,Nw,prev,not_found);
     }
+};
 
-    return not_found;
+//返回word
+template<size_t Nw>
+unsigned long Base_bitset<Nw>::do_to_ulong() const
+{
+    return w[0];
 }
 
 //这里使用类模板是为了能够控制Extrabits
@@ -476,6 +574,7 @@ public: //扩展功能
     bitset<Nb>& unchecked_set(size_t pos)
     {
         this->getword(pos) |= Base::maskbit(pos);
+        return *this;
     }
 
     bitset<Nb>& unchecked_set(size_t pos,int val)
@@ -591,6 +690,51 @@ public: //helper
         return Nb;
     }
 
+    //按位运算之后1的个数，不产生临时bitset，例如count_and(x)等于(*this & x).count()
+    size_t count_and(const bitset<Nb>& rhs) const
+    {
+        return this->template do_count_op<BITS_OP_AND>(rhs);
+    }
+
+    size_t count_or(const bitset<Nb>& rhs) const
+    {
+        return this->template do_count_op<BITS_OP_OR>(rhs);
+    }
+
+    size_t count_xor(const bitset<Nb>& rhs) const
+    {
+        return this->template do_count_op<BITS_OP_XOR>(rhs);
+    }
+
+    //(*this & ~rhs).count()
+    size_t count_andnot(const bitset<Nb>& rhs) const
+    {
+        return this->template do_count_op<BITS_OP_ANDNOT>(rhs);
+    }
+
+    //有共同的1
+    bool intersects(const bitset<Nb>& rhs) const
+    {
+        return this->do_intersects(rhs);
+    }
+
+    //为1的bit在rhs中都为1
+    bool is_subset_of(const bitset<Nb>& rhs) const
+    {
+        return this->do_is_subset_of(rhs);
+    }
+
+    //word数组，最低位的bit在第0个word，最高word中多余的bit为0
+    const WordT* data() const
+    {
+        return this->w;
+    }
+
+    size_t num_words() const
+    {
+        return BITSET_WORDS(Nb);
+    }
+
     bool operator==(const bitset<Nb>& rhs) const
     {
         return this->is_equal(rhs);
@@ -701,118 +845,6 @@ inline bitset<Nb> operator^(const bitset<Nb>& x,const bitset<Nb>& y)
     return result;
 }
 
-template<bool dummy>
-unsigned char Bit_count<dummy>::bit_count[] = {
-  0, /*   0 */ 1, /*   1 */ 1, /*   2 */ 2, /*   3 */ 1, /*   4 */
-  2, /*   5 */ 2, /*   6 */ 3, /*   7 */ 1, /*   8 */ 2, /*   9 */
-  2, /*  10 */ 3, /*  11 */ 2, /*  12 */ 3, /*  13 */ 3, /*  14 */
-  4, /*  15 */ 1, /*  16 */ 2, /*  17 */ 2, /*  18 */ 3, /*  19 */
-  2, /*  20 */ 3, /*  21 */ 3, /*  22 */ 4, /*  23 */ 2, /*  24 */
-  3, /*  25 */ 3, /*  26 */ 4, /*  27 */ 3, /*  28 */ 4, /*  29 */
-  4, /*  30 */ 5, /*  31 */ 1, /*  32 */ 2, /*  33 */ 2, /*  34 */
-  3, /*  35 */ 2, /*  36 */ 3, /*  37 */ 3, /*  38 */ 4, /*  39 */
-  2, /*  40 */ 3, /*  41 */ 3, /*  42 */ 4, /*  43 */ 3, /*  44 */
-  4, /*  45 */ 4, /*  46 */ 5, /*  47 */ 2, /*  48 */ 3, /*  49 */
-  3, /*  50 */ 4, /*  51 */ 3, /*  52 */ 4, /*  53 */ 4, /*  54 */
-  5, /*  55 */ 3, /*  56 */ 4, /*  57 */ 4, /*  58 */ 5, /*  59 */
-  4, /*  60 */ 5, /*  61 */ 5, /*  62 */ 6, /*  63 */ 1, /*  64 */
-  2, /*  65 */ 2, /*  66 */ 3, /*  67 */ 2, /*  68 */ 3, /*  69 */
-  3, /*  70 */ 4, /*  71 */ 2, /*  72 */ 3, /*  73 */ 3, /*  74 */
-  4, /*  75 */ 3, /*  76 */ 4, /*  77 */ 4, /*  78 */ 5, /*  79 */
-  2, /*  80 */ 3, /*  81 */ 3, /*  82 */ 4, /*  83 */ 3, /*  84 */
-  4, /*  85 */ 4, /*  86 */ 5, /*  87 */ 3, /*  88 */ 4, /*  89 */
-  4, /*  90 */ 5, /*  91 */ 4, /*  92 */ 5, /*  93 */ 5, /*  94 */
-  6, /*  95 */ 2, /*  96 */ 3, /*  97 */ 3, /*  98 */ 4, /*  99 */
-  3, /* 100 */ 4, /* 101 */ 4, /* 102 */ 5, /* 103 */ 3, /* 104 */
-  4, /* 105 */ 4, /* 106 */ 5, /* 107 */ 4, /* 108 */ 5, /* 109 */
-  5, /* 110 */ 6, /* 111 */ 3, /* 112 */ 4, /* 113 */ 4, /* 114 */
-  5, /* 115 */ 4, /* 116 */ 5, /* 117 */ 5, /* 118 */ 6, /* 119 */
-  4, /* 120 */ 5, /* 121 */ 5, /* 122 */ 6, /* 123 */ 5, /* 124 */
-  6, /* 125 */ 6, /* 126 */ 7, /* 127 */ 1, /* 128 */ 2, /* 129 */
-  2, /* 130 */ 3, /* 131 */ 2, /* 132 */ 3, /* 133 */ 3, /* 134 */
-  4, /* 135 */ 2, /* 136 */ 3, /* 137 */ 3, /* 138 */ 4, /* 139 */
-  3, /* 140 */ 4, /* 141 */ 4, /* 142 */ 5, /* 143 */ 2, /* 144 */
-  3, /* 145 */ 3, /* 146 */ 4, /* 147 */ 3, /* 148 */ 4, /* 149 */
-  4, /* 150 */ 5, /* 151 */ 3, /* 152 */ 4, /* 153 */ 4, /* 154 */
-  5, /* 155 */ 4, /* 156 */ 5, /* 157 */ 5, /* 158 */ 6, /* 159 */
-  2, /* 160 */ 3, /* 161 */ 3, /* 162 */ 4, /* 163 */ 3, /* 164 */
-  4, /* 165 */ 4, /* 166 */ 5, /* 167 */ 3, /* 168 */ 4, /* 169 */
-  4, /* 170 */ 5, /* 171 */ 4, /* 172 */ 5, /* 173 */ 5, /* 174 */
-  6, /* 175 */ 3, /* 176 */ 4, /* 177 */ 4, /* 178 */ 5, /* 179 */
-  4, /* 180 */ 5, /* 181 */ 5, /* 182 */ 6, /* 183 */ 4, /* 184 */
-  5, /* 185 */ 5, /* 186 */ 6, /* 187 */ 5, /* 188 */ 6, /* 189 */
-  6, /* 190 */ 7, /* 191 */ 2, /* 192 */ 3, /* 193 */ 3, /* 194 */
-  4, /* 195 */ 3, /* 196 */ 4, /* 197 */ 4, /* 198 */ 5, /* 199 */
-  3, /* 200 */ 4, /* 201 */ 4, /* 202 */ 5, /* 203 */ 4, /* 204 */
-  5, /* 205 */ 5, /* 206 */ 6, /* 207 */ 3, /* 208 */ 4, /* 209 */
-  4, /* 210 */ 5, /* 211 */ 4, /* 212 */ 5, /* 213 */ 5, /* 214 */
-  6, /* 215 */ 4, /* 216 */ 5, /* 217 */ 5, /* 218 */ 6, /* 219 */
-  5, /* 220 */ 6, /* 221 */ 6, /* 222 */ 7, /* 223 */ 3, /* 224 */
-  4, /* 225 */ 4, /* 226 */ 5, /* 227 */ 4, /* 228 */ 5, /* 229 */
-  5, /* 230 */ 6, /* 231 */ 4, /* 232 */ 5, /* 233 */ 5, /* 234 */
-  6, /* 235 */ 5, /* 236 */ 6, /* 237 */ 6, /* 238 */ 7, /* 239 */
-  4, /* 240 */ 5, /* 241 */ 5, /* 242 */ 6, /* 243 */ 5, /* 244 */
-  6, /* 245 */ 6, /* 246 */ 7, /* 247 */ 5, /* 248 */ 6, /* 249 */
-  6, /* 250 */ 7, /* 251 */ 6, /* 252 */ 7, /* 253 */ 7, /* 254 */
-  8  /* 255 */
-}; // end _Bit_count
-
-template<bool dummy>
-unsigned char First_one<dummy>::first_one[] = {
-  0, /*   0 */ 0, /*   1 */ 1, /*   2 */ 0, /*   3 */ 2, /*   4 */
-  0, /*   5 */ 1, /*   6 */ 0, /*   7 */ 3, /*   8 */ 0, /*   9 */
-  1, /*  10 */ 0, /*  11 */ 2, /*  12 */ 0, /*  13 */ 1, /*  14 */
-  0, /*  15 */ 4, /*  16 */ 0, /*  17 */ 1, /*  18 */ 0, /*  19 */
-  2, /*  20 */ 0, /*  21 */ 1, /*  22 */ 0, /*  23 */ 3, /*  24 */
-  0, /*  25 */ 1, /*  26 */ 0, /*  27 */ 2, /*  28 */ 0, /*  29 */
-  1, /*  30 */ 0, /*  31 */ 5, /*  32 */ 0, /*  33 */ 1, /*  34 */
-  0, /*  35 */ 2, /*  36 */ 0, /*  37 */ 1, /*  38 */ 0, /*  39 */
-  3, /*  40 */ 0, /*  41 */ 1, /*  42 */ 0, /*  43 */ 2, /*  44 */
-  0, /*  45 */ 1, /*  46 */ 0, /*  47 */ 4, /*  48 */ 0, /*  49 */
-  1, /*  50 */ 0, /*  51 */ 2, /*  52 */ 0, /*  53 */ 1, /*  54 */
-  0, /*  55 */ 3, /*  56 */ 0, /*  57 */ 1, /*  58 */ 0, /*  59 */
-  2, /*  60 */ 0, /*  61 */ 1, /*  62 */ 0, /*  63 */ 6, /*  64 */
-  0, /*  65 */ 1, /*  66 */ 0, /*  67 */ 2, /*  68 */ 0, /*  69 */
-  1, /*  70 */ 0, /*  71 */ 3, /*  72 */ 0, /*  73 */ 1, /*  74 */
-  0, /*  75 */ 2, /*  76 */ 0, /*  77 */ 1, /*  78 */ 0, /*  79 */
-  4, /*  80 */ 0, /*  81 */ 1, /*  82 */ 0, /*  83 */ 2, /*  84 */
-  0, /*  85 */ 1, /*  86 */ 0, /*  87 */ 3, /*  88 */ 0, /*  89 */
-  1, /*  90 */ 0, /*  91 */ 2, /*  92 */ 0, /*  93 */ 1, /*  94 */
-  0, /*  95 */ 5, /*  96 */ 0, /*  97 */ 1, /*  98 */ 0, /*  99 */
-  2, /* 100 */ 0, /* 101 */ 1, /* 102 */ 0, /* 103 */ 3, /* 104 */
-  0, /* 105 */ 1, /* 106 */ 0, /* 107 */ 2, /* 108 */ 0, /* 109 */
-  1, /* 110 */ 0, /* 111 */ 4, /* 112 */ 0, /* 113 */ 1, /* 114 */
-  0, /* 115 */ 2, /* 116 */ 0, /* 117 */ 1, /* 118 */ 0, /* 119 */
-  3, /* 120 */ 0, /* 121 */ 1, /* 122 */ 0, /* 123 */ 2, /* 124 */
-  0, /* 125 */ 1, /* 126 */ 0, /* 127 */ 7, /* 128 */ 0, /* 129 */
-  1, /* 130 */ 0, /* 131 */ 2, /* 132 */ 0, /* 133 */ 1, /* 134 */
-  0, /* 135 */ 3, /* 136 */ 0, /* 137 */ 1, /* 138 */ 0, /* 139 */
-  2, /* 140 */ 0, /* 141 */ 1, /* 142 */ 0, /* 143 */ 4, /* 144 */
-  0, /* 145 */ 1, /* 146 */ 0, /* 147 */ 2, /* 148 */ 0, /* 149 */
-  1, /* 150 */ 0, /* 151 */ 3, /* 152 */ 0, /* 153 */ 1, /* 154 */
-  0, /* 155 */ 2, /* 156 */ 0, /* 157 */ 1, /* 158 */ 0, /* 159 */
-  5, /* 160 */ 0, /* 161 */ 1, /* 162 */ 0, /* 163 */ 2, /* 164 */
-  0, /* 165 */ 1, /* 166 */ 0, /* 167 */ 3, /* 168 */ 0, /* 169 */
-  1, /* 170 */ 0, /* 171 */ 2, /* 172 */ 0, /* 173 */ 1, /* 174 */
-  0, /* 175 */ 4, /* 176 */ 0, /* 177 */ 1, /* 178 */ 0, /* 179 */
-  2, /* 180 */ 0, /* 181 */ 1, /* 182 */ 0, /* 183 */ 3, /* 184 */
-  0, /* 185 */ 1, /* 186 */ 0, /* 187 */ 2, /* 188 */ 0, /* 189 */
-  1, /* 190 */ 0, /* 191 */ 6, /* 192 */ 0, /* 193 */ 1, /* 194 */
-  0, /* 195 */ 2, /* 196 */ 0, /* 197 */ 1, /* 198 */ 0, /* 199 */
-  3, /* 200 */ 0, /* 201 */ 1, /* 202 */ 0, /* 203 */ 2, /* 204 */
-  0, /* 205 */ 1, /* 206 */ 0, /* 207 */ 4, /* 208 */ 0, /* 209 */
-  1, /* 210 */ 0, /* 211 */ 2, /* 212 */ 0, /* 213 */ 1, /* 214 */
-  0, /* 215 */ 3, /* 216 */ 0, /* 217 */ 1, /* 218 */ 0, /* 219 */
-  2, /* 220 */ 0, /* 221 */ 1, /* 222 */ 0, /* 223 */ 5, /* 224 */
-  0, /* 225 */ 1, /* 226 */ 0, /* 227 */ 2, /* 228 */ 0, /* 229 */
-  1, /* 230 */ 0, /* 231 */ 3, /* 232 */ 0, /* 233 */ 1, /* 234 */
-  0, /* 235 */ 2, /* 236 */ 0, /* 237 */ 1, /* 238 */ 0, /* 239 */
-  4, /* 240 */ 0, /* 241 */ 1, /* 242 */ 0, /* 243 */ 2, /* 244 */
-  0, /* 245 */ 1, /* 246 */ 0, /* 247 */ 3, /* 248 */ 0, /* 249 */
-  1, /* 250 */ 0, /* 251 */ 2, /* 252 */ 0, /* 253 */ 1, /* 254 */
-  0, /* 255 */
-}; // end _First_one
-
 
 STL_END_NAMESPACE
 
@@ -0,0 +1,236 @@
+//char_scan.h
+//单字符扫描：查找、反向查找、计数，以及同时查找2个或3个字符中的任意一个
+//char区间使用memchr/memrchr或SSE2/AVX2实现，AVX2在运行时检测CPU后才使用，
+//其他字符类型逐个比较
+
+#ifndef CHAR_SCAN_H
+#define CHAR_SCAN_H
+
+#include "configure.h"
+#include "bitops.h"
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__GNUC__) && defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+#   include <emmintrin.h>
+#   define STL_SSE2_SCAN
+#   ifdef STL_X86_DISPATCH
+#       define STL_AVX2_SCAN
+#   endif
+#endif
+
+//glibc提供memrchr
+#if defined(__GLIBC__) && defined(_GNU_SOURCE)
+#   define STL_HAS_MEMRCHR
+#endif
+
+STL_BEGIN_NAMESPACE
+
+//////////////////////////////
+//通用版本，返回找到的位置，没有找到返回last
+template<class CharT>
+inline const CharT* __scan_char(const CharT* first,const CharT* last,CharT c)
+{
+    while(first != last && !(*first == c))
+        ++first;
+    return first;
+}
+
+//[first,last)中最后一个等于c的位置，没有找到返回last
+template<class CharT>
+inline const CharT* __scan_char_back(const CharT* first,const CharT* last,CharT c)
+{
+    for(const CharT* cur = last;cur != first;)
+    {
+        if(*--cur == c)
+            return cur;
+    }
+    return last;
+}
+
+template<class CharT>
+inline size_t __count_char(const CharT* first,const CharT* last,CharT c)
+{
+    size_t n = 0;
+    for(;first != last;++first)
+        n += (*first == c);
+    return n;
+}
+
+template<class CharT>
+inline const CharT* __scan_any_of3(const CharT* first,const CharT* last,
+                                   CharT a,CharT b,CharT c)
+{
+    for(;first != last;++first)
+    {
+        if(*first == a || *first == b || *first == c)
+            break;
+    }
+    return first;
+}
+
+template<class CharT>
+inline const CharT* __scan_any_of2(const CharT* first,const CharT* last,CharT a,CharT b)
+{
+    for(;first != last;++first)
+    {
+        if(*first == a || *first == b)
+            break;
+    }
+    return first;
+}
+
+
+//////////////////////////////
+//char版本的向量化实现
+#ifdef STL_SSE2_SCAN
+inline const char* __scan_any_of3_sse2(const char* first,const char* last,
+                                       char a,char b,char c)
+{
+    const __m128i va = _mm_set1_epi8(a);
+    const __m128i vb = _mm_set1_epi8(b);
+    const __m128i vc = _mm_set1_epi8(c);
+    for(;last - first >= 16;first += 16)
+    {
+        const __m128i x = _mm_loadu_si128((const __m128i*)first);
+        const __m128i eq = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x,va),
+                                                     _mm_cmpeq_epi8(x,vb)),
+                                        _mm_cmpeq_epi8(x,vc));
+        const unsigned mask = (unsigned)_mm_movemask_epi8(eq);
+        if(mask != 0)
+            return first + __builtin_ctz(mask);
+    }
+    return __scan_any_of3<char>(first,last,a,b,c);
+}
+
+//比较结果为0xFF，用减法在每个字节上累加，最多累加255次后用sad求和
+inline size_t __count_char_sse2(const char* first,const char* last,char c)
+{
+    const __m128i vc = _mm_set1_epi8(c);
+    const __m128i zero = _mm_setzero_si128();
+    size_t n = 0;
+    while(last - first >= 16)
+    {
+        size_t blocks = (last - first) / 16;
+        if(blocks > 255)
+            blocks = 255;
+
+        __m128i acc = zero;
+        for(;blocks > 0;--blocks,first += 16)
+        {
+            const __m128i x = _mm_loadu_si128((const __m128i*)first);
+            acc = _mm_sub_epi8(acc,_mm_cmpeq_epi8(x,vc));
+        }
+        const __m128i sum = _mm_sad_epu8(acc,zero);
+        n += (size_t)_mm_cvtsi128_si32(sum) + (size_t)_mm_cvtsi128_si32(_mm_srli_si128(sum,8));
+    }
+    return n + __count_char<char>(first,last,c);
+}
+#endif // STL_SSE2_SCAN
+
+#ifdef STL_AVX2_SCAN
+__attribute__((target("avx2")))
+inline const char* __scan_any_of3_avx2(const char* first,const char* last,
+                                       char a,char b,char c)
+{
+    const __m256i va = _mm256_set1_epi8(a);
+    const __m256i vb = _mm256_set1_epi8(b);
+    const __m256i vc = _mm256_set1_epi8(c);
+    for(;last - first >= 32;first += 32)
+    {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)first);
+        const __m256i eq = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(x,va),
+                                                           _mm256_cmpeq_epi8(x,vb)),
+                                           _mm256_cmpeq_epi8(x,vc));
+        const unsigned mask = (unsigned)_mm256_movemask_epi8(eq);
+        if(mask != 0)
+            return first + __builtin_ctz(mask);
+    }
+    return __scan_any_of3_sse2(first,last,a,b,c);
+}
+
+__attribute__((target("avx2")))
+inline size_t __count_char_avx2(const char* first,const char* last,char c)
+{
+    const __m256i vc = _mm256_set1_epi8(c);
+    const __m256i zero = _mm256_setzero_si256();
+    size_t n = 0;
+    while(last - first >= 32)
+    {
+        size_t blocks = (last - first) / 32;
+        if(blocks > 255)
+            blocks = 255;
+
+        __m256i acc = zero;
+        for(;blocks > 0;--blocks,first += 32)
+        {
+            const __m256i x = _mm256_loadu_si256((const __m256i*)first);
+            acc = _mm256_sub_epi8(acc,_mm256_cmpeq_epi8(x,vc));
+        }
+        const __m256i sum = _mm256_sad_epu8(acc,zero);
+        const __m128i half = _mm_add_epi64(_mm256_castsi256_si128(sum),
+                                           _mm256_extracti128_si256(sum,1));
+        n += (size_t)_mm_cvtsi128_si32(half) + (size_t)_mm_cvtsi128_si32(_mm_srli_si128(half,8));
+    }
+    return n + __count_char_sse2(first,last,c);
+}
+#endif // STL_AVX2_SCAN
+
+
+//////////////////////////////
+//char版本的分派
+inline const char* __scan_char(const char* first,const char* last,char c)
+{
+    if(first == last)
+        return last;
+    const void* p = memchr(first,(unsigned char)c,last - first);
+    return p != 0 ? (const char*)p : last;
+}
+
+inline const char* __scan_char_back(const char* first,const char* last,char c)
+{
+#ifdef STL_HAS_MEMRCHR
+    if(first == last)
+        return last;
+    const void* p = memrchr(first,(unsigned char)c,last - first);
+    return p != 0 ? (const char*)p : last;
+#else
+    return __scan_char_back<char>(first,last,c);
+#endif
+}
+
+inline size_t __count_char(const char* first,const char* last,char c)
+{
+#if defined(STL_AVX2_SCAN)
+    if(__cpu_has_avx2())
+        return __count_char_avx2(first,last,c);
+    return __count_char_sse2(first,last,c);
+#elif defined(STL_SSE2_SCAN)
+    return __count_char_sse2(first,last,c);
+#else
+    return __count_char<char>(first,last,c);
+#endif
+}
+
+inline const char* __scan_any_of3(const char* first,const char* last,char a,char b,char c)
+{
+#if defined(STL_AVX2_SCAN)
+    if(__cpu_has_avx2())
+        return __scan_any_of3_avx2(first,last,a,b,c);
+    return __scan_any_of3_sse2(first,last,a,b,c);
+#elif defined(STL_SSE2_SCAN)
+    return __scan_any_of3_sse2(first,last,a,b,c);
+#else
+    return __scan_any_of3<char>(first,last,a,b,c);
+#endif
+}
+
+//b重复一次，与3个字符使用同一个内核
+inline const char* __scan_any_of2(const char* first,const char* last,char a,char b)
+{
+    return __scan_any_of3(first,last,a,b,b);
+}
+
+STL_END_NAMESPACE
+
+#endif // CHAR_SCAN_H
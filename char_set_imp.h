@@ -0,0 +1,230 @@
+//char_set_imp.h
+//字符集合：256位的位图，查找区间中第一个/最后一个属于（或不属于）集合的字符。
+//集合只需要构造一次，可以在多次查找之间重复使用，例如固定的分隔符集合。
+//集合不超过16个字符时使用SSE4.2的pcmpestri，每次比较16个字节（运行时检测CPU）
+
+#ifndef CHAR_SET_IMP_H
+#define CHAR_SET_IMP_H
+
+#include "configure.h"
+#include "char_scan.h"
+#include <string.h>
+
+#ifdef STL_X86_DISPATCH
+#   define STL_SSE42_SCAN
+#endif
+
+STL_BEGIN_NAMESPACE
+
+#ifdef STL_SSE42_SCAN
+//从前向后每次比较16个字节，找到时返回位置，
+//否则返回0，first移动到剩下不足16个字节的部分
+template<int Mode>
+__attribute__((target("sse4.2")))
+const char* __char_set_scan_sse42(const char*& first,const char* last,
+                                  const char* set,int set_len)
+{
+    const __m128i s = _mm_loadu_si128((const __m128i*)set);
+    for(;last - first >= 16;first += 16)
+    {
+        const __m128i x = _mm_loadu_si128((const __m128i*)first);
+        const int i = _mm_cmpestri(s,set_len,x,16,Mode);
+        if(i < 16)
+            return first + i;
+    }
+    return 0;
+}
+
+//从后向前，last移动到剩下不足16个字节的部分
+template<int Mode>
+__attribute__((target("sse4.2")))
+const char* __char_set_scan_back_sse42(const char* first,const char*& last,
+                                       const char* set,int set_len)
+{
+    const __m128i s = _mm_loadu_si128((const __m128i*)set);
+    while(last - first >= 16)
+    {
+        last -= 16;
+        const __m128i x = _mm_loadu_si128((const __m128i*)last);
+        const int i = _mm_cmpestri(s,set_len,x,16,Mode | _SIDD_MOST_SIGNIFICANT);
+        if(i < 16)
+            return last + i;
+    }
+    return 0;
+}
+
+enum
+{
+    CHAR_SET_ANY = _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY,
+    CHAR_SET_NONE = _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_NEGATIVE_POLARITY
+};
+#endif // STL_SSE42_SCAN
+
+
+class char_set
+{
+public:
+    char_set()
+    {
+        clear();
+    }
+
+    char_set(const char* s)
+    {
+        clear();
+        insert(s,s + strlen(s));
+    }
+
+    char_set(const char* s,size_t n)
+    {
+        clear();
+        insert(s,s + n);
+    }
+
+    void clear()
+    {
+        memset(m_bits,0,sizeof(m_bits));
+        memset(m_chars,0,sizeof(m_chars));
+        m_size = 0;
+    }
+
+    void insert(char c)
+    {
+        const unsigned char u = (unsigned char)c;
+        if(contains(c))
+            return;
+
+        m_bits[u >> 5] |= 1u << (u & 31);
+        //前16个不同的字符同时保存在m_chars中，供pcmpestri使用
+        if(m_size < SMALL_SET)
+            m_chars[m_size] = c;
+        ++m_size;
+    }
+
+    void insert(const char* first,const char* last)
+    {
+        for(;first != last;++first)
+            insert(*first);
+    }
+
+    bool contains(char c) const
+    {
+        const unsigned char u = (unsigned char)c;
+        return (m_bits[u >> 5] >> (u & 31)) & 1u;
+    }
+
+    //集合中不同字符的个数
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+public:
+    //以下查找函数没有找到时都返回last
+
+    //第一个属于集合的字符
+    const char* find_first_in(const char* first,const char* last) const
+    {
+        if(m_size == 0)
+            return last;
+        if(m_size == 1)
+            return __scan_char(first,last,m_chars[0]);
+        if(m_size == 2)
+            return __scan_any_of2(first,last,m_chars[0],m_chars[1]);
+        if(m_size == 3)
+            return __scan_any_of3(first,last,m_chars[0],m_chars[1],m_chars[2]);
+#ifdef STL_SSE42_SCAN
+        if(use_sse42())
+        {
+            const char* p = __char_set_scan_sse42<CHAR_SET_ANY>(first,last,m_chars,m_size);
+            if(p != 0)
+                return p;
+        }
+#endif
+        for(;first != last;++first)
+            if(contains(*first))
+                return first;
+        return last;
+    }
+
+    //第一个不属于集合的字符
+    const char* find_first_not_in(const char* first,const char* last) const
+    {
+#ifdef STL_SSE42_SCAN
+        if(m_size > 0 && use_sse42())
+        {
+            const char* p = __char_set_scan_sse42<CHAR_SET_NONE>(first,last,m_chars,m_size);
+            if(p != 0)
+                return p;
+        }
+#endif
+        for(;first != last;++first)
+            if(!contains(*first))
+                return first;
+        return last;
+    }
+
+    //最后一个属于集合的字符
+    const char* find_last_in(const char* first,const char* last) const
+    {
+        if(m_size == 0)
+            return last;
+        if(m_size == 1)
+            return __scan_char_back(first,last,m_chars[0]);
+
+        const char* end = last;
+#ifdef STL_SSE42_SCAN
+        if(use_sse42())
+        {
+            const char* p = __char_set_scan_back_sse42<CHAR_SET_ANY>(first,end,m_chars,m_size);
+            if(p != 0)
+                return p;
+        }
+#endif
+        while(end != first)
+            if(contains(*--end))
+                return end;
+        return last;
+    }
+
+    //最后一个不属于集合的字符
+    const char* find_last_not_in(const char* first,const char* last) const
+    {
+        const char* end = last;
+#ifdef STL_SSE42_SCAN
+        if(m_size > 0 && use_sse42())
+        {
+            const char* p = __char_set_scan_back_sse42<CHAR_SET_NONE>(first,end,m_chars,m_size);
+            if(p != 0)
+                return p;
+        }
+#endif
+        while(end != first)
+            if(!contains(*--end))
+                return end;
+        return last;
+    }
+
+private:
+    enum {SMALL_SET = 16};
+
+#ifdef STL_SSE42_SCAN
+    bool use_sse42() const
+    {
+        return m_size <= SMALL_SET && __cpu_has_sse42();
+    }
+#endif
+
+    unsigned int m_bits[8];
+    char m_chars[SMALL_SET];
+    int m_size;
+};
+
+STL_END_NAMESPACE
+
+#endif // CHAR_SET_IMP_H
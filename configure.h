@@ -9,7 +9,47 @@
 using std::cout;
 using std::endl;
 
+//C++11支持，移动语义、线程缓存等功能依赖它
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+#   define STL_CXX11
+#endif
+
+//移动语义：C++11中STL_MOVE(x)把x转换为右值，之前的标准中就是x本身
+#ifdef STL_CXX11
+#   include <utility>
+#   define STL_MOVE(x) std::move(x)
+#   define STL_NOEXCEPT noexcept
+#else
+#   define STL_MOVE(x) (x)
+#   define STL_NOEXCEPT
+#endif
+
+//线程局部存储
+#if defined(STL_CXX11)
+#   define STL_THREAD_LOCAL thread_local
+#elif defined(__GNUC__)
+#   define STL_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+#   define STL_THREAD_LOCAL __declspec(thread)
+#endif
+
+//线程支持，内存池使用GCC原子操作实现自旋锁
+#if defined(__GNUC__) && !defined(STL_NO_THREADS)
+#   define STL_THREADS
+#endif
+
+//编译器提供的类型特性内建函数（__has_trivial_copy、__is_pod等），
+//type_traits.h用它们识别用户定义的平凡类型
+#if defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 3))) \
+    || (defined(_MSC_VER) && _MSC_VER >= 1400)
+#   define STL_HAS_TYPE_TRAITS_INTRINSICS
+#endif
+
 //内存分配器
+//STL_DEFAULT_ALLOCATOR(T)决定容器默认的分配器，可以在包含头文件之前定义，
+//例如 -D'STL_DEFAULT_ALLOCATOR(T)=malloc_alloc'。
+//默认的alloc是小对象内存池default_alloc，定义STL_USE_MALLOC时alloc为malloc_alloc
+//#define STL_USE_MALLOC
 //#define STL_USE_STD_ALLOCATORS
 
 #ifndef STL_DEFAULT_ALLOCATOR
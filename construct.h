@@ -4,10 +4,19 @@
 #define CONSTRUCT_H
 
 #include "configure.h"
+#include "type_traits.h"
 #include <new>
 
 STL_BEGIN_NAMESPACE
 
+#ifdef STL_CXX11
+//使用任意参数在p处构造对象，参数被完美转发给构造函数
+template <class T,class... Args>
+inline void construct(T* p,Args&&... args)
+{
+    new((void*)p) T(std::forward<Args>(args)...);
+}
+#else
 template <class T1,class T2>
 inline void construct(T1 *p,const T2& value)
 {
@@ -20,6 +29,7 @@ inline void construct(T* p)
 {
      new ((void*)p) T();
 }
+#endif
 
 template <class T>
 inline void destroy(T* pointer)
@@ -34,11 +44,24 @@ inline void destroy(ForwardIterator first,ForwardIterator last)
       destroy(&*first);
 }
 
-inline void destroy(char *,char*) {}
-inline void destroy(int *,int *) {}
-inline void destroy(long *,long *) {}
-inline void destroy(float *,float *) {}
-inline void destroy(double*,double*) {}
+template <class Tp>
+inline void __destroy_aux(Tp* first,Tp* last,__false_type)
+{
+    for ( ; first != last; ++first)
+      first->~Tp();
+}
+
+//析构函数平凡，什么也不做
+template <class Tp>
+inline void __destroy_aux(Tp*,Tp*,__true_type) {}
+
+//指针区间：按析构函数是否平凡分派，内置类型、指针和POD不产生任何代码
+template <class Tp>
+inline void destroy(Tp* first,Tp* last)
+{
+    typedef typename __type_traits<Tp>::has_trivial_destructor trivial_destructor;
+    __destroy_aux(first,last,trivial_destructor());
+}
 
 STL_END_NAMESPACE
 
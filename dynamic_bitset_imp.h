@@ -0,0 +1,466 @@
+//dynamic_bitset_imp.h
+//运行时确定大小的bitset
+//word保存在vector中，位运算、移位、查找、计数使用bitset_imp.h中的word数组函数，
+//和bitset一样按word批量处理。最高word中超出size()的bit始终为0
+
+#ifndef DYNAMIC_BITSET_IMP_H
+#define DYNAMIC_BITSET_IMP_H
+
+#include "configure.h"
+#include "bitset_imp.h"
+#include "vector_imp.h"
+
+STL_BEGIN_NAMESPACE
+
+//Block为unsigned int或unsigned long
+template<class Block = unsigned long,class Alloc = STL_DEFAULT_ALLOCATOR(Block)>
+class dynamic_bitset
+{
+public:
+    typedef Block block_type;
+    typedef Alloc allocator_type;
+    typedef size_t size_type;
+
+    enum {bits_per_block = sizeof(Block) * CHAR_BIT};
+    static const size_type npos;
+
+public: //实现b[i]操作
+    class reference
+    {
+        friend class dynamic_bitset;
+
+        Block* wp;
+        Block mask;
+        reference();
+
+    public:
+        reference(dynamic_bitset& b,size_type pos)
+            : wp(&b.m_bits[block_index(pos)]),mask(bit_mask(pos))
+        {}
+
+        reference& operator =(bool x)
+        {
+            if(x)
+                *wp |= mask;
+            else
+                *wp &= ~mask;
+            return *this;
+        }
+
+        reference& operator =(const reference& j)
+        {
+            return *this = bool(j);
+        }
+
+        bool operator ~() const
+        {
+            return (*wp & mask) == 0;
+        }
+
+        operator bool() const
+        {
+            return (*wp & mask) != 0;
+        }
+
+        reference& flip()
+        {
+            *wp ^= mask;
+            return *this;
+        }
+    };
+
+public:
+    dynamic_bitset()
+        : m_size(0)
+    {}
+
+    //n个bit，低位用val初始化
+    explicit dynamic_bitset(size_type n,unsigned long val = 0)
+        : m_bits(calc_blocks(n),Block(0)),m_size(n)
+    {
+        const size_type ulong_bits = sizeof(unsigned long) * CHAR_BIT;
+        for(size_type i = 0;i < num_blocks() && i * bits_per_block < ulong_bits;i++)
+            m_bits[i] = Block(val >> (i * bits_per_block));
+        do_sanitize();
+    }
+
+public: //大小
+    size_type size() const
+    {
+        return m_size;
+    }
+
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    size_type num_blocks() const
+    {
+        return m_bits.size();
+    }
+
+    //可以容纳的bit数
+    size_type capacity() const
+    {
+        return m_bits.capacity() * bits_per_block;
+    }
+
+    void reserve(size_type n)
+    {
+        m_bits.reserve(calc_blocks(n));
+    }
+
+    //新增的bit为value
+    void resize(size_type n,bool value = false)
+    {
+        const Block v = value ? ~Block(0) : Block(0);
+
+        //原来最高word中未使用的bit
+        if(value && n > m_size && extra_bits() != 0)
+            m_bits[num_blocks() - 1] |= v << extra_bits();
+
+        m_bits.resize(calc_blocks(n),v);
+        m_size = n;
+        do_sanitize();
+    }
+
+    void push_back(bool value)
+    {
+        if(extra_bits() == 0)
+            m_bits.push_back(Block(0));
+        ++m_size;
+        if(value)
+            m_bits[num_blocks() - 1] |= bit_mask(m_size - 1);
+    }
+
+    void pop_back()
+    {
+        --m_size;
+        if(extra_bits() == 0)
+            m_bits.pop_back();
+        else
+            do_sanitize();
+    }
+
+    void clear()
+    {
+        m_bits.clear();
+        m_size = 0;
+    }
+
+    void swap(dynamic_bitset& x)
+    {
+        m_bits.swap(x.m_bits);
+        std::swap(m_size,x.m_size);
+    }
+
+    //word数组，最低位的bit在第0个word
+    const Block* data() const
+    {
+        return m_bits.begin();
+    }
+
+public: //操作符重载，两个对象的大小必须相同
+    dynamic_bitset& operator &=(const dynamic_bitset& rhs)
+    {
+        check_size(rhs);
+        __bits_and(m_bits.begin(),rhs.m_bits.begin(),num_blocks());
+        return *this;
+    }
+
+    dynamic_bitset& operator |=(const dynamic_bitset& rhs)
+    {
+        check_size(rhs);
+        __bits_or(m_bits.begin(),rhs.m_bits.begin(),num_blocks());
+        return *this;
+    }
+
+    dynamic_bitset& operator ^=(const dynamic_bitset& rhs)
+    {
+        check_size(rhs);
+        __bits_xor(m_bits.begin(),rhs.m_bits.begin(),num_blocks());
+        return *this;
+    }
+
+    dynamic_bitset& operator <<=(size_type pos)
+    {
+        __bits_left_shift(m_bits.begin(),num_blocks(),pos);
+        do_sanitize();
+        return *this;
+    }
+
+    dynamic_bitset& operator >>=(size_type pos)
+    {
+        __bits_right_shift(m_bits.begin(),num_blocks(),pos);
+        return *this;
+    }
+
+    dynamic_bitset operator <<(size_type pos) const
+    {
+        return dynamic_bitset(*this) <<= pos;
+    }
+
+    dynamic_bitset operator >>(size_type pos) const
+    {
+        return dynamic_bitset(*this) >>= pos;
+    }
+
+    dynamic_bitset operator ~() const
+    {
+        return dynamic_bitset(*this).flip();
+    }
+
+    bool operator ==(const dynamic_bitset& rhs) const
+    {
+        return m_size == rhs.m_size
+            && __bits_is_equal(m_bits.begin(),rhs.m_bits.begin(),num_blocks());
+    }
+
+    bool operator !=(const dynamic_bitset& rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+public: //set,reset,flip
+    dynamic_bitset& set()
+    {
+        fill(m_bits.begin(),m_bits.end(),~Block(0));
+        do_sanitize();
+        return *this;
+    }
+
+    dynamic_bitset& set(size_type pos,bool val = true)
+    {
+        check_pos(pos);
+        return val ? unchecked_set(pos) : unchecked_reset(pos);
+    }
+
+    dynamic_bitset& reset()
+    {
+        fill(m_bits.begin(),m_bits.end(),Block(0));
+        return *this;
+    }
+
+    dynamic_bitset& reset(size_type pos)
+    {
+        check_pos(pos);
+        return unchecked_reset(pos);
+    }
+
+    dynamic_bitset& flip()
+    {
+        __bits_flip(m_bits.begin(),num_blocks());
+        do_sanitize();
+        return *this;
+    }
+
+    dynamic_bitset& flip(size_type pos)
+    {
+        check_pos(pos);
+        return unchecked_flip(pos);
+    }
+
+    bool test(size_type pos) const
+    {
+        check_pos(pos);
+        return unchecked_test(pos);
+    }
+
+public: //不检查范围
+    dynamic_bitset& unchecked_set(size_type pos)
+    {
+        m_bits[block_index(pos)] |= bit_mask(pos);
+        return *this;
+    }
+
+    dynamic_bitset& unchecked_reset(size_type pos)
+    {
+        m_bits[block_index(pos)] &= ~bit_mask(pos);
+        return *this;
+    }
+
+    dynamic_bitset& unchecked_flip(size_type pos)
+    {
+        m_bits[block_index(pos)] ^= bit_mask(pos);
+        return *this;
+    }
+
+    bool unchecked_test(size_type pos) const
+    {
+        return (m_bits[block_index(pos)] & bit_mask(pos)) != Block(0);
+    }
+
+    reference operator[](size_type pos)
+    {
+        return reference(*this,pos);
+    }
+
+    bool operator[](size_type pos) const
+    {
+        return unchecked_test(pos);
+    }
+
+public: //helper
+    size_type count() const
+    {
+        return __bits_count(m_bits.begin(),num_blocks());
+    }
+
+    bool any() const
+    {
+        return __bits_is_any(m_bits.begin(),num_blocks());
+    }
+
+    bool none() const
+    {
+        return !any();
+    }
+
+    bool all() const
+    {
+        return count() == m_size;
+    }
+
+    //按位运算之后1的个数，不产生临时对象，两个对象的大小必须相同
+    size_type count_and(const dynamic_bitset& rhs) const
+    {
+        check_size(rhs);
+        return __bits_count_op<BITS_OP_AND>(m_bits.begin(),rhs.m_bits.begin(),num_blocks());
+    }
+
+    size_type count_or(const dynamic_bitset& rhs) const
+    {
+        check_size(rhs);
+        return __bits_count_op<BITS_OP_OR>(m_bits.begin(),rhs.m_bits.begin(),num_blocks());
+    }
+
+    size_type count_xor(const dynamic_bitset& rhs) const
+    {
+        check_size(rhs);
+        return __bits_count_op<BITS_OP_XOR>(m_bits.begin(),rhs.m_bits.begin(),num_blocks());
+    }
+
+    size_type count_andnot(const dynamic_bitset& rhs) const
+    {
+        check_size(rhs);
+        return __bits_count_op<BITS_OP_ANDNOT>(m_bits.begin(),rhs.m_bits.begin(),num_blocks());
+    }
+
+    bool intersects(const dynamic_bitset& rhs) const
+    {
+        check_size(rhs);
+        return __bits_intersects(m_bits.begin(),rhs.m_bits.begin(),num_blocks());
+    }
+
+    bool is_subset_of(const dynamic_bitset& rhs) const
+    {
+        check_size(rhs);
+        return __bits_is_subset(m_bits.begin(),rhs.m_bits.begin(),num_blocks());
+    }
+
+    //没有找到返回npos
+    size_type find_first() const
+    {
+        return __bits_find_first(m_bits.begin(),num_blocks(),npos);
+    }
+
+    size_type find_next(size_type prev) const
+    {
+        return __bits_find_next(m_bits.begin(),num_blocks(),prev,npos);
+    }
+
+    //与bitset相同，string[0]表示最高bit
+    void copy_to_string(string& s) const
+    {
+        s.assign(m_size,'0');
+        for(size_type i = find_first();i != npos;i = find_next(i))
+            s[m_size - 1 - i] = '1';
+    }
+
+private:
+    static size_type calc_blocks(size_type n)
+    {
+        return (n + bits_per_block - 1) / bits_per_block;
+    }
+
+    static size_type block_index(size_type pos)
+    {
+        return pos / bits_per_block;
+    }
+
+    static Block bit_mask(size_type pos)
+    {
+        return Block(1) << (pos % bits_per_block);
+    }
+
+    //最高word中使用的bit数，0表示全部使用
+    size_type extra_bits() const
+    {
+        return m_size % bits_per_block;
+    }
+
+    //将最高word的多余bit清空
+    void do_sanitize()
+    {
+        if(extra_bits() != 0)
+            m_bits[num_blocks() - 1] &= ~(~Block(0) << extra_bits());
+    }
+
+    void check_pos(size_type pos) const
+    {
+        if(pos >= m_size)
+            STL_THROW(out_of_range("dynamic_bitset"));
+    }
+
+    void check_size(const dynamic_bitset& x) const
+    {
+        if(m_size != x.m_size)
+            STL_THROW(invalid_argument("dynamic_bitset"));
+    }
+
+private:
+    vector<Block,Alloc> m_bits;
+    size_type m_size;
+};
+
+template<class Block,class Alloc>
+const typename dynamic_bitset<Block,Alloc>::size_type
+dynamic_bitset<Block,Alloc>::npos = static_cast<size_t>(-1);
+
+template<class Block,class Alloc>
+inline dynamic_bitset<Block,Alloc> operator&(const dynamic_bitset<Block,Alloc>& x,
+                                             const dynamic_bitset<Block,Alloc>& y)
+{
+    dynamic_bitset<Block,Alloc> result(x);
+    result &= y;
+    return result;
+}
+
+template<class Block,class Alloc>
+inline dynamic_bitset<Block,Alloc> operator|(const dynamic_bitset<Block,Alloc>& x,
+                                             const dynamic_bitset<Block,Alloc>& y)
+{
+    dynamic_bitset<Block,Alloc> result(x);
+    result |= y;
+    return result;
+}
+
+template<class Block,class Alloc>
+inline dynamic_bitset<Block,Alloc> operator^(const dynamic_bitset<Block,Alloc>& x,
+                                             const dynamic_bitset<Block,Alloc>& y)
+{
+    dynamic_bitset<Block,Alloc> result(x);
+    result ^= y;
+    return result;
+}
+
+template<class Block,class Alloc>
+inline void swap(dynamic_bitset<Block,Alloc>& x,dynamic_bitset<Block,Alloc>& y)
+{
+    x.swap(y);
+}
+
+STL_END_NAMESPACE
+
+#endif // DYNAMIC_BITSET_IMP_H
@@ -0,0 +1,59 @@
+//growth_policy.h
+//vector和basic_string空间不足时的扩容策略，作为容器的最后一个模板参数
+//1.growth_double：容量翻倍，默认策略
+//2.growth_golden：容量增加一半，浪费的空间最多为1/3，
+//  并且释放的旧空间之和可以满足后面的申请，内存分配器可以重用
+//3.growth_fit<Base>：按Base计算之后，把字节数上调到分配器实际提供的大小
+//  （alloc_traits<Alloc>::good_size），多出来的空间直接计入容量而不是浪费掉
+
+#ifndef GROWTH_POLICY_H
+#define GROWTH_POLICY_H
+
+#include "configure.h"
+#include "alloc_imp.h"
+
+STL_BEGIN_NAMESPACE
+
+//next(old_cap,required)返回新的容量，不小于required
+struct growth_double
+{
+    enum {fit_allocator = false};
+
+    static size_t next(size_t old_cap,size_t required)
+    {
+        const size_t len = old_cap != 0 ? 2 * old_cap : 1;
+        return len > required ? len : required;
+    }
+};
+
+struct growth_golden
+{
+    enum {fit_allocator = false};
+
+    static size_t next(size_t old_cap,size_t required)
+    {
+        const size_t len = old_cap + old_cap / 2 + 1;
+        return len > required ? len : required;
+    }
+};
+
+template<class Base = growth_golden>
+struct growth_fit : public Base
+{
+    enum {fit_allocator = true};
+};
+
+//扩容后的容量，elem_size为元素大小；
+//extra为容量之外还要分配的元素个数（basic_string的结束符），一起按分配器的大小上调
+template<class Growth,class Alloc>
+inline size_t __grow_capacity(size_t old_cap,size_t required,size_t elem_size,size_t extra = 0)
+{
+    size_t len = Growth::next(old_cap,required) + extra;
+    if(Growth::fit_allocator)
+        len = alloc_traits<Alloc>::good_size(len * elem_size) / elem_size;
+    return len - extra;
+}
+
+STL_END_NAMESPACE
+
+#endif // GROWTH_POLICY_H
@@ -4,7 +4,157 @@
 #ifndef ITERATOR_IMP_H
 #define ITERATOR_IMP_H
 
+#include "configure.h"
+#include <stddef.h>
+#include <iterator>
+
+STL_BEGIN_NAMESPACE
+
+//////////////////////////////////////////
+//迭代器类型标签，算法根据标签选择实现
+struct input_iterator_tag {};
+struct output_iterator_tag {};
+struct forward_iterator_tag : public input_iterator_tag {};
+struct bidirectional_iterator_tag : public forward_iterator_tag {};
+struct random_access_iterator_tag : public bidirectional_iterator_tag {};
+
+//标准库的迭代器标签转换为上面的标签，标准容器和流的迭代器也可以按类型分派
+template<class Category>
+struct __iterator_category_of
+{
+    typedef Category type;
+};
+
+#define STL_MAP_ITERATOR_TAG(tag) \
+    STL_TEMPLATE_NULL struct __iterator_category_of<std::tag> \
+    { \
+        typedef tag type; \
+    };
+
+STL_MAP_ITERATOR_TAG(input_iterator_tag)
+STL_MAP_ITERATOR_TAG(output_iterator_tag)
+STL_MAP_ITERATOR_TAG(forward_iterator_tag)
+STL_MAP_ITERATOR_TAG(bidirectional_iterator_tag)
+STL_MAP_ITERATOR_TAG(random_access_iterator_tag)
+
+#undef STL_MAP_ITERATOR_TAG
+
+//迭代器特性：迭代器类自己定义这些类型，指针由偏特化提供
+template<class Iterator>
+struct iterator_traits
+{
+    typedef typename __iterator_category_of<
+        typename Iterator::iterator_category>::type iterator_category;
+    typedef typename Iterator::value_type value_type;
+    typedef typename Iterator::difference_type difference_type;
+    typedef typename Iterator::pointer pointer;
+    typedef typename Iterator::reference reference;
+};
+
+template<class Tp>
+struct iterator_traits<Tp*>
+{
+    typedef random_access_iterator_tag iterator_category;
+    typedef Tp value_type;
+    typedef ptrdiff_t difference_type;
+    typedef Tp* pointer;
+    typedef Tp& reference;
+};
+
+template<class Tp>
+struct iterator_traits<const Tp*>
+{
+    typedef random_access_iterator_tag iterator_category;
+    typedef Tp value_type;
+    typedef ptrdiff_t difference_type;
+    typedef const Tp* pointer;
+    typedef const Tp& reference;
+};
+
+//返回迭代器类型标签的对象，用于函数重载
+template<class Iterator>
+inline typename iterator_traits<Iterator>::iterator_category
+iterator_category(const Iterator&)
+{
+    typedef typename iterator_traits<Iterator>::iterator_category category;
+    return category();
+}
+
+//////////////////////////////////////////
+//distance：计算两个迭代器之间的距离
+//随机访问迭代器直接相减，其他迭代器逐个前进
+template<class InputIter,class Distance>
+inline void __distance(InputIter first,InputIter last,Distance& n,
+                       input_iterator_tag)
+{
+    while(first != last)
+    {
+        ++first;
+        ++n;
+    }
+}
+
+template<class RandomAccessIter,class Distance>
+inline void __distance(RandomAccessIter first,RandomAccessIter last,
+                       Distance& n,random_access_iterator_tag)
+{
+    n += last - first;
+}
+
+//结果保存在n中
+template<class InputIter,class Distance>
+inline void distance(InputIter first,InputIter last,Distance& n)
+{
+    n = 0;
+    __distance(first,last,n,iterator_category(first));
+}
+
+template<class InputIter>
+inline typename iterator_traits<InputIter>::difference_type
+distance(InputIter first,InputIter last)
+{
+    typename iterator_traits<InputIter>::difference_type n = 0;
+    __distance(first,last,n,iterator_category(first));
+    return n;
+}
+
+//////////////////////////////////////////
+//advance：迭代器前进n步，双向迭代器n可以为负，随机访问迭代器一步到位
+template<class InputIter,class Distance>
+inline void __advance(InputIter& i,Distance n,input_iterator_tag)
+{
+    while(n--)
+        ++i;
+}
+
+template<class BidirectionalIter,class Distance>
+inline void __advance(BidirectionalIter& i,Distance n,
+                      bidirectional_iterator_tag)
+{
+    if(n >= 0)
+        while(n--)
+            ++i;
+    else
+        while(n++)
+            --i;
+}
+
+template<class RandomAccessIter,class Distance>
+inline void __advance(RandomAccessIter& i,Distance n,
+                      random_access_iterator_tag)
+{
+    i += n;
+}
+
+template<class InputIter,class Distance>
+inline void advance(InputIter& i,Distance n)
+{
+    __advance(i,n,iterator_category(i));
+}
+
+//////////////////////////////////////////
 //逆向迭代器
+//迭代器类型与原迭代器相同，随机访问的原迭代器得到随机访问的逆向迭代器
 template<class RandomAccessIterator,class Tp,class Reference = Tp&,
          class Distance = ptrdiff_t>
 class reverse_iterator
@@ -15,6 +165,8 @@ protected:
     RandomAccessIterator current;
 
 public:
+    typedef typename iterator_traits<RandomAccessIterator>::iterator_category
+        iterator_category;
     typedef Tp value_type;
     typedef Distance difference_type;
     typedef Tp* pointer;
@@ -127,7 +279,7 @@ inline bool operator<(const reverse_iterator<RandomAccessIterator,Tp,
                        const reverse_iterator<RandomAccessIterator,Tp,
                                               Reference,Distance>& y)
 {
-    return x.base() < y.base();
+    return y.base() < x.base();
 }
 
 
@@ -179,7 +331,8 @@ inline Distance operator-(const reverse_iterator<RandomAccessIterator,Tp,
                           const reverse_iterator<RandomAccessIterator,Tp,
                           Reference,Distance>& y)
 {
-    return (x.base() - y.base());
+    //逆向迭代器的方向与原迭代器相反
+    return (y.base() - x.base());
 }
 
 template<class RandomAccessIterator,class Tp,
@@ -191,5 +344,6 @@ operator+(Distance n,const reverse_iterator<RandomAccessIterator,Tp,
     return reverse_iterator<RandomAccessIterator,Tp,Reference,Distance>(x.base()-n);
 }
 
+STL_END_NAMESPACE
 
 #endif // ITERATOR_IMP_H
@@ -0,0 +1,596 @@
+//memory_resource_imp.h
+//多态内存资源：运行时选择内存分配策略，容器保存资源指针
+
+#ifndef MEMORY_RESOURCE_IMP_H
+#define MEMORY_RESOURCE_IMP_H
+
+#include "configure.h"
+#include "alloc_imp.h"
+#include <new>
+
+//synchronized_pool_resource需要真正的锁：C++11使用std::mutex，否则使用
+//STL_mutex_lock，它只在定义了STL_THREADS时加锁。两者都没有时不提供这个类
+#ifdef STL_CXX11
+#   include <mutex>
+#   define STL_SYNCHRONIZED_POOL
+#elif defined(STL_THREADS)
+#   define STL_SYNCHRONIZED_POOL
+#endif
+
+STL_BEGIN_NAMESPACE
+
+//不指定对齐时使用的对齐值，与malloc保证的对齐一致
+enum {RESOURCE_ALIGN = 2 * sizeof(void*)};
+
+///////////////////////////
+//内存资源基类
+class memory_resource
+{
+public:
+    virtual ~memory_resource() {}
+
+    void* allocate(size_t bytes,size_t alignment = RESOURCE_ALIGN)
+    {
+        return do_allocate(bytes,alignment);
+    }
+
+    void deallocate(void* p,size_t bytes,size_t alignment = RESOURCE_ALIGN)
+    {
+        do_deallocate(p,bytes,alignment);
+    }
+
+    //一个资源分配的内存能否由另一个资源释放
+    bool is_equal(const memory_resource& other) const
+    {
+        return do_is_equal(other);
+    }
+
+protected:
+    virtual void* do_allocate(size_t bytes,size_t alignment) = 0;
+    virtual void do_deallocate(void* p,size_t bytes,size_t alignment) = 0;
+    virtual bool do_is_equal(const memory_resource& other) const
+    {
+        return this == &other;
+    }
+};
+
+inline bool operator==(const memory_resource& a,const memory_resource& b)
+{
+    return &a == &b || a.is_equal(b);
+}
+
+inline bool operator!=(const memory_resource& a,const memory_resource& b)
+{
+    return !(a == b);
+}
+
+//将p上调至alignment的倍数，alignment为2的幂
+inline char* align_up(char* p,size_t alignment)
+{
+    return (char*)(((size_t)p + alignment - 1) & ~(alignment - 1));
+}
+
+
+///////////////////////////
+//使用operator new/delete的资源，作为其他资源的上游
+class new_delete_memory_resource : public memory_resource
+{
+protected:
+    virtual void* do_allocate(size_t bytes,size_t alignment)
+    {
+        if(alignment <= (size_t)RESOURCE_ALIGN)
+            return ::operator new(bytes);
+
+        //对齐要求超过operator new的保证：多申请alignment字节，
+        //在返回地址之前保存原始地址
+        char* raw = (char*)::operator new(bytes + alignment + sizeof(void*));
+        char* result = align_up(raw + sizeof(void*),alignment);
+        ((void**)result)[-1] = raw;
+        return result;
+    }
+
+    virtual void do_deallocate(void* p,size_t,size_t alignment)
+    {
+        if(alignment <= (size_t)RESOURCE_ALIGN)
+            ::operator delete(p);
+        else
+            ::operator delete(((void**)p)[-1]);
+    }
+
+    //所有new_delete_memory_resource实例可以互相释放
+    virtual bool do_is_equal(const memory_resource& other) const
+    {
+        return dynamic_cast<const new_delete_memory_resource*>(&other) != 0;
+    }
+};
+
+//总是分配失败的资源，用于禁止monotonic_buffer_resource超出给定的缓冲区
+class null_memory_resource_imp : public memory_resource
+{
+protected:
+    virtual void* do_allocate(size_t,size_t)
+    {
+        THROW_BAD_ALLOC;
+        return 0;
+    }
+
+    virtual void do_deallocate(void*,size_t,size_t) {}
+};
+
+inline memory_resource* new_delete_resource()
+{
+    static new_delete_memory_resource resource;
+    return &resource;
+}
+
+inline memory_resource* null_memory_resource()
+{
+    static null_memory_resource_imp resource;
+    return &resource;
+}
+
+//默认资源，polymorphic_allocator默认构造时使用
+inline memory_resource*& default_resource_ref()
+{
+    static memory_resource* resource = new_delete_resource();
+    return resource;
+}
+
+inline memory_resource* get_default_resource()
+{
+    return default_resource_ref();
+}
+
+//设置默认资源，返回之前的默认资源，r为0时恢复为new_delete_resource()
+inline memory_resource* set_default_resource(memory_resource* r)
+{
+    memory_resource* old = default_resource_ref();
+    default_resource_ref() = r ? r : new_delete_resource();
+    return old;
+}
+
+
+///////////////////////////
+//单调缓冲资源
+//从当前缓冲区顺序分配，deallocate不回收，release()或析构时把所有块还给上游。
+//缓冲区用完后向上游申请新块，块大小按几何级数增长。
+class monotonic_buffer_resource : public memory_resource
+{
+private:
+    struct block
+    {
+        block* prev;
+        size_t size;            //包括块头的大小
+    };
+
+    memory_resource* m_upstream;
+    block* m_head;
+    char* m_cur;
+    char* m_end;
+    char* m_initial_buffer;
+    size_t m_initial_buffer_size;
+    size_t m_next_size;
+
+    monotonic_buffer_resource(const monotonic_buffer_resource&);
+    monotonic_buffer_resource& operator=(const monotonic_buffer_resource&);
+
+    void grow(size_t bytes,size_t alignment)
+    {
+        size_t size = m_next_size;
+        while(size < sizeof(block) + bytes + alignment)
+            size *= 2;
+
+        block* b = (block*)m_upstream->allocate(size,RESOURCE_ALIGN);
+        b->prev = m_head;
+        b->size = size;
+        m_head = b;
+        m_cur = (char*)(b + 1);
+        m_end = (char*)b + size;
+        m_next_size = size * 2;
+    }
+
+public:
+    explicit monotonic_buffer_resource(memory_resource* upstream = get_default_resource())
+        : m_upstream(upstream),m_head(0),m_cur(0),m_end(0),
+          m_initial_buffer(0),m_initial_buffer_size(0),m_next_size(1024)
+    {}
+
+    monotonic_buffer_resource(size_t initial_size,
+                              memory_resource* upstream = get_default_resource())
+        : m_upstream(upstream),m_head(0),m_cur(0),m_end(0),
+          m_initial_buffer(0),m_initial_buffer_size(0),
+          m_next_size(initial_size > sizeof(block) ? initial_size : 1024)
+    {}
+
+    //先使用调用者提供的缓冲区
+    monotonic_buffer_resource(void* buffer,size_t buffer_size,
+                              memory_resource* upstream = get_default_resource())
+        : m_upstream(upstream),m_head(0),m_cur((char*)buffer),m_end((char*)buffer + buffer_size),
+          m_initial_buffer((char*)buffer),m_initial_buffer_size(buffer_size),
+          m_next_size(buffer_size > 512 ? buffer_size * 2 : 1024)
+    {}
+
+    virtual ~monotonic_buffer_resource()
+    {
+        release();
+    }
+
+    //归还所有块，重新使用初始缓冲区
+    void release()
+    {
+        while(m_head != 0)
+        {
+            block* prev = m_head->prev;
+            m_upstream->deallocate(m_head,m_head->size,RESOURCE_ALIGN);
+            m_head = prev;
+        }
+        m_cur = m_initial_buffer;
+        m_end = m_initial_buffer + m_initial_buffer_size;
+    }
+
+    memory_resource* upstream_resource() const
+    {
+        return m_upstream;
+    }
+
+protected:
+    virtual void* do_allocate(size_t bytes,size_t alignment)
+    {
+        char* p = align_up(m_cur,alignment);
+        if(m_cur == 0 || p + bytes > m_end)
+        {
+            grow(bytes,alignment);
+            p = align_up(m_cur,alignment);
+        }
+        m_cur = p + bytes;
+        return p;
+    }
+
+    virtual void do_deallocate(void*,size_t,size_t) {}
+};
+
+
+///////////////////////////
+//内存池参数
+struct pool_options
+{
+    size_t max_blocks_per_chunk;            //每次向上游申请的最多对象数
+    size_t largest_required_pool_block;     //超过这个大小的请求直接交给上游
+
+    pool_options()
+        : max_blocks_per_chunk(256),largest_required_pool_block(1024) {}
+};
+
+
+///////////////////////////
+//非同步内存池资源
+//请求按2的幂分到各个池，每个池有自己的自由链表，空时从上游申请一块连续内存切分，
+//每块包含的对象数按几何级数增长。大请求直接交给上游，并记录下来以便release()。
+//单线程使用。
+class unsynchronized_pool_resource : public memory_resource
+{
+private:
+    enum {MIN_BLOCK = 8};
+    enum {MAX_POOLS = 32};
+
+    union obj
+    {
+        obj* free_list_link;
+        char client_data[1];
+    };
+
+    //从上游申请的内存块，池的块和大请求都会记录
+    struct chunk
+    {
+        chunk* prev;
+        chunk* next;
+        size_t size;            //包括块头的大小
+        size_t alignment;
+    };
+
+    struct pool
+    {
+        obj* free_list;
+        size_t next_blocks;     //下次补充的对象数
+    };
+
+    memory_resource* m_upstream;
+    pool_options m_options;
+    size_t m_npools;
+    pool m_pools[MAX_POOLS];
+    chunk* m_chunks;            //池使用的块
+    chunk* m_large;             //大请求，双向链表，可以单个释放
+
+    unsynchronized_pool_resource(const unsynchronized_pool_resource&);
+    unsynchronized_pool_resource& operator=(const unsynchronized_pool_resource&);
+
+    //第i个池的对象大小
+    static size_t block_size(size_t i)
+    {
+        return (size_t)MIN_BLOCK << i;
+    }
+
+    size_t pool_index(size_t bytes) const
+    {
+        size_t i = 0;
+        while(block_size(i) < bytes)
+            ++i;
+        return i;
+    }
+
+    //块头后面的数据按RESOURCE_ALIGN对齐
+    static size_t header_size()
+    {
+        return (sizeof(chunk) + RESOURCE_ALIGN - 1) & ~((size_t)RESOURCE_ALIGN - 1);
+    }
+
+    chunk* upstream_chunk(size_t data_size,size_t alignment)
+    {
+        const size_t size = header_size() + data_size;
+        chunk* c = (chunk*)m_upstream->allocate(size,alignment);
+        c->size = size;
+        c->alignment = alignment;
+        return c;
+    }
+
+    void refill(size_t i)
+    {
+        pool& p = m_pools[i];
+        const size_t size = block_size(i);
+        const size_t n = p.next_blocks;
+        const size_t alignment = size < (size_t)RESOURCE_ALIGN ? (size_t)RESOURCE_ALIGN : size;
+
+        //上游只保证RESOURCE_ALIGN对齐，多申请的部分用于对齐对象
+        chunk* c = upstream_chunk(size * n + alignment - RESOURCE_ALIGN,RESOURCE_ALIGN);
+        c->prev = 0;
+        c->next = m_chunks;
+        m_chunks = c;
+
+        //对象按自身大小对齐
+        char* data = align_up((char*)c + header_size(),alignment);
+        for(size_t k = 0;k < n;k++)
+        {
+            obj* q = (obj*)(data + k * size);
+            q->free_list_link = p.free_list;
+            p.free_list = q;
+        }
+
+        if(p.next_blocks < m_options.max_blocks_per_chunk)
+            p.next_blocks *= 2;
+        if(p.next_blocks > m_options.max_blocks_per_chunk)
+            p.next_blocks = m_options.max_blocks_per_chunk;
+    }
+
+public:
+    explicit unsynchronized_pool_resource(memory_resource* upstream = get_default_resource())
+        : m_upstream(upstream),m_chunks(0),m_large(0)
+    {
+        init();
+    }
+
+    unsynchronized_pool_resource(const pool_options& opts,
+                                 memory_resource* upstream = get_default_resource())
+        : m_upstream(upstream),m_options(opts),m_chunks(0),m_large(0)
+    {
+        init();
+    }
+
+    virtual ~unsynchronized_pool_resource()
+    {
+        release();
+    }
+
+    //把所有内存还给上游，包括尚未释放的对象
+    void release()
+    {
+        while(m_chunks != 0)
+        {
+            chunk* next = m_chunks->next;
+            m_upstream->deallocate(m_chunks,m_chunks->size,RESOURCE_ALIGN);
+            m_chunks = next;
+        }
+        while(m_large != 0)
+        {
+            chunk* next = m_large->next;
+            m_upstream->deallocate(m_large,m_large->size,m_large->alignment);
+            m_large = next;
+        }
+        for(size_t i = 0;i < m_npools;i++)
+        {
+            m_pools[i].free_list = 0;
+            m_pools[i].next_blocks = 4;
+        }
+    }
+
+    memory_resource* upstream_resource() const
+    {
+        return m_upstream;
+    }
+
+    pool_options options() const
+    {
+        return m_options;
+    }
+
+private:
+    void init()
+    {
+        if(m_options.max_blocks_per_chunk < 4)
+            m_options.max_blocks_per_chunk = 4;
+        if(m_options.largest_required_pool_block < (size_t)MIN_BLOCK)
+            m_options.largest_required_pool_block = MIN_BLOCK;
+
+        m_npools = pool_index(m_options.largest_required_pool_block) + 1;
+        if(m_npools > (size_t)MAX_POOLS)
+            m_npools = MAX_POOLS;
+        m_options.largest_required_pool_block = block_size(m_npools - 1);
+
+        for(size_t i = 0;i < m_npools;i++)
+        {
+            m_pools[i].free_list = 0;
+            m_pools[i].next_blocks = 4;
+        }
+    }
+
+protected:
+    virtual void* do_allocate(size_t bytes,size_t alignment)
+    {
+        //对齐要求大于对象大小时，使用更大的池
+        const size_t need = bytes < alignment ? alignment : bytes;
+        if(need > m_options.largest_required_pool_block)
+        {
+            const size_t align = alignment > (size_t)RESOURCE_ALIGN ? alignment : (size_t)RESOURCE_ALIGN;
+            const size_t header = (header_size() + align - 1) & ~(align - 1);
+            chunk* c = upstream_chunk(header - header_size() + bytes,align);
+            c->prev = 0;
+            c->next = m_large;
+            if(m_large != 0)
+                m_large->prev = c;
+            m_large = c;
+            return (char*)c + header;
+        }
+
+        const size_t i = pool_index(need);
+        pool& p = m_pools[i];
+        if(p.free_list == 0)
+            refill(i);
+
+        obj* result = p.free_list;
+        p.free_list = result->free_list_link;
+        return result;
+    }
+
+    virtual void do_deallocate(void* ptr,size_t bytes,size_t alignment)
+    {
+        const size_t need = bytes < alignment ? alignment : bytes;
+        if(need > m_options.largest_required_pool_block)
+        {
+            const size_t align = alignment > (size_t)RESOURCE_ALIGN ? alignment : (size_t)RESOURCE_ALIGN;
+            const size_t header = (header_size() + align - 1) & ~(align - 1);
+            chunk* c = (chunk*)((char*)ptr - header);
+            if(c->prev != 0)
+                c->prev->next = c->next;
+            else
+                m_large = c->next;
+            if(c->next != 0)
+                c->next->prev = c->prev;
+            m_upstream->deallocate(c,c->size,c->alignment);
+            return;
+        }
+
+        obj* q = (obj*)ptr;
+        pool& p = m_pools[pool_index(need)];
+        q->free_list_link = p.free_list;
+        p.free_list = q;
+    }
+};
+
+
+#ifdef STL_SYNCHRONIZED_POOL
+///////////////////////////
+//同步内存池资源，在unsynchronized_pool_resource外加锁，可以被多个线程共享
+class synchronized_pool_resource : public memory_resource
+{
+private:
+    unsynchronized_pool_resource m_pool;
+#ifdef STL_CXX11
+    std::mutex m_lock;
+    typedef std::lock_guard<std::mutex> lock_guard;
+#else
+    STL_mutex_lock m_lock;
+
+    class lock_guard
+    {
+        STL_mutex_lock& m_lock;
+    public:
+        lock_guard(STL_mutex_lock& l) : m_lock(l) { m_lock.acquire(); }
+        ~lock_guard() { m_lock.release(); }
+    };
+#endif
+
+public:
+    //值初始化m_lock：STL_mutex_lock清零即为未加锁状态
+    explicit synchronized_pool_resource(memory_resource* upstream = get_default_resource())
+        : m_pool(upstream),m_lock() {}
+
+    synchronized_pool_resource(const pool_options& opts,
+                               memory_resource* upstream = get_default_resource())
+        : m_pool(opts,upstream),m_lock() {}
+
+    void release()
+    {
+        lock_guard guard(m_lock);
+        m_pool.release();
+    }
+
+    memory_resource* upstream_resource() const
+    {
+        return m_pool.upstream_resource();
+    }
+
+    pool_options options() const
+    {
+        return m_pool.options();
+    }
+
+protected:
+    virtual void* do_allocate(size_t bytes,size_t alignment)
+    {
+        lock_guard guard(m_lock);
+        return m_pool.allocate(bytes,alignment);
+    }
+
+    virtual void do_deallocate(void* p,size_t bytes,size_t alignment)
+    {
+        lock_guard guard(m_lock);
+        m_pool.deallocate(p,bytes,alignment);
+    }
+};
+#endif //STL_SYNCHRONIZED_POOL
+
+
+///////////////////////////
+//多态分配器，可以作为容器的Alloc参数
+//与alloc等分配器一样按字节分配，但保存一个memory_resource指针，
+//同一种容器类型可以在运行时使用不同的内存策略。
+class polymorphic_allocator
+{
+private:
+    memory_resource* m_resource;
+
+public:
+    polymorphic_allocator()
+        : m_resource(get_default_resource()) {}
+
+    polymorphic_allocator(memory_resource* r)
+        : m_resource(r ? r : get_default_resource()) {}
+
+    void* allocate(size_t n)
+    {
+        return m_resource->allocate(n);
+    }
+
+    void deallocate(void* p,size_t n)
+    {
+        m_resource->deallocate(p,n);
+    }
+
+    memory_resource* resource() const
+    {
+        return m_resource;
+    }
+};
+
+inline bool operator==(const polymorphic_allocator& a,const polymorphic_allocator& b)
+{
+    return *a.resource() == *b.resource();
+}
+
+inline bool operator!=(const polymorphic_allocator& a,const polymorphic_allocator& b)
+{
+    return !(a == b);
+}
+
+STL_END_NAMESPACE
+
+#endif // MEMORY_RESOURCE_IMP_H
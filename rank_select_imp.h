@@ -0,0 +1,214 @@
+//rank_select_imp.h
+//bitset上的rank/select索引
+//rank1(pos)：[0,pos)中1的个数；select1(k)：第k个（从0开始）1的位置。
+//两级目录：每65536 bit一个超级块保存之前1的总数（size_t），
+//每512 bit一个块保存相对于超级块的1的个数（unsigned short），额外空间约3%。
+//rank为查表加上最多一个块内的popcount，O(1)；
+//select每8192个1（或0）记录一次所在的块，在两次记录之间二分查找块，再在块内查找word。
+//索引不复制数据，只保存word数组的指针，bitset修改之后需要重新build
+
+#ifndef RANK_SELECT_IMP_H
+#define RANK_SELECT_IMP_H
+
+#include "configure.h"
+#include "bitset_imp.h"
+#include "dynamic_bitset_imp.h"
+#include "vector_imp.h"
+
+STL_BEGIN_NAMESPACE
+
+class rank_select
+{
+public:
+    typedef size_t size_type;
+
+    static const size_type npos = static_cast<size_t>(-1);
+
+public:
+    rank_select()
+        : m_words(0),m_size(0),m_ones(0)
+    {}
+
+    //w中超出nbits的bit必须为0
+    rank_select(const unsigned long* w,size_type nbits)
+    {
+        build(w,nbits);
+    }
+
+    template<size_t Nb>
+    explicit rank_select(const bitset<Nb>& b)
+    {
+        build(b.data(),b.size());
+    }
+
+    template<class Alloc>
+    explicit rank_select(const dynamic_bitset<unsigned long,Alloc>& b)
+    {
+        build(b.data(),b.size());
+    }
+
+    void build(const unsigned long* w,size_type nbits);
+
+    //bit的个数
+    size_type size() const
+    {
+        return m_size;
+    }
+
+    //1的个数
+    size_type count() const
+    {
+        return m_ones;
+    }
+
+    //[0,pos)中1的个数，pos不超过size()
+    size_type rank1(size_type pos) const
+    {
+        if(pos >= m_size)
+            return m_ones;
+
+        const size_type b = pos / BLOCK_BITS;
+        size_type r = block_rank(b);
+        const size_type last = pos / BITS_PER_WORD;
+        for(size_type i = b * BLOCK_WORDS;i < last;i++)
+            r += __popcount_word(m_words[i]);
+
+        const size_type offset = pos % BITS_PER_WORD;
+        if(offset != 0)
+            r += __popcount_word(m_words[last] << (BITS_PER_WORD - offset));
+        return r;
+    }
+
+    size_type rank0(size_type pos) const
+    {
+        if(pos > m_size)
+            pos = m_size;
+        return pos - rank1(pos);
+    }
+
+    //第k个1的位置，k不小于count()时返回npos
+    size_type select1(size_type k) const
+    {
+        if(k >= m_ones)
+            return npos;
+
+        const size_type b = find_block(k,m_sample1,true);
+        k -= block_rank(b);
+        for(size_type i = b * BLOCK_WORDS;;i++)
+        {
+            const size_type n = __popcount_word(m_words[i]);
+            if(k < n)
+                return i * BITS_PER_WORD + __select_word(m_words[i],k);
+            k -= n;
+        }
+    }
+
+    //第k个0的位置
+    size_type select0(size_type k) const
+    {
+        if(k >= m_size - m_ones)
+            return npos;
+
+        const size_type b = find_block(k,m_sample0,false);
+        k -= b * BLOCK_BITS - block_rank(b);
+        for(size_type i = b * BLOCK_WORDS;;i++)
+        {
+            const size_type n = BITS_PER_WORD - __popcount_word(m_words[i]);
+            if(k < n)
+                return i * BITS_PER_WORD + __select_word(~m_words[i],k);
+            k -= n;
+        }
+    }
+
+    //索引占用的字节数
+    size_type memory_usage() const
+    {
+        return m_super.size() * sizeof(size_t) + m_block.size() * sizeof(unsigned short)
+            + (m_sample1.size() + m_sample0.size()) * sizeof(size_t);
+    }
+
+private:
+    enum
+    {
+        BLOCK_BITS = 512,
+        SUPER_BITS = 65536,
+        BLOCKS_PER_SUPER = SUPER_BITS / BLOCK_BITS,
+        BLOCK_WORDS = BLOCK_BITS / BITS_PER_WORD,
+        SELECT_SAMPLE = 8192
+    };
+
+    //第b个块之前1的个数
+    size_type block_rank(size_type b) const
+    {
+        return m_super[b / BLOCKS_PER_SUPER] + m_block[b];
+    }
+
+    //第k个1（ones为false时为0）所在的块：
+    //从采样得到块的范围，再二分查找最后一个之前的个数不超过k的块
+    size_type find_block(size_type k,const vector<size_t>& sample,bool ones) const
+    {
+        const size_type s = k / SELECT_SAMPLE;
+        size_type lo = sample[s];
+        size_type hi = s + 1 < sample.size() ? sample[s + 1] + 1 : m_block.size();
+        while(hi - lo > 1)
+        {
+            const size_type mid = lo + (hi - lo) / 2;
+            const size_type r = ones ? block_rank(mid) : mid * BLOCK_BITS - block_rank(mid);
+            if(r <= k)
+                lo = mid;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+private:
+    const unsigned long* m_words;
+    size_type m_size;
+    size_type m_ones;
+    vector<size_t> m_super;             //每个超级块之前1的个数
+    vector<unsigned short> m_block;     //每个块之前、超级块之内1的个数
+    vector<size_t> m_sample1;           //第i*SELECT_SAMPLE个1所在的块
+    vector<size_t> m_sample0;           //第i*SELECT_SAMPLE个0所在的块
+};
+
+inline void rank_select::build(const unsigned long* w,size_type nbits)
+{
+    m_words = w;
+    m_size = nbits;
+    m_ones = 0;
+
+    const size_type nwords = (nbits + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    const size_type nblocks = (nbits + BLOCK_BITS - 1) / BLOCK_BITS;
+    m_super.clear();
+    m_super.reserve((nbits + SUPER_BITS - 1) / SUPER_BITS);
+    m_block.resize(nblocks);
+    m_sample1.clear();
+    m_sample0.clear();
+
+    size_type zeros = 0;
+    for(size_type b = 0;b < nblocks;b++)
+    {
+        if(b % BLOCKS_PER_SUPER == 0)
+            m_super.push_back(m_ones);
+        m_block[b] = (unsigned short)(m_ones - m_super.back());
+
+        const size_type first = b * BLOCK_WORDS;
+        const size_type last = first + BLOCK_WORDS < nwords ? first + BLOCK_WORDS : nwords;
+        const size_type ones = __popcount_words(w + first,last - first);
+        const size_type bits = b + 1 < nblocks ? (size_type)BLOCK_BITS : nbits - b * BLOCK_BITS;
+
+        //这个块中包含的采样点
+        for(size_type k = m_sample1.size() * SELECT_SAMPLE;k < m_ones + ones;k += SELECT_SAMPLE)
+            m_sample1.push_back(b);
+        for(size_type k = m_sample0.size() * SELECT_SAMPLE;k < zeros + bits - ones;k += SELECT_SAMPLE)
+            m_sample0.push_back(b);
+
+        m_ones += ones;
+        zeros += bits - ones;
+    }
+}
+
+STL_END_NAMESPACE
+
+#endif // RANK_SELECT_IMP_H
@@ -0,0 +1,1053 @@
+//roaring_imp.h
+//压缩位图（Roaring）：32位无符号整数的集合
+//按高16位分块，每块最多65536个值，根据块内的分布选择容器：
+//1.数组容器：有序的低16位，不超过4096个值
+//2.位图容器：65536个bit，超过4096个值时使用，位运算使用bitset_imp.h中的word数组函数
+//3.行程容器：(起点,长度-1)对，由run_optimize()转换，适合连续的区间
+//稀疏集合只占用约2字节/值，稠密集合约1bit/值
+
+#ifndef ROARING_IMP_H
+#define ROARING_IMP_H
+
+#include "configure.h"
+#include "bitset_imp.h"
+#include "vector_imp.h"
+#include <stdexcept>
+
+STL_BEGIN_NAMESPACE
+
+enum
+{
+    ROARING_CHUNK_BITS = 65536,
+    ROARING_CHUNK_WORDS = ROARING_CHUNK_BITS / BITS_PER_WORD,
+    ROARING_ARRAY_MAX = 4096        //数组容器最多的值，超过时转为位图容器
+};
+
+//一个块的容器
+struct roaring_container
+{
+    enum {ARRAY,BITMAP,RUN};
+
+    unsigned short key;             //高16位
+    unsigned char type;
+    size_t card;                    //值的个数
+    vector<unsigned short> values;  //ARRAY：有序的值；RUN：起点和长度-1交替存放
+    vector<unsigned long> words;    //BITMAP：ROARING_CHUNK_WORDS个word
+
+    roaring_container()
+        : key(0),type(ARRAY),card(0)
+    {}
+
+    explicit roaring_container(unsigned short k)
+        : key(k),type(ARRAY),card(0)
+    {}
+
+    size_t num_runs() const
+    {
+        return values.size() / 2;
+    }
+
+    bool test_bit(unsigned low) const
+    {
+        return (words[low / BITS_PER_WORD] >> (low % BITS_PER_WORD)) & 1UL;
+    }
+
+    void set_bit(unsigned low)
+    {
+        words[low / BITS_PER_WORD] |= 1UL << (low % BITS_PER_WORD);
+    }
+
+    void clear_bit(unsigned low)
+    {
+        words[low / BITS_PER_WORD] &= ~(1UL << (low % BITS_PER_WORD));
+    }
+};
+
+//[first,first+n)中第一个不小于v的位置
+inline size_t __roaring_lower_bound(const unsigned short* first,size_t n,unsigned v)
+{
+    size_t lo = 0;
+    while(n > 0)
+    {
+        const size_t half = n / 2;
+        if(first[lo + half] < v)
+        {
+            lo += half + 1;
+            n -= half + 1;
+        }
+        else
+        {
+            n = half;
+        }
+    }
+    return lo;
+}
+
+//从pos开始按1、2、4...倍跳跃，再二分，适合两个数组大小相差很大的情况
+inline size_t __roaring_gallop(const unsigned short* a,size_t pos,size_t n,unsigned v)
+{
+    if(pos >= n || a[pos] >= v)
+        return pos;
+
+    size_t step = 1;
+    size_t lo = pos;
+    while(lo + step < n && a[lo + step] < v)
+    {
+        lo += step;
+        step *= 2;
+    }
+    const size_t hi = lo + step < n ? lo + step : n;
+    return lo + 1 + __roaring_lower_bound(a + lo + 1,hi - lo - 1,v);
+}
+
+//将位图中[lo,hi]的bit置1
+inline void __roaring_set_range(unsigned long* w,unsigned lo,unsigned hi)
+{
+    const size_t first = lo / BITS_PER_WORD;
+    const size_t last = hi / BITS_PER_WORD;
+    const unsigned long first_mask = ~0UL << (lo % BITS_PER_WORD);
+    const unsigned long last_mask = ~0UL >> (BITS_PER_WORD - 1 - hi % BITS_PER_WORD);
+
+    if(first == last)
+    {
+        w[first] |= first_mask & last_mask;
+        return;
+    }
+    w[first] |= first_mask;
+    for(size_t i = first + 1;i < last;i++)
+        w[i] = ~0UL;
+    w[last] |= last_mask;
+}
+
+
+//////////////////////////////////////////////
+//Roaring位图
+class roaring_bitmap
+{
+public:
+    typedef unsigned int value_type;
+    typedef size_t size_type;
+
+    class const_iterator;
+    friend class const_iterator;
+
+    //按从小到大的顺序遍历所有的值
+    class const_iterator
+    {
+        friend class roaring_bitmap;
+
+    public:
+        typedef forward_iterator_tag iterator_category;
+        typedef unsigned int value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const unsigned int* pointer;
+        typedef const unsigned int& reference;
+
+        const_iterator()
+            : m_owner(0),m_ci(0),m_pos(0),m_value(0)
+        {}
+
+        reference operator*() const
+        {
+            return m_value;
+        }
+
+        const_iterator& operator++()
+        {
+            const roaring_container& c = m_owner->m_containers[m_ci];
+            const unsigned low = m_value & 0xFFFF;
+            switch(c.type)
+            {
+            case roaring_container::ARRAY:
+                if(++m_pos < c.values.size())
+                {
+                    set_low(c,c.values[m_pos]);
+                    return *this;
+                }
+                break;
+            case roaring_container::BITMAP:
+                m_pos = __bits_find_next(c.words.begin(),(size_t)ROARING_CHUNK_WORDS,
+                                         m_pos,(size_t)ROARING_CHUNK_BITS);
+                if(m_pos < ROARING_CHUNK_BITS)
+                {
+                    set_low(c,(unsigned)m_pos);
+                    return *this;
+                }
+                break;
+            default:
+                if(low < (unsigned)c.values[2 * m_pos] + c.values[2 * m_pos + 1])
+                {
+                    set_low(c,low + 1);
+                    return *this;
+                }
+                if(++m_pos < c.num_runs())
+                {
+                    set_low(c,c.values[2 * m_pos]);
+                    return *this;
+                }
+                break;
+            }
+            seek(m_ci + 1);
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        bool operator==(const const_iterator& x) const
+        {
+            return m_ci == x.m_ci && m_value == x.m_value;
+        }
+
+        bool operator!=(const const_iterator& x) const
+        {
+            return !(*this == x);
+        }
+
+    private:
+        const roaring_bitmap* m_owner;
+        size_t m_ci;            //容器的下标
+        size_t m_pos;           //ARRAY：值的下标；BITMAP：bit的位置；RUN：行程的下标
+        unsigned int m_value;
+
+        const_iterator(const roaring_bitmap* owner,size_t ci)
+            : m_owner(owner),m_ci(0),m_pos(0),m_value(0)
+        {
+            seek(ci);
+        }
+
+        void set_low(const roaring_container& c,unsigned low)
+        {
+            m_value = ((unsigned int)c.key << 16) | low;
+        }
+
+        //移动到第ci个容器的第一个值，ci为容器个数时表示结束
+        void seek(size_t ci)
+        {
+            m_ci = ci;
+            m_pos = 0;
+            m_value = 0;
+            if(ci >= m_owner->m_containers.size())
+                return;
+
+            const roaring_container& c = m_owner->m_containers[ci];
+            if(c.type == roaring_container::BITMAP)
+                m_pos = __bits_find_first(c.words.begin(),(size_t)ROARING_CHUNK_WORDS,
+                                          (size_t)ROARING_CHUNK_BITS);
+            set_low(c,c.type == roaring_container::BITMAP ? (unsigned)m_pos : c.values[0]);
+        }
+    };
+
+public:
+    roaring_bitmap() {}
+
+    const_iterator begin() const
+    {
+        return const_iterator(this,0);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(this,m_containers.size());
+    }
+
+    //值的个数
+    size_type cardinality() const
+    {
+        size_type n = 0;
+        for(size_t i = 0;i < m_containers.size();i++)
+            n += m_containers[i].card;
+        return n;
+    }
+
+    bool empty() const
+    {
+        return m_containers.empty();
+    }
+
+    void clear()
+    {
+        m_containers.clear();
+    }
+
+    void swap(roaring_bitmap& x)
+    {
+        m_containers.swap(x.m_containers);
+    }
+
+    bool contains(value_type x) const
+    {
+        const size_t ci = find_container(x >> 16);
+        if(ci == m_containers.size() || m_containers[ci].key != (x >> 16))
+            return false;
+        return container_contains(m_containers[ci],x & 0xFFFF);
+    }
+
+    //插入x，x已经存在时返回false
+    bool add(value_type x)
+    {
+        roaring_container& c = get_container(x >> 16);
+        const unsigned low = x & 0xFFFF;
+        if(c.type == roaring_container::RUN)
+            uncompress(c);
+
+        if(c.type == roaring_container::ARRAY)
+        {
+            const size_t pos = __roaring_lower_bound(c.values.begin(),c.values.size(),low);
+            if(pos < c.values.size() && c.values[pos] == low)
+                return false;
+            if(c.values.size() < ROARING_ARRAY_MAX)
+            {
+                c.values.insert(c.values.begin() + pos,(unsigned short)low);
+                ++c.card;
+                return true;
+            }
+            to_bitmap(c);
+        }
+
+        if(c.test_bit(low))
+            return false;
+        c.set_bit(low);
+        ++c.card;
+        return true;
+    }
+
+    //插入[first,last]中所有的值
+    void add_range(value_type first,value_type last)
+    {
+        if(first > last)
+            return;
+        for(unsigned key = first >> 16;;key++)
+        {
+            const unsigned lo = key == (first >> 16) ? (first & 0xFFFF) : 0;
+            const unsigned hi = key == (last >> 16) ? (last & 0xFFFF) : 0xFFFF;
+            roaring_container& c = get_container(key);
+            if(c.card == 0)
+            {
+                //新的块直接使用一个行程
+                c.type = roaring_container::RUN;
+                c.values.push_back((unsigned short)lo);
+                c.values.push_back((unsigned short)(hi - lo));
+                c.card = hi - lo + 1;
+            }
+            else
+            {
+                uncompress(c);
+                //结果不超过ROARING_ARRAY_MAX时仍然是数组容器
+                if(c.type != roaring_container::ARRAY || !add_range_to_array(c,lo,hi))
+                {
+                    if(c.type == roaring_container::ARRAY)
+                        to_bitmap(c);
+                    __roaring_set_range(c.words.begin(),lo,hi);
+                    c.card = __bits_count(c.words.begin(),(size_t)ROARING_CHUNK_WORDS);
+                    shrink(c);
+                }
+            }
+            if(key == (last >> 16))
+                break;
+        }
+    }
+
+    //删除x，x不存在时返回false
+    bool remove(value_type x)
+    {
+        const size_t ci = find_container(x >> 16);
+        if(ci == m_containers.size() || m_containers[ci].key != (x >> 16))
+            return false;
+
+        roaring_container& c = m_containers[ci];
+        const unsigned low = x & 0xFFFF;
+        if(!container_contains(c,low))
+            return false;
+
+        if(c.type == roaring_container::RUN)
+            uncompress(c);
+        if(c.type == roaring_container::ARRAY)
+            c.values.erase(c.values.begin()
+                           + __roaring_lower_bound(c.values.begin(),c.values.size(),low));
+        else
+            c.clear_bit(low);
+
+        if(--c.card == 0)
+            m_containers.erase(m_containers.begin() + ci);
+        else
+            shrink(c);
+        return true;
+    }
+
+    //把行程更短的容器转换为行程容器，返回是否有容器被转换
+    bool run_optimize();
+
+    //序列化，格式为小端：
+    //容器个数(u32)，每个容器：高16位(u16)、类型(u8)、个数(u32)，然后是数据：
+    //ARRAY为每个值(u16)，BITMAP为8192字节，RUN为每个行程的起点和长度-1(u16,u16)
+    size_type serialized_size() const;
+    size_type serialize(char* out) const;
+
+    //数据格式不正确时抛出invalid_argument
+    static roaring_bitmap deserialize(const char* in,size_type n);
+
+public: //集合运算
+    roaring_bitmap& operator&=(const roaring_bitmap& x)
+    {
+        roaring_bitmap result = binary_op(*this,x,AND);
+        swap(result);
+        return *this;
+    }
+
+    roaring_bitmap& operator|=(const roaring_bitmap& x)
+    {
+        roaring_bitmap result = binary_op(*this,x,OR);
+        swap(result);
+        return *this;
+    }
+
+    roaring_bitmap& operator^=(const roaring_bitmap& x)
+    {
+        roaring_bitmap result = binary_op(*this,x,XOR);
+        swap(result);
+        return *this;
+    }
+
+    //差集
+    roaring_bitmap& operator-=(const roaring_bitmap& x)
+    {
+        roaring_bitmap result = binary_op(*this,x,ANDNOT);
+        swap(result);
+        return *this;
+    }
+
+    friend roaring_bitmap operator&(const roaring_bitmap& x,const roaring_bitmap& y)
+    {
+        return binary_op(x,y,AND);
+    }
+
+    friend roaring_bitmap operator|(const roaring_bitmap& x,const roaring_bitmap& y)
+    {
+        return binary_op(x,y,OR);
+    }
+
+    friend roaring_bitmap operator^(const roaring_bitmap& x,const roaring_bitmap& y)
+    {
+        return binary_op(x,y,XOR);
+    }
+
+    friend roaring_bitmap operator-(const roaring_bitmap& x,const roaring_bitmap& y)
+    {
+        return binary_op(x,y,ANDNOT);
+    }
+
+    //只比较值，不比较容器类型
+    bool operator==(const roaring_bitmap& x) const
+    {
+        if(cardinality() != x.cardinality())
+            return false;
+        const_iterator i = begin(),j = x.begin(),e = end();
+        for(;i != e;++i,++j)
+            if(*i != *j)
+                return false;
+        return true;
+    }
+
+    bool operator!=(const roaring_bitmap& x) const
+    {
+        return !(*this == x);
+    }
+
+private:
+    enum op_type {AND,OR,XOR,ANDNOT};
+
+    vector<roaring_container> m_containers;     //按key排序
+
+    //第一个key不小于k的容器
+    size_t find_container(unsigned k) const
+    {
+        size_t lo = 0,n = m_containers.size();
+        while(n > 0)
+        {
+            const size_t half = n / 2;
+            if(m_containers[lo + half].key < k)
+            {
+                lo += half + 1;
+                n -= half + 1;
+            }
+            else
+            {
+                n = half;
+            }
+        }
+        return lo;
+    }
+
+    //获取key为k的容器，不存在时插入空的数组容器
+    roaring_container& get_container(unsigned k)
+    {
+        const size_t ci = find_container(k);
+        if(ci == m_containers.size() || m_containers[ci].key != k)
+            m_containers.insert(m_containers.begin() + ci,roaring_container((unsigned short)k));
+        return m_containers[ci];
+    }
+
+    static bool container_contains(const roaring_container& c,unsigned low)
+    {
+        if(c.type == roaring_container::BITMAP)
+            return c.test_bit(low);
+
+        if(c.type == roaring_container::ARRAY)
+        {
+            const size_t pos = __roaring_lower_bound(c.values.begin(),c.values.size(),low);
+            return pos < c.values.size() && c.values[pos] == low;
+        }
+
+        //最后一个起点不大于low的行程
+        size_t lo = 0,n = c.num_runs();
+        while(n > 0)
+        {
+            const size_t half = n / 2;
+            if(c.values[2 * (lo + half)] <= low)
+            {
+                lo += half + 1;
+                n -= half + 1;
+            }
+            else
+            {
+                n = half;
+            }
+        }
+        return lo > 0 && low <= (unsigned)c.values[2 * (lo - 1)] + c.values[2 * (lo - 1) + 1];
+    }
+
+    //把[lo,hi]并入数组容器，结果超过ROARING_ARRAY_MAX时不修改并返回false
+    static bool add_range_to_array(roaring_container& c,unsigned lo,unsigned hi)
+    {
+        const unsigned short* v = c.values.begin();
+        const size_t a = __roaring_lower_bound(v,c.values.size(),lo);
+        const size_t b = __roaring_lower_bound(v,c.values.size(),hi + 1);
+        const size_t card = c.values.size() - (b - a) + (hi - lo + 1);
+        if(card > ROARING_ARRAY_MAX)
+            return false;
+
+        vector<unsigned short> values;
+        values.reserve(card);
+        values.insert(values.end(),v,v + a);
+        for(unsigned x = lo;x <= hi;x++)
+            values.push_back((unsigned short)x);
+        values.insert(values.end(),v + b,v + c.values.size());
+        c.values.swap(values);
+        c.card = card;
+        return true;
+    }
+
+    //容器转换
+    static void to_bitmap(roaring_container& c)
+    {
+        vector<unsigned long> words(ROARING_CHUNK_WORDS,0UL);
+        if(c.type == roaring_container::ARRAY)
+        {
+            for(size_t i = 0;i < c.values.size();i++)
+                words[c.values[i] / BITS_PER_WORD] |= 1UL << (c.values[i] % BITS_PER_WORD);
+        }
+        else
+        {
+            for(size_t r = 0;r < c.num_runs();r++)
+                __roaring_set_range(words.begin(),c.values[2 * r],
+                                    (unsigned)c.values[2 * r] + c.values[2 * r + 1]);
+        }
+        c.words.swap(words);
+        vector<unsigned short>().swap(c.values);
+        c.type = roaring_container::BITMAP;
+    }
+
+    static void to_array(roaring_container& c)
+    {
+        vector<unsigned short> values;
+        values.reserve(c.card);
+        if(c.type == roaring_container::BITMAP)
+        {
+            for(size_t i = 0;i < ROARING_CHUNK_WORDS;i++)
+            {
+                for(unsigned long w = c.words[i];w != 0;w &= w - 1)
+                    values.push_back((unsigned short)(i * BITS_PER_WORD + __ctz_word(w)));
+            }
+            vector<unsigned long>().swap(c.words);
+        }
+        else
+        {
+            for(size_t r = 0;r < c.num_runs();r++)
+                for(unsigned v = c.values[2 * r];v <= (unsigned)c.values[2 * r] + c.values[2 * r + 1];v++)
+                    values.push_back((unsigned short)v);
+        }
+        c.values.swap(values);
+        c.type = roaring_container::ARRAY;
+    }
+
+    //行程容器转换为数组或位图容器
+    static void uncompress(roaring_container& c)
+    {
+        if(c.type != roaring_container::RUN)
+            return;
+        if(c.card <= ROARING_ARRAY_MAX)
+            to_array(c);
+        else
+            to_bitmap(c);
+    }
+
+    //位图容器的值不超过ROARING_ARRAY_MAX时转换为数组容器
+    static void shrink(roaring_container& c)
+    {
+        if(c.type == roaring_container::BITMAP && c.card <= ROARING_ARRAY_MAX)
+            to_array(c);
+    }
+
+    static roaring_container container_op(const roaring_container& x,
+                                          const roaring_container& y,op_type op);
+
+    static roaring_bitmap binary_op(const roaring_bitmap& x,const roaring_bitmap& y,
+                                    op_type op);
+};
+
+
+//两个容器的运算，结果的card为0时由调用者丢弃
+inline roaring_container roaring_bitmap::container_op(const roaring_container& x0,
+                                                      const roaring_container& y0,
+                                                      op_type op)
+{
+    //行程容器先展开
+    roaring_container xt,yt;
+    const roaring_container* px = &x0;
+    const roaring_container* py = &y0;
+    if(x0.type == roaring_container::RUN)
+    {
+        xt = x0;
+        uncompress(xt);
+        px = &xt;
+    }
+    if(y0.type == roaring_container::RUN)
+    {
+        yt = y0;
+        uncompress(yt);
+        py = &yt;
+    }
+    const roaring_container& x = *px;
+    const roaring_container& y = *py;
+
+    roaring_container r(x.key);
+
+    if(x.type == roaring_container::BITMAP && y.type == roaring_container::BITMAP)
+    {
+        r.type = roaring_container::BITMAP;
+        r.words = x.words;
+        switch(op)
+        {
+        case AND:    __bits_and(r.words.begin(),y.words.begin(),(size_t)ROARING_CHUNK_WORDS); break;
+        case OR:     __bits_or(r.words.begin(),y.words.begin(),(size_t)ROARING_CHUNK_WORDS); break;
+        case XOR:    __bits_xor(r.words.begin(),y.words.begin(),(size_t)ROARING_CHUNK_WORDS); break;
+        case ANDNOT: __bits_andnot(r.words.begin(),y.words.begin(),(size_t)ROARING_CHUNK_WORDS); break;
+        }
+        r.card = __bits_count(r.words.begin(),(size_t)ROARING_CHUNK_WORDS);
+        shrink(r);
+        return r;
+    }
+
+    if(x.type == roaring_container::ARRAY && y.type == roaring_container::ARRAY)
+    {
+        const unsigned short* a = x.values.begin();
+        const unsigned short* b = y.values.begin();
+        const size_t na = x.values.size(),nb = y.values.size();
+        size_t i = 0,j = 0;
+
+        if(op == AND)
+        {
+            r.values.reserve(na < nb ? na : nb);
+            //大小相差很大时在大的数组中跳跃查找
+            if(na * 64 < nb || nb * 64 < na)
+            {
+                const bool small_a = na < nb;
+                const unsigned short* s = small_a ? a : b;
+                const unsigned short* l = small_a ? b : a;
+                const size_t ns = small_a ? na : nb,nl = small_a ? nb : na;
+                for(;i < ns;i++)
+                {
+                    j = __roaring_gallop(l,j,nl,s[i]);
+                    if(j == nl)
+                        break;
+                    if(l[j] == s[i])
+                        r.values.push_back(s[i]);
+                }
+            }
+            else
+            {
+                while(i < na && j < nb)
+                {
+                    if(a[i] < b[j])
+                        ++i;
+                    else if(b[j] < a[i])
+                        ++j;
+                    else
+                    {
+                        r.values.push_back(a[i]);
+                        ++i;
+                        ++j;
+                    }
+                }
+            }
+        }
+        else
+        {
+            r.values.reserve(op == ANDNOT ? na : na + nb);
+            while(i < na && j < nb)
+            {
+                if(a[i] < b[j])
+                    r.values.push_back(a[i++]);
+                else if(b[j] < a[i])
+                {
+                    if(op != ANDNOT)
+                        r.values.push_back(b[j]);
+                    ++j;
+                }
+                else
+                {
+                    if(op == OR)
+                        r.values.push_back(a[i]);
+                    ++i;
+                    ++j;
+                }
+            }
+            for(;i < na;i++)
+                r.values.push_back(a[i]);
+            if(op != ANDNOT)
+                for(;j < nb;j++)
+                    r.values.push_back(b[j]);
+        }
+
+        r.card = r.values.size();
+        if(r.card > ROARING_ARRAY_MAX)
+            to_bitmap(r);
+        return r;
+    }
+
+    //一个数组容器和一个位图容器
+    const roaring_container& arr = x.type == roaring_container::ARRAY ? x : y;
+    const roaring_container& bmp = x.type == roaring_container::ARRAY ? y : x;
+
+    if(op == AND || (op == ANDNOT && &arr == &x))
+    {
+        //结果是数组中的一部分
+        const bool keep_in = op == AND;
+        for(size_t i = 0;i < arr.values.size();i++)
+            if(bmp.test_bit(arr.values[i]) == keep_in)
+                r.values.push_back(arr.values[i]);
+        r.card = r.values.size();
+        return r;
+    }
+
+    //在位图上修改数组中的值
+    r.type = roaring_container::BITMAP;
+    r.words = bmp.words;
+    r.card = bmp.card;
+    for(size_t i = 0;i < arr.values.size();i++)
+    {
+        const unsigned v = arr.values[i];
+        const bool was = r.test_bit(v);
+        if(op == OR)
+        {
+            if(!was)
+            {
+                r.set_bit(v);
+                ++r.card;
+            }
+        }
+        else if(op == XOR)
+        {
+            if(was)
+            {
+                r.clear_bit(v);
+                --r.card;
+            }
+            else
+            {
+                r.set_bit(v);
+                ++r.card;
+            }
+        }
+        else if(was)
+        {
+            //位图减去数组
+            r.clear_bit(v);
+            --r.card;
+        }
+    }
+    shrink(r);
+    return r;
+}
+
+inline roaring_bitmap roaring_bitmap::binary_op(const roaring_bitmap& x,const roaring_bitmap& y,
+                                                op_type op)
+{
+    roaring_bitmap result;
+    const vector<roaring_container>& a = x.m_containers;
+    const vector<roaring_container>& b = y.m_containers;
+    size_t i = 0,j = 0;
+    //容器较大，预先分配避免扩容时复制
+    result.m_containers.reserve(op == AND ? (a.size() < b.size() ? a.size() : b.size())
+                                          : (op == ANDNOT ? a.size() : a.size() + b.size()));
+
+    while(i < a.size() && j < b.size())
+    {
+        if(a[i].key < b[j].key)
+        {
+            if(op != AND)
+                result.m_containers.push_back(a[i]);
+            ++i;
+        }
+        else if(b[j].key < a[i].key)
+        {
+            if(op == OR || op == XOR)
+                result.m_containers.push_back(b[j]);
+            ++j;
+        }
+        else
+        {
+            roaring_container c = container_op(a[i],b[j],op);
+            if(c.card != 0)
+                result.m_containers.push_back(STL_MOVE(c));
+            ++i;
+            ++j;
+        }
+    }
+    if(op != AND)
+        for(;i < a.size();i++)
+            result.m_containers.push_back(a[i]);
+    if(op == OR || op == XOR)
+        for(;j < b.size();j++)
+            result.m_containers.push_back(b[j]);
+    return result;
+}
+
+inline bool roaring_bitmap::run_optimize()
+{
+    bool changed = false;
+    for(size_t ci = 0;ci < m_containers.size();ci++)
+    {
+        roaring_container& c = m_containers[ci];
+        if(c.type == roaring_container::RUN)
+            continue;
+
+        //统计行程个数：每个行程的起点是前一位为0的1
+        size_t runs = 0;
+        if(c.type == roaring_container::ARRAY)
+        {
+            for(size_t i = 0;i < c.values.size();i++)
+                if(i == 0 || c.values[i] != c.values[i - 1] + 1)
+                    ++runs;
+        }
+        else
+        {
+            unsigned long carry = 0;
+            for(size_t i = 0;i < ROARING_CHUNK_WORDS;i++)
+            {
+                const unsigned long w = c.words[i];
+                runs += __popcount_word(w & ~((w << 1) | carry));
+                carry = w >> (BITS_PER_WORD - 1);
+            }
+        }
+
+        //按占用的字节比较
+        const size_t run_bytes = runs * 4;
+        const size_t cur_bytes = c.type == roaring_container::ARRAY ? c.card * 2
+                                                                     : ROARING_CHUNK_BITS / 8;
+        if(run_bytes >= cur_bytes)
+            continue;
+
+        vector<unsigned short> pairs;
+        pairs.reserve(runs * 2);
+        unsigned start = 0,prev = 0;
+        bool open = false;
+        for(const_iterator it(this,ci);it.m_ci == ci;++it)
+        {
+            const unsigned low = *it & 0xFFFF;
+            if(open && low == prev + 1)
+            {
+                prev = low;
+                continue;
+            }
+            if(open)
+            {
+                pairs.push_back((unsigned short)start);
+                pairs.push_back((unsigned short)(prev - start));
+            }
+            start = prev = low;
+            open = true;
+        }
+        pairs.push_back((unsigned short)start);
+        pairs.push_back((unsigned short)(prev - start));
+
+        c.values.swap(pairs);
+        vector<unsigned long>().swap(c.words);
+        c.type = roaring_container::RUN;
+        changed = true;
+    }
+    return changed;
+}
+
+
+//////////////////////////////////////////////
+//序列化
+inline void __roaring_put16(char*& p,unsigned v)
+{
+    p[0] = (char)(v & 0xFF);
+    p[1] = (char)((v >> 8) & 0xFF);
+    p += 2;
+}
+
+inline void __roaring_put32(char*& p,unsigned long v)
+{
+    __roaring_put16(p,(unsigned)(v & 0xFFFF));
+    __roaring_put16(p,(unsigned)((v >> 16) & 0xFFFF));
+}
+
+inline unsigned __roaring_get16(const char*& p)
+{
+    const unsigned v = (unsigned char)p[0] | ((unsigned)(unsigned char)p[1] << 8);
+    p += 2;
+    return v;
+}
+
+inline unsigned long __roaring_get32(const char*& p)
+{
+    const unsigned long lo = __roaring_get16(p);
+    return lo | ((unsigned long)__roaring_get16(p) << 16);
+}
+
+inline roaring_bitmap::size_type roaring_bitmap::serialized_size() const
+{
+    size_type n = 4;
+    for(size_t i = 0;i < m_containers.size();i++)
+    {
+        const roaring_container& c = m_containers[i];
+        n += 7;
+        if(c.type == roaring_container::BITMAP)
+            n += ROARING_CHUNK_BITS / 8;
+        else
+            n += c.values.size() * 2;
+    }
+    return n;
+}
+
+inline roaring_bitmap::size_type roaring_bitmap::serialize(char* out) const
+{
+    char* p = out;
+    __roaring_put32(p,m_containers.size());
+    for(size_t i = 0;i < m_containers.size();i++)
+    {
+        const roaring_container& c = m_containers[i];
+        __roaring_put16(p,c.key);
+        *p++ = (char)c.type;
+        if(c.type == roaring_container::BITMAP)
+        {
+            __roaring_put32(p,c.card);
+            //按字节从低位到高位写出，与word的大小和字节序无关
+            for(size_t b = 0;b < ROARING_CHUNK_BITS / 8;b++)
+                *p++ = (char)((c.words[b / sizeof(unsigned long)]
+                               >> ((b % sizeof(unsigned long)) * 8)) & 0xFF);
+        }
+        else
+        {
+            __roaring_put32(p,c.type == roaring_container::ARRAY ? c.values.size()
+                                                                  : c.num_runs());
+            for(size_t v = 0;v < c.values.size();v++)
+                __roaring_put16(p,c.values[v]);
+        }
+    }
+    return p - out;
+}
+
+inline roaring_bitmap roaring_bitmap::deserialize(const char* in,size_type n)
+{
+    const char* p = in;
+    const char* end = in + n;
+    roaring_bitmap result;
+
+    if(n < 4)
+        STL_THROW(invalid_argument("roaring_bitmap"));
+    const unsigned long count = __roaring_get32(p);
+
+    for(unsigned long i = 0;i < count;i++)
+    {
+        if(end - p < 7)
+            STL_THROW(invalid_argument("roaring_bitmap"));
+
+        roaring_container c((unsigned short)__roaring_get16(p));
+        c.type = (unsigned char)*p++;
+        const unsigned long m = __roaring_get32(p);
+        if((!result.m_containers.empty() && result.m_containers.back().key >= c.key)
+           || c.type > roaring_container::RUN)
+            STL_THROW(invalid_argument("roaring_bitmap"));
+
+        if(c.type == roaring_container::BITMAP)
+        {
+            if((size_t)(end - p) < ROARING_CHUNK_BITS / 8)
+                STL_THROW(invalid_argument("roaring_bitmap"));
+            c.words.resize(ROARING_CHUNK_WORDS,0UL);
+            for(size_t b = 0;b < ROARING_CHUNK_BITS / 8;b++)
+                c.words[b / sizeof(unsigned long)] |=
+                    (unsigned long)(unsigned char)*p++ << ((b % sizeof(unsigned long)) * 8);
+            c.card = __bits_count(c.words.begin(),(size_t)ROARING_CHUNK_WORDS);
+            //不超过ROARING_ARRAY_MAX个值时应该是数组容器
+            if(c.card != m || c.card <= ROARING_ARRAY_MAX)
+                STL_THROW(invalid_argument("roaring_bitmap"));
+        }
+        else
+        {
+            const size_t nvalues = c.type == roaring_container::ARRAY ? m : 2 * m;
+            if(m > ROARING_CHUNK_BITS || (size_t)(end - p) < nvalues * 2)
+                STL_THROW(invalid_argument("roaring_bitmap"));
+            //超过ROARING_ARRAY_MAX个值时应该是位图容器
+            if(c.type == roaring_container::ARRAY && m > ROARING_ARRAY_MAX)
+                STL_THROW(invalid_argument("roaring_bitmap"));
+            c.values.reserve(nvalues);
+            for(size_t v = 0;v < nvalues;v++)
+                c.values.push_back((unsigned short)__roaring_get16(p));
+
+            if(c.type == roaring_container::ARRAY)
+            {
+                for(size_t v = 1;v < nvalues;v++)
+                    if(c.values[v - 1] >= c.values[v])
+                        STL_THROW(invalid_argument("roaring_bitmap"));
+                c.card = nvalues;
+            }
+            else
+            {
+                //行程必须有序且不重叠
+                unsigned long next = 0;
+                for(size_t r = 0;r < m;r++)
+                {
+                    const unsigned long s = c.values[2 * r];
+                    const unsigned long e = s + c.values[2 * r + 1];
+                    if(s < next || e >= ROARING_CHUNK_BITS)
+                        STL_THROW(invalid_argument("roaring_bitmap"));
+                    c.card += e - s + 1;
+                    next = e + 1;
+                }
+            }
+        }
+
+        if(c.card == 0)
+            STL_THROW(invalid_argument("roaring_bitmap"));
+        result.m_containers.push_back(STL_MOVE(c));
+    }
+    return result;
+}
+
+inline void swap(roaring_bitmap& x,roaring_bitmap& y)
+{
+    x.swap(y);
+}
+
+STL_END_NAMESPACE
+
+#endif // ROARING_IMP_H
@@ -0,0 +1,361 @@
+//searcher_imp.h
+//子串查找器：在[first,last)中查找模式串第一次出现的位置，没有找到返回last
+//1.memchr_searcher：先定位模式串的第一个字符，再比较其余字符，适合短模式串
+//2.horspool_searcher：Boyer-Moore-Horspool，按坏字符表跳跃，适合中等长度的模式串
+//3.two_way_searcher：Two-Way算法，最坏情况线性时间，常数空间，适合长模式串
+//查找器只要求随机访问迭代器，使用reverse_iterator即可从后向前查找
+
+#ifndef SEARCHER_IMP_H
+#define SEARCHER_IMP_H
+
+#include "configure.h"
+#include "iterator_imp.h"
+#include <string.h>
+
+STL_BEGIN_NAMESPACE
+
+enum {SEARCH_SHORT_NEEDLE = 4};         //短于这个长度使用memchr_searcher
+enum {SEARCH_HORSPOOL_NEEDLE = 32};     //不超过这个长度使用horspool_searcher
+enum {SEARCH_SHORT_HAYSTACK = 64};      //被查找的区间很短时直接使用memchr_searcher
+
+//在[first,last)中查找字符c，字节类型的指针使用memchr
+template<class RandomAccessIter,class Tp>
+inline RandomAccessIter __find_char(RandomAccessIter first,RandomAccessIter last,
+                                    const Tp& c)
+{
+    while(first != last && !(*first == c))
+        ++first;
+    return first;
+}
+
+inline const char* __find_char(const char* first,const char* last,const char& c)
+{
+    const void* p = first != last ? memchr(first,(unsigned char)c,last - first) : 0;
+    return p != 0 ? (const char*)p : last;
+}
+
+inline const unsigned char* __find_char(const unsigned char* first,
+                                        const unsigned char* last,
+                                        const unsigned char& c)
+{
+    const void* p = first != last ? memchr(first,c,last - first) : 0;
+    return p != 0 ? (const unsigned char*)p : last;
+}
+
+//坏字符表的下标，宽字符取低8位。
+//不同字符共用一项时表中保存较小的跳跃距离，结果仍然正确
+template<class Tp>
+inline unsigned char __search_bucket(const Tp& c)
+{
+    return (unsigned char)c;
+}
+
+//坏字符表：窗口最后一个字符为c时可以安全跳过的距离。
+//模式串最后一个字符不参与，否则跳跃距离为0
+template<class RandomAccessIter,class Distance>
+void __build_skip_table(RandomAccessIter pat,Distance len,Distance* skip)
+{
+    for(int i = 0;i < 256;i++)
+        skip[i] = len;
+    for(Distance i = 0;i + 1 < len;i++)
+        skip[__search_bucket(pat[i])] = len - 1 - i;
+}
+
+
+///////////////////////////
+//定位第一个字符，再比较其余字符
+template<class RandomAccessIter>
+class memchr_searcher
+{
+public:
+    typedef typename iterator_traits<RandomAccessIter>::difference_type difference_type;
+    typedef typename iterator_traits<RandomAccessIter>::value_type value_type;
+
+    memchr_searcher(RandomAccessIter pat_first,RandomAccessIter pat_last)
+        : m_pat(pat_first),m_len(pat_last - pat_first)
+    {}
+
+    RandomAccessIter operator()(RandomAccessIter first,RandomAccessIter last) const
+    {
+        if(m_len == 0)
+            return first;
+        if(last - first < m_len)
+            return last;
+
+        //匹配只能从[first,stop)开始
+        const RandomAccessIter stop = last - (m_len - 1);
+        const value_type c = m_pat[0];
+        for(;;)
+        {
+            first = __find_char(first,stop,c);
+            if(first == stop)
+                return last;
+
+            difference_type i = 1;
+            while(i < m_len && first[i] == m_pat[i])
+                ++i;
+            if(i == m_len)
+                return first;
+            ++first;
+        }
+    }
+
+private:
+    RandomAccessIter m_pat;
+    difference_type m_len;
+};
+
+
+///////////////////////////
+//Boyer-Moore-Horspool
+//用窗口最后一个字符查表，跳过不可能匹配的位置
+template<class RandomAccessIter>
+class horspool_searcher
+{
+public:
+    typedef typename iterator_traits<RandomAccessIter>::difference_type difference_type;
+    typedef typename iterator_traits<RandomAccessIter>::value_type value_type;
+
+    horspool_searcher(RandomAccessIter pat_first,RandomAccessIter pat_last)
+        : m_pat(pat_first),m_len(pat_last - pat_first)
+    {
+        __build_skip_table(m_pat,m_len,m_skip);
+    }
+
+    RandomAccessIter operator()(RandomAccessIter first,RandomAccessIter last) const
+    {
+        if(m_len == 0)
+            return first;
+
+        const difference_type limit = (last - first) - m_len;
+        const value_type last_char = m_pat[m_len - 1];
+
+        for(difference_type pos = 0;pos <= limit;)
+        {
+            const value_type c = first[pos + m_len - 1];
+            if(c == last_char)
+            {
+                difference_type i = 0;
+                while(i < m_len - 1 && first[pos + i] == m_pat[i])
+                    ++i;
+                if(i == m_len - 1)
+                    return first + pos;
+            }
+            pos += m_skip[__search_bucket(c)];
+        }
+        return last;
+    }
+
+private:
+    RandomAccessIter m_pat;
+    difference_type m_len;
+    difference_type m_skip[256];
+};
+
+
+///////////////////////////
+//Two-Way（Crochemore-Perrin）
+//把模式串在临界位置分成左右两部分，先从左向右比较右半部分，再从右向左比较左半部分。
+//模式串是周期串时记住已经匹配的前缀，每个字符最多比较常数次，最坏情况O(n+m)。
+//比较之前先用坏字符表跳跃，随机文本中平均比较次数与Horspool相当
+template<class RandomAccessIter>
+class two_way_searcher
+{
+public:
+    typedef typename iterator_traits<RandomAccessIter>::difference_type difference_type;
+    typedef typename iterator_traits<RandomAccessIter>::value_type value_type;
+
+    two_way_searcher(RandomAccessIter pat_first,RandomAccessIter pat_last)
+        : m_pat(pat_first),m_len(pat_last - pat_first),m_ell(-1),m_period(1),
+          m_periodic(false)
+    {
+        if(m_len == 0)
+            return;
+
+        //临界分解：两种字母序下的最大后缀中位置靠后的一个
+        difference_type p1,p2;
+        const difference_type s1 = maximal_suffix(false,p1);
+        const difference_type s2 = maximal_suffix(true,p2);
+        if(s1 > s2)
+        {
+            m_ell = s1;
+            m_period = p1;
+        }
+        else
+        {
+            m_ell = s2;
+            m_period = p2;
+        }
+
+        //左半部分是否也以m_period为周期
+        m_periodic = true;
+        for(difference_type i = 0;i <= m_ell;i++)
+        {
+            if(!(m_pat[i] == m_pat[i + m_period]))
+            {
+                m_periodic = false;
+                break;
+            }
+        }
+
+        if(!m_periodic)
+            m_period = max_diff(m_ell + 1,m_len - m_ell - 1) + 1;
+
+        //窗口最后一个字符与模式串最后一个字符相同时跳跃距离为0，进入Two-Way比较
+        __build_skip_table(m_pat,m_len,m_skip);
+        m_skip[__search_bucket(m_pat[m_len - 1])] = 0;
+    }
+
+    RandomAccessIter operator()(RandomAccessIter first,RandomAccessIter last) const
+    {
+        if(m_len == 0)
+            return first;
+
+        const difference_type limit = (last - first) - m_len;
+        difference_type pos = 0;
+
+        if(m_periodic)
+        {
+            //memory之前的字符在上一次比较中已经匹配
+            difference_type memory = -1;
+            while(pos <= limit)
+            {
+                const difference_type shift =
+                    m_skip[__search_bucket(first[pos + m_len - 1])];
+                if(shift > 0)
+                {
+                    memory = -1;
+                    pos += shift;
+                    continue;
+                }
+
+                difference_type i = max_diff(m_ell,memory) + 1;
+                while(i < m_len && m_pat[i] == first[pos + i])
+                    ++i;
+
+                if(i >= m_len)
+                {
+                    i = m_ell;
+                    while(i > memory && m_pat[i] == first[pos + i])
+                        --i;
+                    if(i <= memory)
+                        return first + pos;
+                    pos += m_period;
+                    memory = m_len - m_period - 1;
+                }
+                else
+                {
+                    pos += i - m_ell;
+                    memory = -1;
+                }
+            }
+        }
+        else
+        {
+            while(pos <= limit)
+            {
+                const difference_type shift =
+                    m_skip[__search_bucket(first[pos + m_len - 1])];
+                if(shift > 0)
+                {
+                    pos += shift;
+                    continue;
+                }
+
+                difference_type i = m_ell + 1;
+                while(i < m_len && m_pat[i] == first[pos + i])
+                    ++i;
+
+                if(i >= m_len)
+                {
+                    i = m_ell;
+                    while(i >= 0 && m_pat[i] == first[pos + i])
+                        --i;
+                    if(i < 0)
+                        return first + pos;
+                    pos += m_period;
+                }
+                else
+                {
+                    pos += i - m_ell;
+                }
+            }
+        }
+        return last;
+    }
+
+private:
+    RandomAccessIter m_pat;
+    difference_type m_len;
+    difference_type m_ell;      //临界位置，左半部分为[0,m_ell]
+    difference_type m_period;
+    bool m_periodic;
+    difference_type m_skip[256];
+
+    static difference_type max_diff(difference_type a,difference_type b)
+    {
+        return a < b ? b : a;
+    }
+
+    //最大后缀的起始位置减一，period返回它的周期。
+    //reversed为true时使用相反的字母序
+    difference_type maximal_suffix(bool reversed,difference_type& period) const
+    {
+        difference_type ms = -1;
+        difference_type j = 0;
+        difference_type k = 1;
+        period = 1;
+
+        while(j + k < m_len)
+        {
+            const value_type a = m_pat[j + k];
+            const value_type b = m_pat[ms + k];
+            if(reversed ? (b < a) : (a < b))
+            {
+                j += k;
+                k = 1;
+                period = j - ms;
+            }
+            else if(a == b)
+            {
+                if(k != period)
+                {
+                    ++k;
+                }
+                else
+                {
+                    j += period;
+                    k = 1;
+                }
+            }
+            else
+            {
+                ms = j;
+                j = ms + 1;
+                k = period = 1;
+            }
+        }
+        return ms;
+    }
+};
+
+
+//按模式串和被查找区间的长度选择查找器
+template<class RandomAccessIter>
+RandomAccessIter search_auto(RandomAccessIter first,RandomAccessIter last,
+                             RandomAccessIter pat_first,RandomAccessIter pat_last)
+{
+    const typename iterator_traits<RandomAccessIter>::difference_type
+        m = pat_last - pat_first;
+
+    if(m < SEARCH_SHORT_NEEDLE || last - first < SEARCH_SHORT_HAYSTACK)
+        return memchr_searcher<RandomAccessIter>(pat_first,pat_last)(first,last);
+    else if(m <= SEARCH_HORSPOOL_NEEDLE)
+        return horspool_searcher<RandomAccessIter>(pat_first,pat_last)(first,last);
+    else
+        return two_way_searcher<RandomAccessIter>(pat_first,pat_last)(first,last);
+}
+
+STL_END_NAMESPACE
+
+#endif // SEARCHER_IMP_H
@@ -0,0 +1,427 @@
+//small_vector_imp.h
+//small_vector<Tp,N,Alloc>：前N个元素保存在对象内部的缓冲区，超过N个时才通过Alloc申请堆空间。
+//接口、插入删除和扩容的算法都来自vector：
+//vector使用inline_buffer_alloc作为分配器，这个分配器记住内部缓冲区的地址，
+//申请的空间总是来自Alloc，释放内部缓冲区时什么也不做。
+//构造时把vector的三个指针指向内部缓冲区，容量为N；扩容搬移完元素后"释放"内部缓冲区即可。
+//指针指向对象内部，所以交换和移动需要区分内部缓冲区和堆空间，由small_vector自己实现。
+//static_vector<Tp,N>：Alloc为fixed_capacity_alloc的small_vector，从不申请内存，超过N个元素时抛出length_error
+
+#ifndef SMALL_VECTOR_IMP_H
+#define SMALL_VECTOR_IMP_H
+
+#include "configure.h"
+#include "vector_imp.h"
+
+STL_BEGIN_NAMESPACE
+
+//按基本类型最严格的对齐方式对齐的Size字节缓冲区
+template<size_t Size>
+union __aligned_buffer
+{
+    char m_bytes[Size > 0 ? Size : 1];
+    long double m_align_ld;
+    long long m_align_ll;
+    void* m_align_p;
+};
+
+////////////////////////////////////
+//带内部缓冲区的分配器
+//m_buffer为容器内部缓冲区的地址，不由这个分配器申请，deallocate和reallocate遇到它时不交给Alloc。
+//赋值只复制Alloc部分：容器交换分配器时各自的缓冲区地址不变
+template<class Alloc>
+class inline_buffer_alloc : private Alloc
+{
+public:
+    inline_buffer_alloc(void* buffer,const Alloc& a = Alloc())
+        : Alloc(a),m_buffer(buffer) {}
+
+    inline_buffer_alloc(const inline_buffer_alloc& x)
+        : Alloc(x),m_buffer(x.m_buffer) {}
+
+    inline_buffer_alloc& operator=(const inline_buffer_alloc& x)
+    {
+        static_cast<Alloc&>(*this) = static_cast<const Alloc&>(x);
+        return *this;
+    }
+
+    const Alloc& upstream() const
+    {
+        return *this;
+    }
+
+    void* allocate(size_t n)
+    {
+        return Alloc::allocate(n);
+    }
+
+    void deallocate(void* p,size_t n)
+    {
+        if(p != m_buffer)
+            Alloc::deallocate(p,n);
+    }
+
+    //只在alloc_traits<Alloc>::has_reallocate为真时使用；
+    //从内部缓冲区扩充时没有可以原地扩充的堆空间，申请之后复制
+    void* reallocate(void* p,size_t old_sz,size_t new_sz)
+    {
+        if(p != m_buffer)
+            return Alloc::reallocate(p,old_sz,new_sz);
+        void* result = Alloc::allocate(new_sz);
+        memcpy(result,p,old_sz < new_sz ? old_sz : new_sz);
+        return result;
+    }
+
+private:
+    void* m_buffer;
+};
+
+template<class Alloc>
+struct alloc_traits<inline_buffer_alloc<Alloc> >
+{
+    typedef typename alloc_traits<Alloc>::has_reallocate has_reallocate;
+
+    static size_t good_size(size_t n)
+    {
+        return alloc_traits<Alloc>::good_size(n);
+    }
+};
+
+//small_vector的内部缓冲区，作为第一个基类在vector之前构造、之后析构
+template<class Tp,size_t N>
+class __small_vector_storage
+{
+protected:
+    Tp* buffer()
+    {
+        return (Tp*)m_buffer.m_bytes;
+    }
+
+    const Tp* buffer() const
+    {
+        return (const Tp*)m_buffer.m_bytes;
+    }
+
+private:
+    __aligned_buffer<N * sizeof(Tp)> m_buffer;
+};
+
+
+////////////////////////////////////
+//small_vector类实现
+template<class Tp,size_t N,class Alloc = STL_DEFAULT_ALLOCATOR(Tp),class Growth = growth_double>
+class small_vector : protected __small_vector_storage<Tp,N>,
+                     protected vector<Tp,inline_buffer_alloc<Alloc>,Growth>
+{
+private:
+    typedef __small_vector_storage<Tp,N> Storage;
+    typedef inline_buffer_alloc<Alloc> buffer_alloc;
+    typedef vector<Tp,buffer_alloc,Growth> Base;
+
+    using Storage::buffer;
+    using Base::start;
+    using Base::finish;
+    using Base::end_of_storage;
+
+public:
+    typedef typename Base::value_type value_type;
+    typedef typename Base::pointer pointer;
+    typedef typename Base::const_pointer const_pointer;
+    typedef typename Base::iterator iterator;
+    typedef typename Base::const_iterator const_iterator;
+    typedef typename Base::reference reference;
+    typedef typename Base::const_reference const_reference;
+    typedef typename Base::size_type size_type;
+    typedef typename Base::difference_type difference_type;
+    typedef typename Base::reverse_iterator reverse_iterator;
+    typedef typename Base::const_reverse_iterator const_reverse_iterator;
+    typedef Alloc allocator_type;
+
+    //内部缓冲区的容量
+    enum {inline_capacity = N};
+
+    allocator_type get_allocator() const
+    {
+        return Base::get_allocator().upstream();
+    }
+
+    //vector的接口
+    using Base::begin;
+    using Base::end;
+    using Base::rbegin;
+    using Base::rend;
+    using Base::size;
+    using Base::max_size;
+    using Base::capacity;
+    using Base::empty;
+    using Base::operator[];
+    using Base::reserve;
+    using Base::assign;
+    using Base::front;
+    using Base::back;
+    using Base::push_back;
+    using Base::insert;
+    using Base::fill_insert;
+    using Base::pop_back;
+    using Base::erase;
+    using Base::resize;
+    using Base::resize_default_init;
+    using Base::append_uninitialized;
+    using Base::commit;
+    using Base::clear;
+#ifdef STL_CXX11
+    using Base::emplace_back;
+    using Base::emplace;
+#endif
+
+public:
+    explicit small_vector(const allocator_type& a = allocator_type())
+        : Base(buffer_alloc(buffer(),a))
+    {
+        reset_to_buffer();
+    }
+
+    small_vector(size_type n,const Tp& value,const allocator_type& a = allocator_type())
+        : Base(buffer_alloc(buffer(),a))
+    {
+        reset_to_buffer();
+        fill_insert(end(),n,value);
+    }
+
+    explicit small_vector(size_type n)
+        : Base(buffer_alloc(buffer(),allocator_type()))
+    {
+        reset_to_buffer();
+        fill_insert(end(),n,Tp());
+    }
+
+    //两个参数都是整数时与small_vector(n,value)相同，由insert分派
+    template<class InputIter>
+    small_vector(InputIter first,InputIter last,const allocator_type& a = allocator_type())
+        : Base(buffer_alloc(buffer(),a))
+    {
+        reset_to_buffer();
+        insert(end(),first,last);
+    }
+
+    small_vector(const small_vector& x)
+        : Storage(),Base(buffer_alloc(buffer(),x.get_allocator()))
+    {
+        reset_to_buffer();
+        insert(end(),x.begin(),x.end());
+    }
+
+#ifdef STL_CXX11
+    //x在堆上时接管x的空间，否则逐个移动元素；x变为空
+    small_vector(small_vector&& x)
+        : Storage(),Base(buffer_alloc(buffer(),x.get_allocator()))
+    {
+        reset_to_buffer();
+        take(x);
+    }
+#endif
+
+    small_vector& operator=(const small_vector& x)
+    {
+        Base::operator=(x);
+        return *this;
+    }
+
+#ifdef STL_CXX11
+    small_vector& operator=(small_vector&& x)
+    {
+        if(&x != this)
+        {
+            clear();
+            release_heap();
+            take(x);
+        }
+        return *this;
+    }
+#endif
+
+    //元素是否保存在内部缓冲区
+    bool is_inline() const
+    {
+        return start == buffer();
+    }
+
+    //两边都在堆上时交换指针；有一边在内部缓冲区时需要移动元素
+    void swap(small_vector& x);
+
+private:
+    void reset_to_buffer()
+    {
+        start = buffer();
+        finish = start;
+        end_of_storage = start + N;
+    }
+
+    //释放堆空间，回到内部缓冲区，调用前元素已经析构
+    void release_heap()
+    {
+        if(!is_inline())
+        {
+            this->deallocate(start,capacity());
+            reset_to_buffer();
+        }
+    }
+
+    //接管x的元素，调用前*this为空并且使用内部缓冲区
+    void take(small_vector& x)
+    {
+        if(x.is_inline())
+        {
+            finish = uninitialized_move(x.start,x.finish,start);
+            x.clear();
+        }
+        else
+        {
+            this->swap_allocator(x);
+            start = x.start;
+            finish = x.finish;
+            end_of_storage = x.end_of_storage;
+            x.reset_to_buffer();
+        }
+    }
+
+    //x在内部缓冲区，y在堆上：x的元素移动到y的内部缓冲区，x接管y的堆空间
+    static void swap_inline_heap(small_vector& x,small_vector& y);
+};
+
+template<class Tp,size_t N,class Alloc,class Growth>
+void small_vector<Tp,N,Alloc,Growth>::swap(small_vector& x)
+{
+    if(&x == this)
+        return;
+
+    if(!is_inline() && !x.is_inline())
+    {
+        Base::swap(x);
+    }
+    else if(is_inline() && !x.is_inline())
+    {
+        swap_inline_heap(*this,x);
+    }
+    else if(!is_inline() && x.is_inline())
+    {
+        swap_inline_heap(x,*this);
+    }
+    else
+    {
+        //都在内部缓冲区：交换公共部分，较长一方多出的元素移动到较短一方
+        small_vector& shorter = size() < x.size() ? *this : x;
+        small_vector& longer = size() < x.size() ? x : *this;
+        const size_type n = shorter.size();
+        for(size_type i = 0;i < n;i++)
+            std::swap(shorter.start[i],longer.start[i]);
+        shorter.finish = uninitialized_move(longer.start + n,longer.finish,shorter.finish);
+        destroy(longer.start + n,longer.finish);
+        longer.finish = longer.start + n;
+        this->swap_allocator(x);
+    }
+}
+
+template<class Tp,size_t N,class Alloc,class Growth>
+void small_vector<Tp,N,Alloc,Growth>::swap_inline_heap(small_vector& x,small_vector& y)
+{
+    Tp* heap_start = y.start;
+    Tp* heap_finish = y.finish;
+    Tp* heap_end = y.end_of_storage;
+
+    y.reset_to_buffer();
+    STL_TRY
+    {
+        y.finish = uninitialized_move(x.start,x.finish,y.start);
+    }
+    STL_UNWIND((y.start = heap_start,y.finish = heap_finish,y.end_of_storage = heap_end));
+
+    destroy(x.start,x.finish);
+    x.start = heap_start;
+    x.finish = heap_finish;
+    x.end_of_storage = heap_end;
+    x.swap_allocator(y);
+}
+
+template<class Tp,size_t N,class Alloc,class Growth>
+inline void swap(small_vector<Tp,N,Alloc,Growth>& x,small_vector<Tp,N,Alloc,Growth>& y)
+{
+    x.swap(y);
+}
+
+template<class Tp,size_t N,class Alloc,class Growth>
+inline bool operator==(const small_vector<Tp,N,Alloc,Growth>& x,
+                       const small_vector<Tp,N,Alloc,Growth>& y)
+{
+    return x.size() == y.size() && equal(x.begin(),x.end(),y.begin());
+}
+
+template<class Tp,size_t N,class Alloc,class Growth>
+inline bool operator<(const small_vector<Tp,N,Alloc,Growth>& x,
+                      const small_vector<Tp,N,Alloc,Growth>& y)
+{
+    return lexicographical_compare(x.begin(),x.end(),y.begin(),y.end());
+}
+
+template<class Tp,size_t N,class Alloc,class Growth>
+inline bool operator!=(const small_vector<Tp,N,Alloc,Growth>& x,
+                       const small_vector<Tp,N,Alloc,Growth>& y)
+{
+    return !(x == y);
+}
+
+template<class Tp,size_t N,class Alloc,class Growth>
+inline bool operator>(const small_vector<Tp,N,Alloc,Growth>& x,
+                      const small_vector<Tp,N,Alloc,Growth>& y)
+{
+    return y < x;
+}
+
+template<class Tp,size_t N,class Alloc,class Growth>
+inline bool operator<=(const small_vector<Tp,N,Alloc,Growth>& x,
+                       const small_vector<Tp,N,Alloc,Growth>& y)
+{
+    return !(y < x);
+}
+
+template<class Tp,size_t N,class Alloc,class Growth>
+inline bool operator>=(const small_vector<Tp,N,Alloc,Growth>& x,
+                       const small_vector<Tp,N,Alloc,Growth>& y)
+{
+    return !(x < y);
+}
+
+
+////////////////////////////////////
+//static_vector类实现
+//扩容时向fixed_capacity_alloc申请内存会抛出异常，此时容器没有被修改
+template<class Tp,size_t N>
+class static_vector : public small_vector<Tp,N,fixed_capacity_alloc<N> >
+{
+private:
+    typedef small_vector<Tp,N,fixed_capacity_alloc<N> > Base;
+
+public:
+    typedef typename Base::size_type size_type;
+
+    static_vector() {}
+
+    static_vector(size_type n,const Tp& value)
+        : Base(n,value) {}
+
+    explicit static_vector(size_type n)
+        : Base(n) {}
+
+    template<class InputIter>
+    static_vector(InputIter first,InputIter last)
+        : Base(first,last) {}
+
+    size_type max_size() const
+    {
+        return N;
+    }
+};
+
+STL_END_NAMESPACE
+
+#endif // SMALL_VECTOR_IMP_H
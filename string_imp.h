@@ -4,37 +4,100 @@
 #define STRING_IMP_H
 
 #include "configure.h"
+#include "type_traits.h"
 #include "alloc_imp.h"
 #include "construct.h"
 #include "uninitialized.h"
 #include "algobase.h"
 #include "algo.h"
+#include "iterator_imp.h"
+#include "growth_policy.h"
+#include "searcher_imp.h"
+#include "char_scan.h"
+#include "char_set_imp.h"
 #include <string.h>
 
 STL_BEGIN_NAMESPACE
 
+//对象内部能保存的字符个数，不包括结尾的空字符，char为15个
+template<class Tp,class Alloc>
+struct __string_local_capacity
+{
+    enum {value = (16 / sizeof(Tp) > 1 ? 16 / sizeof(Tp) : 2) - 1};
+};
+
+//fixed_string：N个字符全部保存在对象内部，从不申请内存
+template<class Tp,size_t N>
+struct __string_local_capacity<Tp,fixed_capacity_alloc<N> >
+{
+    enum {value = N};
+};
+
+//char_set只能处理单字节字符，其它字符类型的find_*_of逐个比较
+template<class CharT>
+struct __use_char_set
+{
+    typedef __false_type type;
+};
+
+STL_TEMPLATE_NULL
+struct __use_char_set<char>
+{
+    typedef __true_type type;
+};
+
 //////////////////////////////////////////
 ///string内存管理接口
-///
+///短字符串优化：不超过LOCAL_CAPACITY个字符时，字符保存在对象内部的local_buf中，
+///不申请堆内存。此时start指向local_buf，local_buf与end_of_storage共用空间，
+///只有堆模式下end_of_storage才有效，容量由storage_end()计算。
 template<class Tp,class Alloc>
-class string_base
+class string_base : protected alloc_holder<Tp,Alloc>
 {
+protected:
+    //分配器成员
+    typedef alloc_holder<Tp,Alloc> alloc_type;
+
 public:
     //内存分配器接口
     typedef Alloc allocator_type;
     allocator_type get_allocator() const
     {
-        return allocator_type();
+        return alloc_type::get_allocator();
     }
 
 protected:
-    //分配器成员
-    typedef simple_alloc<Tp,Alloc> alloc_type;
+
+    //对象内部能保存的字符个数，不包括结尾的空字符
+    enum {LOCAL_CAPACITY = __string_local_capacity<Tp,Alloc>::value};
 
     //内存指针
     Tp *start;
     Tp *finish;
-    Tp *end_of_storage;
+    union
+    {
+        Tp *end_of_storage;                 //堆模式：存储空间的结束位置
+        Tp local_buf[LOCAL_CAPACITY + 1];   //局部模式：字符和结尾的空字符
+    };
+
+    //字符是否保存在对象内部
+    bool is_local() const
+    {
+        return start == local_buf;
+    }
+
+    //存储空间的结束位置
+    Tp* storage_end() const
+    {
+        return is_local() ? (Tp*)local_buf + LOCAL_CAPACITY + 1 : end_of_storage;
+    }
+
+    //设置为空的局部模式，不写入结尾的空字符
+    void set_local()
+    {
+        start = local_buf;
+        finish = local_buf;
+    }
 
     //分配n个元素空间
     Tp *allocate(size_t n)
@@ -49,10 +112,14 @@ protected:
             alloc_type::deallocate(p,n);
     }
 
-    //为对象分配n个元素内存
+    //为对象分配n个元素内存，局部缓冲区足够时不申请堆内存
     void allocate_block(size_t n)
     {
-        if(n <= max_size())
+        if(n <= (size_t)LOCAL_CAPACITY + 1)
+        {
+            set_local();
+        }
+        else if(n <= max_size())
         {
             start = allocate(n);
             finish = start;
@@ -67,7 +134,8 @@ protected:
     //释放对象的内存空间
     void deallocate_block()
     {
-        deallocate(start,end_of_storage - start);
+        if(!is_local())
+            deallocate(start,end_of_storage - start);
     }
 
     //能够申请的最大元素个数
@@ -76,12 +144,16 @@ protected:
         return (size_t(-1) / sizeof(Tp)) - 1;
     }
 
-    string_base(const allocator_type &)
-        : start(0),finish(0),end_of_storage(0) {}
+    string_base(const allocator_type &a)
+        : alloc_type(a)
+    {
+        set_local();
+    }
 
-    string_base(const allocator_type &,size_t n)
-        : start(0),finish(0),end_of_storage(0)
+    string_base(const allocator_type &a,size_t n)
+        : alloc_type(a)
     {
+        set_local();
         allocate_block(n);
     }
 
@@ -106,8 +178,8 @@ void string_base<Tp,Alloc>::throw_out_of_range() const
 
 ///////////////////////////////////////////////////////
 ///string实现
-///
-template<class CharT,class Alloc>
+///Growth为空间不足时的扩容策略，见growth_policy.h
+template<class CharT,class Alloc,class Growth = growth_double>
 class basic_string : private string_base<CharT,Alloc>
 {
 public:
@@ -122,6 +194,12 @@ public:
     typedef value_type* iterator;
     typedef const value_type* const_iterator;
 
+    //反向迭代器
+    typedef mini_stl::reverse_iterator<const_iterator,value_type,const_reference,
+        difference_type> const_reverse_iterator;
+    typedef mini_stl::reverse_iterator<iterator,value_type,reference,difference_type>
+        reverse_iterator;
+
     static const size_type npos;
 
     typedef string_base<CharT,Alloc> Base;
@@ -135,6 +213,10 @@ protected:
     using Base::start;
     using Base::finish;
     using Base::end_of_storage;
+    using Base::local_buf;
+    using Base::is_local;
+    using Base::storage_end;
+    using Base::set_local;
 
     using Base::allocate;
     using Base::deallocate;
@@ -146,8 +228,9 @@ protected:
 
 public:
     //默认构造函数
+    //空字符串保存在对象内部，不申请内存
     explicit basic_string(const allocator_type &a = allocator_type())
-        : Base(a,8)
+        : Base(a)
     {
         terminate_string();
     }
@@ -165,6 +248,15 @@ public:
         range_initialize(s.begin(),s.end());
     }
 
+#ifdef STL_CXX11
+    //移动构造函数：接管s的存储空间，s成为空字符串
+    basic_string(basic_string&& s) STL_NOEXCEPT
+        : Base(s.get_allocator())
+    {
+        steal(s);
+    }
+#endif
+
     //使用s从pos的n个字符构造字符串
     basic_string(const basic_string &s,size_type pos,size_type n = npos,
                  const allocator_type &a = allocator_type())
@@ -220,6 +312,15 @@ public:
         return *this;
     }
 
+#ifdef STL_CXX11
+    //移动赋值：与s交换存储空间，原来的字符随s析构
+    basic_string& operator =(basic_string&& s) STL_NOEXCEPT
+    {
+        swap(s);
+        return *this;
+    }
+#endif
+
     basic_string& operator =(CharT* s)
     {
         return assign(s,s+strlen(s));
@@ -232,6 +333,33 @@ public:
 
 private:
 
+    //接管s的字符和分配器，调用前*this必须是空的局部模式。
+    //堆内存直接转移指针，局部缓冲区复制字符；s成为空字符串
+    void steal(basic_string& s)
+    {
+        this->swap_allocator(s);
+        if(s.is_local())
+        {
+            const size_type n = s.size();
+            memcpy(local_buf,s.start,(n + 1) * sizeof(CharT));
+            finish = start + n;
+        }
+        else
+        {
+            start = s.start;
+            finish = s.finish;
+            end_of_storage = s.end_of_storage;
+        }
+        s.set_local();
+        s.construct_null(s.finish);
+    }
+
+    //空间不足、需要容纳n个字符时新的容量，不包括结尾的空字符
+    size_type grow_to(size_type n) const
+    {
+        return __grow_capacity<Growth,Alloc>(size(),n,sizeof(CharT),1);
+    }
+
     //构建一个空字符，并使p指向这个字符
     void construct_null(CharT *p)
     {
@@ -269,7 +397,11 @@ public:
     const_iterator begin() const {return start;}
     const_iterator end() const {return finish;}
 
-    //反向迭代器rbegin(),rend()
+    //反向迭代器
+    reverse_iterator rbegin() {return reverse_iterator(finish);}
+    reverse_iterator rend() {return reverse_iterator(start);}
+    const_reverse_iterator rbegin() const {return const_reverse_iterator(finish);}
+    const_reverse_iterator rend() const {return const_reverse_iterator(start);}
 
 public:
     size_type size() const {return (finish - start);}
@@ -292,8 +424,43 @@ public:
 
     void reserve(size_type n = 0);
 
+    //调整大小，新增的字符不初始化，内容不确定，
+    //用于随后整体覆盖的缓冲区，例如read()的目标，省去填充
+    void resize_default_init(size_type n)
+    {
+        if(n <= size())
+            erase(begin()+n,end());
+        else
+        {
+            if(n > capacity())
+                reserve(grow_to(n));
+            finish = start + n;
+            construct_null(finish);
+        }
+    }
+
+    //在末尾预留n个字符的未初始化空间，返回它的开始位置，size()不变。
+    //写入字符之后用commit计入size()
+    pointer append_uninitialized(size_type n)
+    {
+        if(n > max_size() || size() > max_size() - n)
+        {
+            THROW_LENGTH_ERROR("basic_string::append_uninitialized");
+        }
+        if(size() + n > capacity())
+            reserve(grow_to(size() + n));
+        return finish;
+    }
+
+    //append_uninitialized返回的空间中前n个字符已经写入
+    void commit(size_type n)
+    {
+        finish += n;
+        construct_null(finish);
+    }
+
     //有效空间大小
-    size_t capacity() const {return (end_of_storage - start - 1);}
+    size_t capacity() const {return (storage_end() - start - 1);}
 
     //清空字符串
     void clear()
@@ -306,8 +473,31 @@ public:
         }
     }
 
+    //与另一个字符串交换存储空间，分配器随空间一起交换
+    void swap(basic_string& s)
+    {
+        if(this == &s)
+            return;
+
+        if(!is_local() && !s.is_local())
+        {
+            this->swap_allocator(s);
+            std::swap(start,s.start);
+            std::swap(finish,s.finish);
+            std::swap(end_of_storage,s.end_of_storage);
+        }
+        else
+        {
+            //局部缓冲区不能交换指针，借助一个空字符串转移
+            basic_string tmp(s.get_allocator());
+            tmp.steal(s);
+            s.steal(*this);
+            steal(tmp);
+        }
+    }
+
     //判断字符串是否为空
-    bool empty()
+    bool empty() const
     {
         return start == finish;
     }
@@ -395,7 +585,7 @@ public:
             if(old_size+n > capacity())
             {
                 //需要扩充内存空间
-                const size_type len = old_size + max(old_size,(size_t)n)+1;
+                const size_type len = grow_to(old_size + n) + 1;
                 pointer new_start = allocate(len);
                 pointer new_finish = new_start;
 
@@ -432,7 +622,7 @@ public:
 
         //内存空间不足，调整内存大小
         if(size() + n > capacity())
-            reserve(size() + max(size(),n));
+            reserve(grow_to(size() + n));
 
         if(n > 0)
         {
@@ -445,8 +635,8 @@ public:
 
     void push_back(CharT c)
     {
-        if(finish + 1 == end_of_storage)
-            reserve(size()+max(size(),static_cast<size_type>(1)));
+        if(finish + 1 == storage_end())
+            reserve(grow_to(size() + 1));
 
         construct_null(finish+1);
         *finish = c;
@@ -497,6 +687,7 @@ public:
             memcpy(start,f,size());
             append(f+size(),l);
         }
+        return *this;
     }
 
     basic_string& assign(size_type n,CharT c)
@@ -513,7 +704,7 @@ public:
             memset(start,c,size());
             append(n-size(),c);
         }
-
+        return *this;
     }
 
 public: //Insert
@@ -581,6 +772,7 @@ public: //Insert
             throw_length_error();
 
         insert(start+pos,n,c);
+        return *this;
     }
 
     iterator insert(iterator p,CharT c)
@@ -591,7 +783,7 @@ public: //Insert
             return finish - 1;
         }
         else
-            insert_aux(p,c);
+            return insert_aux(p,c);
     }
 
     iterator insert_aux(iterator,CharT);
@@ -619,7 +811,7 @@ public: //erase
 
     iterator erase(iterator position)
     {
-        memmove(position,position+1,finish-position);
+        memmove(position,position+1,(finish-position) * sizeof(CharT));
         destroy(finish);
         --finish;
         return position;
@@ -629,8 +821,8 @@ public: //erase
     {
         if(first != last)
         {
-            //复制last后面的字符串包括'\0'
-            memcpy(first,last,(finish-last)+1);
+            //复制last后面的字符串包括'\0'，两个区间可能重叠
+            memmove(first,last,((finish-last)+1) * sizeof(CharT));
             const iterator new_finish = finish - (last - first);
             destroy(new_finish + 1,finish + 1);
             finish = new_finish;
@@ -758,13 +950,13 @@ public: //find
         return find(s.begin(),pos,s.size());
     }
 
-    size_type find(const CharT* s,size_type pos = 0)
+    size_type find(const CharT* s,size_type pos = 0) const
     {
         return find(s,pos,strlen(s));
     }
 
     size_type find(const CharT* s,size_type pos,size_type n) const;
-    size_type find(CharT c,size_type pos) const;
+    size_type find(CharT c,size_type pos = 0) const;
 
 public: //rfind找到最后一个匹配项目
     size_type rfind(const basic_string& s,size_type pos = npos) const
@@ -780,6 +972,77 @@ public: //rfind找到最后一个匹配项目
     size_type rfind(const CharT* s,size_type pos,size_type n) const;
     size_type rfind(CharT c,size_type pos = npos) const;
 
+public: //count统计字符c从pos开始出现的次数
+    size_type count(CharT c,size_type pos = 0) const
+    {
+        return pos < size() ? __count_char((const CharT*)start + pos,
+                                           (const CharT*)finish,c) : 0;
+    }
+
+public: //find_any_of2/3找到第一个等于a、b（或c）的字符，用于按分隔符切分
+    size_type find_any_of2(CharT a,CharT b,size_type pos = 0) const
+    {
+        if(pos >= size())
+            return npos;
+        const CharT* result = __scan_any_of2((const CharT*)start + pos,
+                                             (const CharT*)finish,a,b);
+        return result != finish ? result - start : npos;
+    }
+
+    size_type find_any_of3(CharT a,CharT b,CharT c,size_type pos = 0) const
+    {
+        if(pos >= size())
+            return npos;
+        const CharT* result = __scan_any_of3((const CharT*)start + pos,
+                                             (const CharT*)finish,a,b,c);
+        return result != finish ? result - start : npos;
+    }
+
+private: //find_*_of的实现，not_of为true时查找不在s中的字符
+    typedef typename __use_char_set<CharT>::type __char_set_tag;
+
+    size_type __find_first_of_aux(const CharT* s,size_type pos,size_type n,
+                                  bool not_of,__true_type) const
+    {
+        const char_set set(s,n);
+        return not_of ? find_first_not_of(set,pos) : find_first_of(set,pos);
+    }
+
+    size_type __find_last_of_aux(const CharT* s,size_type pos,size_type n,
+                                 bool not_of,__true_type) const
+    {
+        const char_set set(s,n);
+        return not_of ? find_last_not_of(set,pos) : find_last_of(set,pos);
+    }
+
+    static bool __in_set(CharT c,const CharT* s,size_type n)
+    {
+        for(size_type i = 0;i < n;++i)
+            if(s[i] == c)
+                return true;
+        return false;
+    }
+
+    size_type __find_first_of_aux(const CharT* s,size_type pos,size_type n,
+                                  bool not_of,__false_type) const
+    {
+        for(;pos < size();++pos)
+            if(__in_set(start[pos],s,n) != not_of)
+                return pos;
+        return npos;
+    }
+
+    size_type __find_last_of_aux(const CharT* s,size_type pos,size_type n,
+                                 bool not_of,__false_type) const
+    {
+        if(empty())
+            return npos;
+        for(size_type i = min(size() - 1,pos) + 1;i != 0;--i)
+            if(__in_set(start[i - 1],s,n) != not_of)
+                return i - 1;
+        return npos;
+    }
+
 public: //find_first_of找到第一个在s中任意一个元素匹配的数据
     size_type find_first_of(const basic_string& s,size_type pos = 0) const
     {
@@ -791,14 +1054,26 @@ public: //find_first_of找到第一个在s中任意一个元素匹配的数据
         return find_first_of(s,pos,strlen(s));
     }
 
-    size_type find_first_of(const CharT* s,size_type pos,size_type n) const;
+    size_type find_first_of(const CharT* s,size_type pos,size_type n) const
+    {
+        return __find_first_of_aux(s,pos,n,false,__char_set_tag());
+    }
+
     size_type find_first_of(CharT c,size_type pos = 0) const
     {
         return find(c,pos);
     }
 
-public: //find_last_of
-#if 0
+    //集合可以在多次查找之间重复使用
+    size_type find_first_of(const char_set& set,size_type pos = 0) const
+    {
+        if(pos >= size())
+            return npos;
+        const CharT* result = set.find_first_in(start + pos,finish);
+        return result != finish ? result - start : npos;
+    }
+
+public: //find_last_of找到pos之前（包括pos）最后一个在s中的字符
     size_type find_last_of(const basic_string& s,size_type pos = npos) const
     {
         return find_last_of(s.begin(),pos,s.size());
@@ -809,12 +1084,24 @@ public: //find_last_of
         return find_last_of(s,pos,strlen(s));
     }
 
-    size_type find_last_of(const CharT* s,size_type pos,size_type n) const;
+    size_type find_last_of(const CharT* s,size_type pos,size_type n) const
+    {
+        return __find_last_of_aux(s,pos,n,false,__char_set_tag());
+    }
+
     size_type find_last_of(const CharT c,size_type pos = npos) const
     {
         return rfind(c,pos);
     }
-#endif
+
+    size_type find_last_of(const char_set& set,size_type pos = npos) const
+    {
+        if(empty())
+            return npos;
+        const CharT* last = start + min(size() - 1,pos) + 1;
+        const CharT* result = set.find_last_in(start,last);
+        return result != last ? result - start : npos;
+    }
 
 public: //find_first_not_of 返回字符串中首次出现的不匹配str中的任何一个字符的首字符索引
     size_type find_first_not_of(const basic_string& s,
@@ -829,10 +1116,53 @@ public: //find_first_not_of 返回字符串中首次出现的不匹配str中的
     }
 
     size_type find_first_not_of(const CharT* s,size_type pos,
-                                size_type n) const;
-    size_type find_first_not_of(const CharT c,size_type pos = 0) const;
+                                size_type n) const
+    {
+        return __find_first_of_aux(s,pos,n,true,__char_set_tag());
+    }
+
+    size_type find_first_not_of(const CharT c,size_type pos = 0) const
+    {
+        return find_first_not_of(&c,pos,1);
+    }
+
+    size_type find_first_not_of(const char_set& set,size_type pos = 0) const
+    {
+        if(pos >= size())
+            return npos;
+        const CharT* result = set.find_first_not_in(start + pos,finish);
+        return result != finish ? result - start : npos;
+    }
+
+public://find_last_not_of找到pos之前（包括pos）最后一个不在s中的字符
+    size_type find_last_not_of(const basic_string& s,size_type pos = npos) const
+    {
+        return find_last_not_of(s.begin(),pos,s.size());
+    }
+
+    size_type find_last_not_of(const CharT* s,size_type pos = npos) const
+    {
+        return find_last_not_of(s,pos,strlen(s));
+    }
 
-public://find_last_not_of
+    size_type find_last_not_of(const CharT* s,size_type pos,size_type n) const
+    {
+        return __find_last_of_aux(s,pos,n,true,__char_set_tag());
+    }
+
+    size_type find_last_not_of(const CharT c,size_type pos = npos) const
+    {
+        return find_last_not_of(&c,pos,1);
+    }
+
+    size_type find_last_not_of(const char_set& set,size_type pos = npos) const
+    {
+        if(empty())
+            return npos;
+        const CharT* last = start + min(size() - 1,pos) + 1;
+        const CharT* result = set.find_last_not_in(start,last);
+        return result != last ? result - start : npos;
+    }
 
 public:
     basic_string substr(size_type pos = 0,size_type n = npos) const
@@ -904,20 +1234,48 @@ public://compare
 
 };
 
-template<class CharT,class Alloc>
-const typename basic_string<CharT,Alloc>::size_type
-basic_string<CharT,Alloc>::npos =
-(basic_string<CharT,Alloc>::size_type)-1;
+template<class Tp,class Alloc,class Growth>
+inline void swap(basic_string<Tp,Alloc,Growth>& x,basic_string<Tp,Alloc,Growth>& y)
+{
+    x.swap(y);
+}
 
+template<class CharT,class Alloc,class Growth>
+const typename basic_string<CharT,Alloc,Growth>::size_type
+basic_string<CharT,Alloc,Growth>::npos =
+(basic_string<CharT,Alloc,Growth>::size_type)-1;
 
-template<class Tp,class Alloc>
-void basic_string<Tp,Alloc>::reserve(size_type res_arg)
+
+template<class Tp,class Alloc,class Growth>
+void basic_string<Tp,Alloc,Growth>::reserve(size_type res_arg)
 {
     //检查参数
     if(res_arg > max_size())
         throw_length_error();
 
-    size_type n = max(res_arg,size()) + 1;
+    const size_type len = max(res_arg,size());
+
+    if(len <= (size_type)Base::LOCAL_CAPACITY)
+    {
+        //能放进局部缓冲区时释放堆内存
+        if(!is_local())
+        {
+            pointer old_start = start;
+            const size_type old_size = size();
+            const size_type old_n = end_of_storage - start;
+            set_local();
+            memcpy(local_buf,old_start,(old_size + 1) * sizeof(Tp));
+            finish = start + old_size;
+            deallocate(old_start,old_n);
+        }
+        return;
+    }
+
+    //容量已经足够，不重新分配
+    if(len <= capacity())
+        return;
+
+    size_type n = len + 1;
     pointer new_start = allocate(n);
     pointer new_finish = new_start;
 
@@ -936,21 +1294,14 @@ void basic_string<Tp,Alloc>::reserve(size_type res_arg)
     end_of_storage = start + n;
 }
 
-template<class InputIter,class Distance>
-inline void advance(InputIter& i,Distance n)
-{
-    while(n--)
-        ++i;
-}
-
-template<class CharT,class Alloc>
-void basic_string<CharT,Alloc>::insert(basic_string<CharT,Alloc>::iterator position, const CharT *first, const CharT *last)
+template<class CharT,class Alloc,class Growth>
+void basic_string<CharT,Alloc,Growth>::insert(basic_string<CharT,Alloc,Growth>::iterator position, const CharT *first, const CharT *last)
 {
     if(first != last)
     {
         const ptrdiff_t n = last - first;
 
-        if(end_of_storage - finish >= n+1)
+        if(storage_end() - finish >= n+1)
         {
             //具有足够的空间
             const ptrdiff_t elems_after = finish - position;
@@ -961,7 +1312,7 @@ void basic_string<CharT,Alloc>::insert(basic_string<CharT,Alloc>::iterator posit
                 //添加的数据不多
                 uninitialized_copy((finish-n)+1,finish+1,finish+1);
                 finish += n;
-                memcpy(position+n,position,(elems_after-n)+1);
+                memmove(position+n,position,((elems_after-n)+1) * sizeof(CharT));
                 copy(first,last,position);
             }
             else
@@ -985,7 +1336,7 @@ void basic_string<CharT,Alloc>::insert(basic_string<CharT,Alloc>::iterator posit
         {
             //没有空间
             const size_type old_size = size();
-            const size_type len = old_size + max(old_size,static_cast<size_type>(n))+1;
+            const size_type len = grow_to(old_size + n) + 1;
             pointer new_start = allocate(len);
             pointer new_finish = new_start;
 
@@ -1009,13 +1360,13 @@ void basic_string<CharT,Alloc>::insert(basic_string<CharT,Alloc>::iterator posit
 }
 
 
-template<class CharT,class Alloc>
-void basic_string<CharT,Alloc>::insert(basic_string<CharT,Alloc>::iterator position,
+template<class CharT,class Alloc,class Growth>
+void basic_string<CharT,Alloc,Growth>::insert(basic_string<CharT,Alloc,Growth>::iterator position,
                                        size_t n,CharT c)
 {
     if(n != 0)
     {
-        if(size_type(end_of_storage-finish) >= n+1)
+        if(size_type(storage_end()-finish) >= n+1)
         {
             //具有足够的空间
             const size_type elems_after = finish - position;
@@ -1025,8 +1376,8 @@ void basic_string<CharT,Alloc>::insert(basic_string<CharT,Alloc>::iterator posit
             {
                 uninitialized_copy((finish-n)+1,finish+1,finish+1);
                 finish += n;
-                memmove(position+n,position,(elems_after - n) + 1);
-                memset(position,c,n);
+                memmove(position+n,position,((elems_after - n) + 1) * sizeof(CharT));
+                fill_n(position,n,c);
             }
             else
             {
@@ -1040,14 +1391,14 @@ void basic_string<CharT,Alloc>::insert(basic_string<CharT,Alloc>::iterator posit
                 }
                 STL_UNWIND((destroy(old_finish+1,finish),finish = old_finish));
 
-                memset(position,c,elems_after + 1);
+                fill_n(position,elems_after + 1,c);
             }
         }
         else
         {
             //需要扩充空间
             const size_type old_size = size();
-            const size_type len = old_size + max(old_size,n)+1;
+            const size_type len = grow_to(old_size + n) + 1;
             iterator new_start = allocate(len);
             iterator new_finish = new_start;
 
@@ -1071,22 +1422,22 @@ void basic_string<CharT,Alloc>::insert(basic_string<CharT,Alloc>::iterator posit
 }
 
 
-template<class CharT,class Alloc>
-typename basic_string<CharT,Alloc>::iterator basic_string<CharT,Alloc>::insert_aux(basic_string<CharT,Alloc>::iterator p,
+template<class CharT,class Alloc,class Growth>
+typename basic_string<CharT,Alloc,Growth>::iterator basic_string<CharT,Alloc,Growth>::insert_aux(basic_string<CharT,Alloc,Growth>::iterator p,
                                   CharT c)
 {
     iterator new_pos = p;
-    if(finish + 1 < end_of_storage)
+    if(finish + 1 < storage_end())
     {
         construct_null(finish+1);
-        memmove(p+1,p,finish - p);
+        memmove(p+1,p,(finish - p) * sizeof(CharT));
         *p = c;
         ++finish;
     }
     else
     {
         const size_type old_len = size();
-        const size_type len = old_len + max(old_len,static_cast<size_type>(1))+1;
+        const size_type len = grow_to(old_len + 1) + 1;
 
         iterator new_start = allocate(len);
         iterator new_finish = new_start;
@@ -1113,8 +1464,8 @@ typename basic_string<CharT,Alloc>::iterator basic_string<CharT,Alloc>::insert_a
     return new_pos;
 }
 
-template<class CharT,class Alloc>
-basic_string<CharT,Alloc>& basic_string<CharT,Alloc>::replace(iterator first, iterator last,
+template<class CharT,class Alloc,class Growth>
+basic_string<CharT,Alloc,Growth>& basic_string<CharT,Alloc,Growth>::replace(iterator first, iterator last,
                                                               size_type n, CharT c)
 {
     const size_type len = static_cast<size_type>(last - first);
@@ -1131,8 +1482,8 @@ basic_string<CharT,Alloc>& basic_string<CharT,Alloc>::replace(iterator first, it
     return *this;
 }
 
-template<class CharT,class Alloc>
-basic_string<CharT,Alloc>& basic_string<CharT,Alloc>::replace(iterator first, iterator last,
+template<class CharT,class Alloc,class Growth>
+basic_string<CharT,Alloc,Growth>& basic_string<CharT,Alloc,Growth>::replace(iterator first, iterator last,
                                                               const CharT *f, const CharT *l)
 {
     const ptrdiff_t n = l - f;
@@ -1161,38 +1512,38 @@ inline bool char_eq(char x,char y)
     return x == y;
 }
 
-template<class CharT,class Alloc>
-typename basic_string<CharT,Alloc>::size_type basic_string<CharT,Alloc>::find(const CharT* s,
+template<class CharT,class Alloc,class Growth>
+typename basic_string<CharT,Alloc,Growth>::size_type basic_string<CharT,Alloc,Growth>::find(const CharT* s,
                                           size_type pos,size_type n) const
 {
     if(pos+n > size())
         return npos;
     else
     {
-        const const_iterator result = search(start+pos,finish,s,s+n,char_eq);
+        const const_iterator result = search_auto((const_iterator)start+pos,
+                                                  (const_iterator)finish,s,s+n);
         return result != finish ? result-begin() : npos;
     }
 }
 
-template<class CharT,class Alloc>
-typename basic_string<CharT,Alloc>::size_type
-basic_string<CharT,Alloc>::find(CharT c,size_type pos) const
+template<class CharT,class Alloc,class Growth>
+typename basic_string<CharT,Alloc,Growth>::size_type
+basic_string<CharT,Alloc,Growth>::find(CharT c,size_type pos) const
 {
     if(pos >= size())
         return npos;
     else
     {
-        CharT* first = start + pos;
-        while(first != finish && !(char_eq(*first,c)))
-            ++first;
-        return first != finish ? first - begin() : npos;
+        const CharT* result = __scan_char((const CharT*)start + pos,
+                                          (const CharT*)finish,c);
+        return result != finish ? result - begin() : npos;
     }
 }
 
 //从头到pos位置查找[s,s+n]字符串最后出现的位置
-template<class CharT,class Alloc>
-typename basic_string<CharT,Alloc>::size_type
-basic_string<CharT,Alloc>
+template<class CharT,class Alloc,class Growth>
+typename basic_string<CharT,Alloc,Growth>::size_type
+basic_string<CharT,Alloc,Growth>
 ::rfind(const CharT* s,size_type pos,size_type n) const
 {
     const size_t len = size();
@@ -1205,16 +1556,20 @@ basic_string<CharT,Alloc>
         return min(len,pos);
     else
     {
+        //在反向区间中查找反向的模式串，匹配的末尾就是原区间中匹配的开始
         const const_iterator last = begin()+min(len-n,pos)+n;
-        const const_iterator result = find_end(begin(),last,s,s+n,char_eq);
-        return result != last ? result - begin() : npos;
+        const const_reverse_iterator rlast(begin());
+        const const_reverse_iterator result =
+            search_auto(const_reverse_iterator(last),rlast,
+                        const_reverse_iterator(s+n),const_reverse_iterator(s));
+        return result != rlast ? (result.base() - n) - begin() : npos;
     }
 }
 
 
-template<class CharT,class Alloc>
-typename basic_string<CharT,Alloc>::size_type
-basic_string<CharT,Alloc>
+template<class CharT,class Alloc,class Growth>
+typename basic_string<CharT,Alloc,Growth>::size_type
+basic_string<CharT,Alloc,Growth>
 ::rfind(CharT c,size_type pos) const
 {
     const size_type len = size();
@@ -1224,59 +1579,13 @@ basic_string<CharT,Alloc>
         return npos;
     else
     {
-        const_iterator first = begin();
-        const_iterator last = begin()+min(len-1,pos)+1;
-
-        const_iterator result = last-1;
-        while(!char_eq(*result,c))
-        {
-            if(result == first)
-                return npos;
-            --result;
-        }
-
-        return result - begin();
-    }
-}
-
-template<class CharT,class Alloc>
-typename basic_string<CharT,Alloc>::size_type
-basic_string<CharT,Alloc>
-::find_first_of(const CharT* s,size_type pos,size_type n) const
-{
-    if(pos >= size())
-        return npos;
-    else
-    {
-        const_iterator result = __find_first_of(begin()+pos,end(),
-                                                s,s+n,char_eq);
-        return result != finish ? result - begin() : npos;
-    }
-}
-
-//template<class CharT,class Alloc>
-//typename basic_string<CharT,Alloc>::size_type
-//basic_string<CharT,Alloc>
-//::find_last_of(const CharT*s size_type pos,size_type n) const
-//{}
-
-template<class CharT,class Alloc>
-typename basic_string<CharT,Alloc>::size_type
-basic_string<CharT,Alloc>
-::find_first_not_of(const CharT* s,size_type pos,size_type n) const
-{
-    if(pos > size())
-        return npos;
-    else
-    {
-        const_iterator result = __find_first_not_of(begin()+pos,end(),
-                                                    s,s+n,char_eq);
-        return result != finish ? result - begin() : npos;
+        const const_iterator last = begin()+min(len-1,pos)+1;
+        const const_iterator result = __scan_char_back(begin(),last,c);
+        return result != last ? result - begin() : npos;
     }
 }
 
 
-
 ///////////////////////////////////////////////////////
 ///string声明
 ///
@@ -1287,6 +1596,49 @@ typedef basic_string<char,STL_DEFAULT_ALLOCATOR(char)> string;
 //获取string的char *指针
 static const char *get_c_string(const string &);
 
+///////////////////////////////////////////////////////
+///fixed_string：最多N个字符，全部保存在对象内部的缓冲区，从不申请内存。
+///接口与basic_string相同，超出容量时抛出length_error
+template<size_t N>
+class fixed_string : public basic_string<char,fixed_capacity_alloc<N> >
+{
+private:
+    typedef basic_string<char,fixed_capacity_alloc<N> > Base;
+
+public:
+    typedef typename Base::size_type size_type;
+
+    fixed_string() {}
+    fixed_string(const Base& s) : Base(s) {}
+    fixed_string(const char* s) : Base(s) {}
+    fixed_string(const char* s,size_type n) : Base(s,n) {}
+    fixed_string(const char* f,const char* l) : Base(f,l) {}
+    fixed_string(size_type n,char c) : Base(n,c) {}
+
+    fixed_string& operator=(const Base& s)
+    {
+        Base::operator=(s);
+        return *this;
+    }
+
+    fixed_string& operator=(const char* s)
+    {
+        Base::assign(s);
+        return *this;
+    }
+
+    fixed_string& operator=(char c)
+    {
+        Base::assign(static_cast<size_type>(1),c);
+        return *this;
+    }
+
+    size_type max_size() const
+    {
+        return N;
+    }
+};
+
 STL_END_NAMESPACE
 
 #endif // STRING_IMP_H
@@ -0,0 +1,355 @@
+//test_alloc.cpp
+
+#include <gtest/gtest.h>
+#include "../alloc_imp.h"
+#include "../vector_imp.h"
+#include "../string_imp.h"
+#include "../arena_alloc_imp.h"
+#include "../memory_resource_imp.h"
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#ifdef STL_CXX11
+#include "../thread_alloc_imp.h"
+#include <thread>
+#endif
+
+using namespace mini_stl;
+
+TEST(TestAlloc,DefaultAlloc)
+{
+    //释放后的小对象会被同一大小类重新使用
+    void* p1 = default_alloc::allocate(24);
+    default_alloc::deallocate(p1,24);
+    void* p2 = default_alloc::allocate(20);
+    EXPECT_EQ(p1,p2);
+    default_alloc::deallocate(p2,20);
+
+    //同一次补充得到的对象互不重叠
+    char* a = (char*)default_alloc::allocate(16);
+    char* b = (char*)default_alloc::allocate(16);
+    EXPECT_NE(a,b);
+    EXPECT_TRUE(a + 16 <= b || b + 16 <= a);
+    memset(a,1,16);
+    memset(b,2,16);
+    EXPECT_EQ(1,a[15]);
+    default_alloc::deallocate(a,16);
+    default_alloc::deallocate(b,16);
+
+    //大对象直接使用malloc
+    char* big = (char*)default_alloc::allocate(1000);
+    memset(big,3,1000);
+    EXPECT_EQ(3,big[999]);
+    default_alloc::deallocate(big,1000);
+}
+
+TEST(TestAlloc,Container)
+{
+    vector<int,default_alloc> vect;
+    for(int i = 0;i < 1000;i++)
+        vect.push_back(i);
+    for(int i = 0;i < 1000;i++)
+        EXPECT_EQ(i,vect[i]);
+
+    basic_string<char,default_alloc> str("abc");
+    for(int i = 0;i < 100;i++)
+        str.append("def");
+    EXPECT_EQ(303,(int)str.size());
+    EXPECT_EQ(0,str.compare(0,6,"abcdef"));
+
+    basic_string<char,malloc_alloc> str1("abc");
+    str1.append("def");
+    EXPECT_STREQ("abcdef",str1.c_str());
+}
+
+TEST(TestAlloc,GrowthPolicy)
+{
+#if defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__)
+    //与malloc实际提供的大小一致（不超过mmap阈值时），AddressSanitizer替换了malloc
+    for(size_t n = 1;n < 4000;n += 7)
+    {
+        void* p = malloc(n);
+        EXPECT_EQ(malloc_usable_size(p),malloc_alloc::good_size(n));
+        free(p);
+    }
+    //大块可能来自mmap也可能来自堆，good_size不超过实际大小
+    for(size_t n = 100000;n < 3000000;n = n * 3 + 1)
+    {
+        void* p = malloc(n);
+        EXPECT_LE(n,malloc_alloc::good_size(n));
+        EXPECT_GE(malloc_usable_size(p),malloc_alloc::good_size(n));
+        free(p);
+    }
+#endif
+    EXPECT_EQ(24u,default_alloc::good_size(17));
+    EXPECT_EQ(128u,default_alloc::good_size(128));
+    EXPECT_LE(1000u,default_alloc::good_size(1000));
+
+    //push_back时容量的变化
+    vector<int,malloc_alloc> dbl;
+    vector<int,malloc_alloc,growth_golden> golden;
+    vector<int,default_alloc,growth_fit<> > fit;
+    size_t last_golden = 0;
+    for(int i = 0;i < 1000;i++)
+    {
+        dbl.push_back(i);
+        golden.push_back(i);
+        fit.push_back(i);
+        if(golden.capacity() != last_golden)
+        {
+            EXPECT_EQ(last_golden + last_golden / 2 + 1,golden.capacity());
+            last_golden = golden.capacity();
+        }
+        //容量用满分配器提供的空间
+        EXPECT_EQ(fit.capacity(),default_alloc::good_size(fit.capacity() * sizeof(int)) / sizeof(int));
+    }
+    EXPECT_EQ(1024u,dbl.capacity());
+    for(int i = 0;i < 1000;i++)
+        EXPECT_TRUE(dbl[i] == i && golden[i] == i && fit[i] == i);
+
+    //insert多个元素时至少容纳全部元素
+    golden.insert(golden.begin(),5000,7);
+    EXPECT_EQ(6000u,golden.size());
+    EXPECT_LE(6000u,golden.capacity());
+    const vector<int,malloc_alloc,growth_golden> copy(golden);
+    EXPECT_TRUE(golden == copy);
+
+    //string的容量加上结尾的空字符用满分配器提供的空间
+    basic_string<char,default_alloc,growth_fit<> > str;
+    for(int i = 0;i < 300;i++)
+    {
+        str.push_back('a' + i % 26);
+        if(str.capacity() > 15)
+        {
+            EXPECT_EQ(str.capacity() + 1,default_alloc::good_size(str.capacity() + 1));
+        }
+    }
+    str.append(1000,'x');
+    str.insert(str.begin(),'y');
+    EXPECT_EQ(1301u,str.size());
+    EXPECT_EQ('y',str[0]);
+    EXPECT_EQ('a',str[1]);
+    EXPECT_EQ('x',str[1300]);
+
+    basic_string<char,malloc_alloc,growth_golden> gs;
+    for(int i = 0;i < 100;i++)
+        gs.append("0123456789");
+    EXPECT_EQ(1000u,gs.size());
+    EXPECT_EQ(0,gs.compare(990,10,"0123456789"));
+}
+
+TEST(TestAlloc,Arena)
+{
+    arena a(64);
+    void* first = 0;
+
+    {
+        arena_scope scope(a);
+        vector<int,arena_alloc> vect;
+        for(int i = 0;i < 100;i++)
+            vect.push_back(i);
+        EXPECT_EQ(99,vect[99]);
+
+        basic_string<char,arena_alloc> str("request");
+        str.append("-scoped");
+        EXPECT_STREQ("request-scoped",str.c_str());
+
+        EXPECT_TRUE(a.bytes_used() >= 100 * sizeof(int));
+        EXPECT_TRUE(a.bytes_reserved() >= a.bytes_used());
+        first = vect.begin();
+    }
+
+    //作用域结束后内存全部回收，只保留最后一个块
+    EXPECT_EQ(0u,a.bytes_used());
+    EXPECT_EQ(0,arena_alloc::current());
+
+    //最后一次分配可以被回收
+    void* p1 = a.allocate(24);
+    a.deallocate(p1,24);
+    void* p2 = a.allocate(24);
+    EXPECT_EQ(p1,p2);
+    EXPECT_NE((void*)0,first);
+
+    a.release();
+    EXPECT_EQ(0u,a.bytes_reserved());
+}
+
+//记录分配次数的资源
+class counting_resource : public memory_resource
+{
+public:
+    int allocations;
+    int deallocations;
+    size_t bytes;
+
+    counting_resource() : allocations(0),deallocations(0),bytes(0) {}
+
+protected:
+    virtual void* do_allocate(size_t n,size_t alignment)
+    {
+        ++allocations;
+        bytes += n;
+        return new_delete_resource()->allocate(n,alignment);
+    }
+
+    virtual void do_deallocate(void* p,size_t n,size_t alignment)
+    {
+        ++deallocations;
+        bytes -= n;
+        new_delete_resource()->deallocate(p,n,alignment);
+    }
+};
+
+TEST(TestAlloc,MemoryResource)
+{
+    //无状态分配器不增加容器大小
+    EXPECT_EQ(3 * sizeof(int*),sizeof(vector<int>));
+    EXPECT_EQ(2 * sizeof(char*) + 16,sizeof(basic_string<char,malloc_alloc>));
+    EXPECT_EQ(4 * sizeof(int*),sizeof(vector<int,polymorphic_allocator>));
+
+    counting_resource counter;
+    {
+        vector<int,polymorphic_allocator> vect(&counter);
+        for(int i = 0;i < 100;i++)
+            vect.push_back(i);
+        EXPECT_EQ(&counter,vect.get_allocator().resource());
+
+        //复制构造使用同一个资源
+        vector<int,polymorphic_allocator> vect1(vect);
+        EXPECT_EQ(&counter,vect1.get_allocator().resource());
+        EXPECT_EQ(99,vect1[99]);
+
+        basic_string<char,polymorphic_allocator> str("resource",&counter);
+        str.append("-string");
+        EXPECT_STREQ("resource-string",str.c_str());
+        EXPECT_TRUE(counter.allocations > 0);
+    }
+    EXPECT_EQ(counter.allocations,counter.deallocations);
+    EXPECT_EQ(0u,counter.bytes);
+
+    //单调缓冲资源：先使用给定的缓冲区，之后向上游申请
+    {
+        char buffer[256];
+        monotonic_buffer_resource mono(buffer,sizeof(buffer),&counter);
+        void* p = mono.allocate(100);
+        EXPECT_TRUE((char*)p >= buffer && (char*)p < buffer + sizeof(buffer));
+        EXPECT_EQ(0,counter.allocations - counter.deallocations);
+
+        vector<int,polymorphic_allocator> vect(&mono);
+        for(int i = 0;i < 1000;i++)
+            vect.push_back(i);
+        EXPECT_EQ(999,vect[999]);
+        EXPECT_TRUE(counter.allocations > counter.deallocations);
+    }
+    EXPECT_EQ(counter.allocations,counter.deallocations);
+
+    //内存池资源：释放的对象被重用，大请求交给上游
+    {
+        unsynchronized_pool_resource pool(&counter);
+        void* p1 = pool.allocate(24);
+        pool.deallocate(p1,24);
+        void* p2 = pool.allocate(20);
+        EXPECT_EQ(p1,p2);
+
+        void* aligned = pool.allocate(8,64);
+        EXPECT_EQ(0u,(size_t)aligned % 64);
+
+        const int allocations = counter.allocations;
+        const int deallocations = counter.deallocations;
+        void* big = pool.allocate(100000);
+        EXPECT_EQ(allocations + 1,counter.allocations);
+        pool.deallocate(big,100000);
+        EXPECT_EQ(deallocations + 1,counter.deallocations);
+
+        basic_string<char,polymorphic_allocator> str(&pool);
+        for(int i = 0;i < 50;i++)
+            str.append("pool");
+        EXPECT_EQ(200u,str.size());
+    }
+    EXPECT_EQ(counter.allocations,counter.deallocations);
+
+#ifdef STL_SYNCHRONIZED_POOL
+    {
+        synchronized_pool_resource pool(&counter);
+        vector<int,polymorphic_allocator> vect(&pool);
+        for(int i = 0;i < 100;i++)
+            vect.push_back(i);
+        EXPECT_EQ(50,vect[50]);
+    }
+    EXPECT_EQ(counter.allocations,counter.deallocations);
+#endif
+
+    //交换时分配器随存储一起交换
+    monotonic_buffer_resource mono;
+    vector<int,polymorphic_allocator> a(&counter);
+    vector<int,polymorphic_allocator> b(&mono);
+    a.push_back(1);
+    b.push_back(2);
+    a.swap(b);
+    EXPECT_EQ(&mono,a.get_allocator().resource());
+    EXPECT_EQ(&counter,b.get_allocator().resource());
+    EXPECT_EQ(1,b[0]);
+
+    //默认资源
+    memory_resource* old = set_default_resource(&counter);
+    EXPECT_EQ(&counter,polymorphic_allocator().resource());
+    set_default_resource(old);
+    EXPECT_EQ(new_delete_resource(),get_default_resource());
+}
+
+#ifdef STL_CXX11
+TEST(TestAlloc,ThreadAlloc)
+{
+    //本线程释放的对象被立即重用
+    void* p1 = thread_alloc::allocate(40);
+    thread_alloc::deallocate(p1,40);
+    void* p2 = thread_alloc::allocate(40);
+    EXPECT_EQ(p1,p2);
+    thread_alloc::deallocate(p2,40);
+
+    //一个线程分配，另一个线程释放
+    const int n = 10000;
+    void* ptrs[n];
+    std::thread producer([&ptrs]()
+    {
+        for(int i = 0;i < n;i++)
+        {
+            ptrs[i] = thread_alloc::allocate(16 + i % 100);
+            memset(ptrs[i],i & 0xff,16 + i % 100);
+        }
+    });
+    producer.join();
+
+    std::thread consumer([&ptrs]()
+    {
+        for(int i = 0;i < n;i++)
+        {
+            EXPECT_EQ((char)(i & 0xff),((char*)ptrs[i])[15]);
+            thread_alloc::deallocate(ptrs[i],16 + i % 100);
+        }
+    });
+    consumer.join();
+
+    //多个线程同时使用容器
+    std::thread workers[4];
+    for(int t = 0;t < 4;t++)
+    {
+        workers[t] = std::thread([t]()
+        {
+            for(int r = 0;r < 200;r++)
+            {
+                vector<int,thread_alloc> vect;
+                for(int i = 0;i < 50;i++)
+                    vect.push_back(i * t);
+                EXPECT_EQ(49 * t,vect[49]);
+
+                basic_string<char,thread_alloc> str("worker");
+                str.append("-thread");
+                EXPECT_STREQ("worker-thread",str.c_str());
+            }
+        });
+    }
+    for(int t = 0;t < 4;t++)
+        workers[t].join();
+}
+#endif
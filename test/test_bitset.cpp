@@ -2,6 +2,13 @@
 
 #include <gtest/gtest.h>
 #include "../bitset_imp.h"
+#include "../dynamic_bitset_imp.h"
+#include "../roaring_imp.h"
+#include "../rank_select_imp.h"
+#ifdef STL_CXX11
+#include "../atomic_bitset_imp.h"
+#include <thread>
+#endif
 
 using namespace mini_stl;
 
@@ -152,3 +159,727 @@ TEST(TestBitset,Extension)
     EXPECT_STREQ("01111111",str0.c_str());
 
 }
+
+#ifdef STL_X86_DISPATCH
+__attribute__((target("avx2")))
+static size_t reduce_add_m256_test(const unsigned long long* lanes)
+{
+    return __reduce_add_m256(_mm256_loadu_si256((const __m256i*)lanes));
+}
+#endif
+
+//count、find_first、find_next覆盖多个word和向量化的数组popcount
+TEST(TestBitset,Count)
+{
+    bitset<4096> bits;
+    EXPECT_EQ(0u,bits.count());
+    EXPECT_EQ(4096u,bits.find_first());
+
+    size_t expect = 0;
+    for(size_t i = 0;i < 4096;i += 10)
+    {
+        bits.set(i);
+        ++expect;
+    }
+    bits.set(4095);
+    ++expect;
+    EXPECT_EQ(expect,bits.count());
+
+    size_t found = 0;
+    size_t last = 0;
+    for(size_t i = bits.find_first();i < 4096;i = bits.find_next(i))
+    {
+        EXPECT_TRUE(i % 10 == 0 || i == 4095);
+        last = i;
+        ++found;
+    }
+    EXPECT_EQ(expect,found);
+    EXPECT_EQ(4095u,last);
+    EXPECT_EQ(4096u,bits.find_next(4095));
+    EXPECT_EQ(60u,bits.find_next(50));
+    EXPECT_EQ(70u,bits.find_next(63));
+
+    bits.set();
+    EXPECT_EQ(4096u,bits.count());
+    bitset<100> small;
+    small.set();
+    EXPECT_EQ(100u,small.count());
+
+    //各个数组popcount实现结果一致，长度覆盖向量的主体和尾部
+    unsigned long words[37];
+    unsigned seed = 3;
+    for(size_t i = 0;i < 37;i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        words[i] = (unsigned long)seed * 2654435761u ^ ((unsigned long)seed << 13);
+    }
+    for(size_t n = 0;n <= 37;n++)
+    {
+        const size_t expect_n = __popcount_words_generic(words,n);
+        EXPECT_EQ(expect_n,__popcount_words(words,n));
+#ifdef STL_X86_DISPATCH
+        if(__cpu_has_popcnt())
+        {
+            EXPECT_EQ(expect_n,__popcount_words_popcnt(words,n));
+        }
+        if(__cpu_has_avx2())
+        {
+            EXPECT_EQ(expect_n,__popcount_words_avx2(words,n));
+        }
+#   ifdef STL_AVX512_POPCNT
+        if(__cpu_has_avx512_popcnt())
+        {
+            EXPECT_EQ(expect_n,__popcount_words_avx512(words,n));
+        }
+#   endif
+#endif
+    }
+
+#ifdef STL_X86_DISPATCH
+    //每个64位的部分和可以超过2^31（约1GB的稠密位图）
+    if(__cpu_has_avx2())
+    {
+        const unsigned long long lanes[4] = {3ULL << 31,1ULL << 31,5,7};
+        EXPECT_EQ((size_t)((4ULL << 31) + 12),reduce_add_m256_test(lanes));
+    }
+#endif
+
+    EXPECT_EQ(0u,__ctz_word(1UL));
+    EXPECT_EQ(sizeof(unsigned long) * CHAR_BIT - 1,__clz_word(1UL));
+    EXPECT_EQ(0u,__clz_word(~0UL));
+    EXPECT_EQ(4u,__ctz_word(0x30UL));
+}
+
+//各个按位运算后popcount的实现与先运算再计数的结果一致
+template<int Op>
+static void check_count_op(const unsigned long* a,const unsigned long* b,size_t n)
+{
+    size_t expect = 0;
+    for(size_t i = 0;i < n;i++)
+        expect += __popcount_word(__bits_op_word<Op>(a[i],b[i]));
+    EXPECT_EQ(expect,__popcount_words_op<Op>(a,b,n));
+    EXPECT_EQ(expect,__popcount_words_op_generic<Op>(a,b,n));
+#ifdef STL_X86_DISPATCH
+    if(__cpu_has_avx2())
+    {
+        EXPECT_EQ(expect,__popcount_words_op_avx2<Op>(a,b,n));
+    }
+#   ifdef STL_AVX512_POPCNT
+    if(__cpu_has_avx512_popcnt())
+    {
+        EXPECT_EQ(expect,__popcount_words_op_avx512<Op>(a,b,n));
+    }
+#   endif
+#endif
+}
+
+TEST(TestBitset,FusedCount)
+{
+    unsigned long a[37],b[37];
+    unsigned seed = 5;
+    for(size_t i = 0;i < 37;i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        a[i] = (unsigned long)seed * 2654435761u ^ ((unsigned long)seed << 17);
+        seed = seed * 1103515245 + 12345;
+        b[i] = (unsigned long)seed * 2654435761u ^ ((unsigned long)seed << 9);
+    }
+    for(size_t n = 0;n <= 37;n++)
+    {
+        check_count_op<BITS_OP_AND>(a,b,n);
+        check_count_op<BITS_OP_OR>(a,b,n);
+        check_count_op<BITS_OP_XOR>(a,b,n);
+        check_count_op<BITS_OP_ANDNOT>(a,b,n);
+    }
+
+    bitset<1000> x,y;
+    for(size_t i = 0;i < 1000;i += 3)
+        x.set(i);
+    for(size_t i = 0;i < 1000;i += 5)
+        y.set(i);
+    EXPECT_EQ((x & y).count(),x.count_and(y));
+    EXPECT_EQ((x | y).count(),x.count_or(y));
+    EXPECT_EQ((x ^ y).count(),x.count_xor(y));
+    EXPECT_EQ((x & ~y).count(),x.count_andnot(y));
+    EXPECT_TRUE(x.intersects(y));
+    EXPECT_FALSE(x.is_subset_of(y));
+    EXPECT_TRUE((x & y).is_subset_of(y));
+    bitset<1000> z;
+    z.set(1);
+    z.set(998);
+    EXPECT_FALSE(z.intersects(x));
+    EXPECT_TRUE(z.is_subset_of(~x));
+    x.set(998);
+    EXPECT_TRUE(z.intersects(x));
+
+    //unsigned int的block使用通用实现
+    for(size_t n = 1;n < 300;n += 37)
+    {
+        dynamic_bitset<> da(n),db(n);
+        dynamic_bitset<unsigned int> ua(n),ub(n);
+        for(size_t i = 0;i < n;i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            da[i] = ua[i] = (seed >> 16) % 3 == 0;
+            db[i] = ub[i] = (seed >> 20) % 2 == 0;
+        }
+        EXPECT_EQ((da & db).count(),da.count_and(db));
+        EXPECT_EQ((da | db).count(),da.count_or(db));
+        EXPECT_EQ((da ^ db).count(),da.count_xor(db));
+        EXPECT_EQ((da & ~db).count(),da.count_andnot(db));
+        EXPECT_EQ((da & db).any(),da.intersects(db));
+        EXPECT_EQ((da & ~db).none(),da.is_subset_of(db));
+        EXPECT_EQ((ua & ub).count(),ua.count_and(ub));
+        EXPECT_EQ((ua & ~ub).count(),ua.count_andnot(ub));
+        EXPECT_EQ((ua | ub).count(),ua.count_or(ub));
+        EXPECT_EQ((ua & ub).any(),ua.intersects(ub));
+        EXPECT_TRUE((ua & ub).is_subset_of(ua));
+    }
+}
+
+TEST(TestBitset,Shift)
+{
+    //整word移位和超过大小的移位
+    bitset<200> bits;
+    bits.set(3);
+    bits.set(70);
+    bits <<= 64;
+    EXPECT_EQ(67u,bits.find_first());
+    EXPECT_EQ(134u,bits.find_next(67));
+    bits >>= 128;
+    EXPECT_EQ(6u,bits.find_first());
+    EXPECT_EQ(1u,bits.count());
+    bits <<= 1000;
+    EXPECT_TRUE(bits.none());
+}
+
+TEST(TestDynamicBitset,Basic)
+{
+    dynamic_bitset<> bits(10,0x2d);
+    string str;
+    bits.copy_to_string(str);
+    EXPECT_STREQ("0000101101",str.c_str());
+    EXPECT_EQ(10u,bits.size());
+    EXPECT_EQ(4u,bits.count());
+
+    bits[9] = true;
+    bits.flip(0);
+    bits.copy_to_string(str);
+    EXPECT_STREQ("1000101100",str.c_str());
+    EXPECT_TRUE(bits.test(9));
+    EXPECT_FALSE(bits[0]);
+
+    //超出范围
+    bool thrown = false;
+    try
+    {
+        bits.set(10);
+    }
+    catch(const out_of_range&)
+    {
+        thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+
+    //扩大时新增的bit为1，多余的bit保持为0
+    bits.resize(70,true);
+    EXPECT_EQ(64u,bits.count());
+    bits.flip();
+    EXPECT_EQ(6u,bits.count());
+    bits.resize(5);
+    bits.copy_to_string(str);
+    EXPECT_STREQ("10011",str.c_str());
+    EXPECT_EQ(1u,bits.num_blocks());
+
+    dynamic_bitset<unsigned int> small;
+    EXPECT_TRUE(small.empty());
+    EXPECT_TRUE(small.none());
+    for(int i = 0;i < 100;i++)
+        small.push_back(i % 3 == 0);
+    EXPECT_EQ(100u,small.size());
+    EXPECT_EQ(34u,small.count());
+    EXPECT_EQ(4u,small.num_blocks());
+    small.pop_back();
+    EXPECT_EQ(33u,small.count());
+    EXPECT_EQ(4u,small.num_blocks());
+    for(int i = 0;i < 3;i++)
+        small.pop_back();
+    EXPECT_EQ(3u,small.num_blocks());
+    EXPECT_EQ(32u,small.count());
+
+    small.set();
+    EXPECT_TRUE(small.all());
+    EXPECT_EQ(96u,small.count());
+}
+
+TEST(TestDynamicBitset,Operator)
+{
+    const size_t n = 1000;
+    dynamic_bitset<> a(n);
+    dynamic_bitset<> b(n);
+    for(size_t i = 0;i < n;i += 3)
+        a.set(i);
+    for(size_t i = 0;i < n;i += 5)
+        b.set(i);
+
+    EXPECT_EQ(67u,(a & b).count());
+    EXPECT_EQ(334u + 200u - 67u,(a | b).count());
+    EXPECT_EQ(334u + 200u - 2 * 67u,(a ^ b).count());
+    EXPECT_EQ(n - 334u,(~a).count());
+    EXPECT_TRUE((a & b) == (b & a));
+    EXPECT_TRUE(a != b);
+
+    //find_first/find_next遍历
+    size_t found = 0;
+    for(size_t i = a.find_first();i != dynamic_bitset<>::npos;i = a.find_next(i))
+    {
+        EXPECT_EQ(0u,i % 3);
+        ++found;
+    }
+    EXPECT_EQ(334u,found);
+
+    //移位与逐bit移动的结果一致
+    for(size_t shift = 0;shift < 200;shift += 13)
+    {
+        const dynamic_bitset<> left = a << shift;
+        const dynamic_bitset<> right = a >> shift;
+        for(size_t i = 0;i < n;i++)
+        {
+            EXPECT_EQ(i >= shift && a[i - shift],left[i]);
+            EXPECT_EQ(i + shift < n && a[i + shift],right[i]);
+        }
+    }
+
+    dynamic_bitset<> c(n + 1);
+    bool thrown = false;
+    try
+    {
+        c &= a;
+    }
+    catch(const invalid_argument&)
+    {
+        thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+
+    c.swap(a);
+    EXPECT_EQ(n,c.size());
+    EXPECT_EQ(334u,c.count());
+    EXPECT_EQ(n + 1,a.size());
+}
+
+//用dynamic_bitset作为对照，值的范围覆盖4个块
+namespace
+{
+    const unsigned ROARING_TEST_RANGE = 4 * 65536;
+
+    unsigned roaring_test_rand(unsigned& seed)
+    {
+        seed = seed * 1103515245u + 12345u;
+        return seed >> 8;
+    }
+
+    //块0稀疏（数组容器），块1稠密（位图容器），块3为一个区间
+    void roaring_test_fill(roaring_bitmap& r,dynamic_bitset<>& d,unsigned seed,
+                           unsigned dense_step)
+    {
+        for(int i = 0;i < 500;i++)
+        {
+            const unsigned v = roaring_test_rand(seed) % 65536;
+            r.add(v);
+            d.set(v);
+        }
+        for(unsigned v = 65536 + seed % 7;v < 2 * 65536;v += dense_step)
+        {
+            r.add(v);
+            d.set(v);
+        }
+        const unsigned first = 3 * 65536 + seed % 1000;
+        const unsigned last = first + 20000;
+        r.add_range(first,last);
+        for(unsigned v = first;v <= last;v++)
+            d.set(v);
+    }
+
+    bool roaring_test_same(const roaring_bitmap& r,const dynamic_bitset<>& d)
+    {
+        if(r.cardinality() != d.count())
+            return false;
+        size_t i = d.find_first();
+        for(roaring_bitmap::const_iterator it = r.begin();it != r.end();++it)
+        {
+            if(*it != i)
+                return false;
+            i = d.find_next(i);
+        }
+        return i == dynamic_bitset<>::npos;
+    }
+}
+
+TEST(TestRoaring,Basic)
+{
+    roaring_bitmap r;
+    EXPECT_TRUE(r.empty());
+    EXPECT_TRUE(r.begin() == r.end());
+
+    EXPECT_TRUE(r.add(5));
+    EXPECT_FALSE(r.add(5));
+    EXPECT_TRUE(r.add(0xFFFFFFFFu));
+    EXPECT_TRUE(r.add(70000));
+    EXPECT_EQ(3u,r.cardinality());
+    EXPECT_TRUE(r.contains(70000));
+    EXPECT_FALSE(r.contains(70001));
+
+    roaring_bitmap::const_iterator it = r.begin();
+    EXPECT_EQ(5u,*it++);
+    EXPECT_EQ(70000u,*it++);
+    EXPECT_EQ(0xFFFFFFFFu,*it++);
+    EXPECT_TRUE(it == r.end());
+
+    EXPECT_TRUE(r.remove(70000));
+    EXPECT_FALSE(r.remove(70000));
+    EXPECT_EQ(2u,r.cardinality());
+
+    //数组容器超过4096个值时转换为位图，删除后再转换回来
+    roaring_bitmap big;
+    dynamic_bitset<> d(ROARING_TEST_RANGE);
+    for(unsigned v = 0;v < 10000;v += 2)
+    {
+        big.add(v);
+        d.set(v);
+    }
+    EXPECT_TRUE(roaring_test_same(big,d));
+    for(unsigned v = 0;v < 3000;v += 2)
+    {
+        big.remove(v);
+        d.reset(v);
+    }
+    EXPECT_TRUE(roaring_test_same(big,d));
+
+    //区间和行程容器
+    roaring_bitmap range;
+    range.add_range(65530,3 * 65536 + 10);
+    EXPECT_EQ(2 * 65536u + 17,range.cardinality());
+    EXPECT_TRUE(range.contains(65530));
+    EXPECT_TRUE(range.contains(100000));
+    EXPECT_FALSE(range.contains(65529));
+    EXPECT_FALSE(range.contains(3 * 65536 + 11));
+    range.add(10);
+    range.remove(100000);
+    EXPECT_EQ(2 * 65536u + 17,range.cardinality());
+    EXPECT_FALSE(range.contains(100000));
+
+    //向数组容器加入小区间后仍然是数组，不会变成8KB的位图
+    roaring_bitmap small;
+    for(unsigned v = 0;v < 100;v += 10)
+        small.add(v);
+    small.add_range(5,25);
+    EXPECT_EQ(29u,small.cardinality());
+    EXPECT_TRUE(small.contains(25));
+    EXPECT_TRUE(small.contains(30));
+    EXPECT_FALSE(small.contains(26));
+    EXPECT_GT(1000u,small.serialized_size());
+    small.add_range(1000,1000 + ROARING_ARRAY_MAX);
+    EXPECT_EQ(29u + ROARING_ARRAY_MAX + 1,small.cardinality());
+    EXPECT_TRUE(small.contains(1000 + ROARING_ARRAY_MAX));
+
+    r.clear();
+    EXPECT_TRUE(r.empty());
+}
+
+TEST(TestRoaring,Operator)
+{
+    for(unsigned step = 1;step <= 40;step += 13)
+    {
+        roaring_bitmap a,b;
+        dynamic_bitset<> da(ROARING_TEST_RANGE),db(ROARING_TEST_RANGE);
+        roaring_test_fill(a,da,1,step);
+        roaring_test_fill(b,db,2,step + 3);
+        //数组与位图容器之间的运算
+        for(unsigned v = 2 * 65536;v < 2 * 65536 + 300;v++)
+        {
+            a.add(v);
+            da.set(v);
+        }
+        for(unsigned v = 2 * 65536;v < 3 * 65536;v += 3)
+        {
+            b.add(v);
+            db.set(v);
+        }
+
+        EXPECT_TRUE(roaring_test_same(a & b,da & db));
+        EXPECT_TRUE(roaring_test_same(a | b,da | db));
+        EXPECT_TRUE(roaring_test_same(a ^ b,da ^ db));
+        EXPECT_TRUE(roaring_test_same(a - b,da & ~db));
+        EXPECT_TRUE(roaring_test_same(b - a,db & ~da));
+
+        //压缩后结果不变
+        roaring_bitmap ra = a,rb = b;
+        EXPECT_TRUE(ra.run_optimize());
+        rb.run_optimize();
+        EXPECT_TRUE(ra == a);
+        EXPECT_TRUE(roaring_test_same(ra & rb,da & db));
+        EXPECT_TRUE(roaring_test_same(ra | b,da | db));
+        EXPECT_TRUE(roaring_test_same(a ^ rb,da ^ db));
+        EXPECT_TRUE(roaring_test_same(ra - rb,da & ~db));
+
+        roaring_bitmap c = a;
+        c &= b;
+        EXPECT_TRUE(c == (a & b));
+        c |= a;
+        EXPECT_TRUE(c == a);
+        c ^= a;
+        EXPECT_TRUE(c.empty());
+        EXPECT_TRUE(a != b);
+    }
+
+    //大小相差很大的数组求交集
+    roaring_bitmap small,large;
+    dynamic_bitset<> ds(ROARING_TEST_RANGE),dl(ROARING_TEST_RANGE);
+    for(unsigned v = 7;v < 65536;v += 1000)
+    {
+        small.add(v);
+        ds.set(v);
+    }
+    for(unsigned v = 0;v < 4000;v++)
+    {
+        large.add(v * 16 + 7);
+        dl.set(v * 16 + 7);
+    }
+    EXPECT_TRUE(roaring_test_same(small & large,ds & dl));
+    EXPECT_TRUE(roaring_test_same(large & small,ds & dl));
+}
+
+TEST(TestRoaring,Serialize)
+{
+    roaring_bitmap a;
+    dynamic_bitset<> da(ROARING_TEST_RANGE);
+    roaring_test_fill(a,da,3,2);
+
+    for(int optimized = 0;optimized < 2;optimized++)
+    {
+        if(optimized)
+            a.run_optimize();
+
+        vector<char> buf(a.serialized_size());
+        EXPECT_EQ(buf.size(),a.serialize(buf.begin()));
+        roaring_bitmap b = roaring_bitmap::deserialize(buf.begin(),buf.size());
+        EXPECT_TRUE(a == b);
+        EXPECT_TRUE(roaring_test_same(b,da));
+
+        //截断的数据
+        bool thrown = false;
+        try
+        {
+            roaring_bitmap::deserialize(buf.begin(),buf.size() - 1);
+        }
+        catch(const invalid_argument&)
+        {
+            thrown = true;
+        }
+        EXPECT_TRUE(thrown);
+    }
+
+    //连续的值转换为行程容器后更小
+    roaring_bitmap r;
+    for(unsigned v = 0;v <= 200000;v++)
+        r.add(v);
+    const size_t before = r.serialized_size();
+    EXPECT_TRUE(r.run_optimize());
+    EXPECT_GT(before / 100,r.serialized_size());
+    EXPECT_EQ(200001u,r.cardinality());
+
+    //容器类型与值的个数不符：数组超过ROARING_ARRAY_MAX个值，位图不超过
+    for(int type = 0;type < 2;type++)
+    {
+        const unsigned long m = type == 0 ? ROARING_ARRAY_MAX + 1 : 3;
+        const unsigned char head[11] = {1,0,0,0, 0,0, (unsigned char)type,
+                                        (unsigned char)m,(unsigned char)(m >> 8),0,0};
+        vector<char> bad((const char*)head,(const char*)head + 11);
+        if(type == 0)
+        {
+            for(unsigned v = 0;v < m;v++)
+            {
+                bad.push_back((char)(v & 0xFF));
+                bad.push_back((char)(v >> 8));
+            }
+        }
+        else
+        {
+            bad.resize(bad.size() + ROARING_CHUNK_BITS / 8,0);
+            bad[11] = 0x07;
+        }
+
+        bool thrown = false;
+        try
+        {
+            roaring_bitmap::deserialize(bad.begin(),bad.size());
+        }
+        catch(const invalid_argument&)
+        {
+            thrown = true;
+        }
+        EXPECT_TRUE(thrown);
+    }
+
+    //恰好ROARING_ARRAY_MAX个值仍然是数组容器
+    roaring_bitmap full;
+    for(unsigned v = 0;v < ROARING_ARRAY_MAX;v++)
+        full.add(v * 3);
+    vector<char> buf(full.serialized_size());
+    full.serialize(buf.begin());
+    EXPECT_TRUE(full == roaring_bitmap::deserialize(buf.begin(),buf.size()));
+}
+
+//与逐bit计算的结果对比
+template<class Bits>
+static void check_rank_select(const Bits& b,const rank_select& rs)
+{
+    size_t ones = 0;
+    for(size_t i = 0;i < b.size();i++)
+    {
+        EXPECT_EQ(ones,rs.rank1(i));
+        EXPECT_EQ(i - ones,rs.rank0(i));
+        if(b[i])
+            EXPECT_EQ(i,rs.select1(ones++));
+        else
+            EXPECT_EQ(i,rs.select0(i - ones));
+    }
+    EXPECT_EQ(ones,rs.count());
+    EXPECT_EQ(ones,rs.rank1(b.size()));
+    EXPECT_TRUE(rs.select1(ones) == rank_select::npos);
+    EXPECT_TRUE(rs.select0(b.size() - ones) == rank_select::npos);
+}
+
+TEST(TestRankSelect,Bitset)
+{
+    bitset<1000> small;
+    check_rank_select(small,rank_select(small));
+    for(size_t i = 0;i < 1000;i += 7)
+        small.set(i);
+    check_rank_select(small,rank_select(small));
+    small.set();
+    check_rank_select(small,rank_select(small));
+
+    //跨越多个超级块，包含全0和全1的区域
+    const size_t n = 300001;
+    dynamic_bitset<> d(n);
+    unsigned seed = 1;
+    for(size_t i = 0;i < n;i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        if(i < 70000)
+            d[i] = (seed >> 16) % 3 == 0;
+        else if(i >= 140000 && i < 220000)
+            d[i] = true;
+        else if(i >= 220000)
+            d[i] = (seed >> 16) % 100 == 0;
+    }
+    const rank_select rs(d);
+    check_rank_select(d,rs);
+    EXPECT_GT(n / 8 * 5 / 100,rs.memory_usage());
+
+    //修改之后重新建立
+    d.flip();
+    rank_select rs2;
+    rs2.build(d.data(),d.size());
+    check_rank_select(d,rs2);
+}
+
+TEST(TestRankSelect,SelectWord)
+{
+    unsigned long x = 0;
+    for(size_t i = 0;i < BITS_PER_WORD;i += 3)
+        x |= 1UL << i;
+    for(size_t k = 0;k < __popcount_word(x);k++)
+    {
+        EXPECT_EQ(k * 3,__select_word(x,k));
+        EXPECT_EQ(k * 3,__select_word_generic(x,k));
+    }
+    EXPECT_EQ(BITS_PER_WORD - 1,__select_word(~0UL,BITS_PER_WORD - 1));
+}
+
+#ifdef STL_CXX11
+TEST(TestAtomicBitset,Basic)
+{
+    atomic_bitset<100> bits;
+    EXPECT_TRUE(bits.none());
+    EXPECT_FALSE(bits.test_and_set(3));
+    EXPECT_TRUE(bits.test_and_set(3,std::memory_order_relaxed));
+    bits.set(99).set(64,std::memory_order_release);
+    EXPECT_TRUE(bits.test(64,std::memory_order_acquire));
+    EXPECT_EQ(3u,bits.count());
+    EXPECT_EQ(3u,bits.find_first());
+    EXPECT_TRUE(bits.test_and_reset(3));
+    EXPECT_FALSE(bits[3]);
+    EXPECT_FALSE(bits.test_and_flip(5));
+    EXPECT_TRUE(bits[5]);
+
+    EXPECT_EQ(0u,bits.fetch_or_word(0,0xF00UL) & 0xF00UL);
+    EXPECT_EQ(0xF00UL | (1UL << 5),bits.load_word(0));
+
+    bitset<100> expect;
+    expect.set(5).set(8).set(9).set(10).set(11).set(64).set(99);
+    EXPECT_TRUE(bits.to_bitset() == expect);
+
+    bool thrown = false;
+    try
+    {
+        bits.test_and_set(100);
+    }
+    catch(const out_of_range&)
+    {
+        thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+
+    //分配直到全部为1，不会分配超出大小的bit
+    bits.reset();
+    for(size_t i = 0;i < 100;i++)
+        EXPECT_EQ(i,bits.find_first_zero_and_set());
+    EXPECT_EQ(100u,bits.find_first_zero_and_set());
+    EXPECT_EQ(100u,bits.find_first_zero());
+    bits.reset(70);
+    EXPECT_EQ(70u,bits.find_first_zero_and_set(90));
+}
+
+TEST(TestAtomicBitset,Concurrent)
+{
+    const int nthreads = 4;
+    static atomic_bitset<10000> visited;
+    static atomic_bitset<10000> ids;
+    size_t wins[nthreads] = {0};
+    vector<size_t> got[nthreads];
+
+    //每个位置只有一个线程的test_and_set返回false；分配的id互不相同
+    std::thread threads[nthreads];
+    for(int t = 0;t < nthreads;t++)
+    {
+        threads[t] = std::thread([t,&wins,&got]()
+        {
+            for(size_t i = 0;i < 10000;i++)
+                if(!visited.test_and_set((i * 7 + t) % 10000,std::memory_order_relaxed))
+                    ++wins[t];
+            for(size_t id;(id = ids.find_first_zero_and_set(t * 2500)) != 10000;)
+                got[t].push_back(id);
+        });
+    }
+    for(int t = 0;t < nthreads;t++)
+        threads[t].join();
+
+    size_t total = 0;
+    dynamic_bitset<> seen(10000);
+    for(int t = 0;t < nthreads;t++)
+    {
+        total += wins[t];
+        for(size_t i = 0;i < got[t].size();i++)
+        {
+            EXPECT_FALSE(seen[got[t][i]]);
+            seen.set(got[t][i]);
+        }
+    }
+    EXPECT_EQ(10000u,total);
+    EXPECT_EQ(10000u,visited.count());
+    EXPECT_TRUE(seen.all());
+}
+#endif
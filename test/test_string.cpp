@@ -1,6 +1,7 @@
 //test_string.cpp
 
 #include "../string_imp.h"
+#include "../vector_imp.h"
 #include <iostream>
 #include <gtest/gtest.h>
 
@@ -11,7 +12,7 @@ TEST(TestString,Construct)
     //
     string str;
     EXPECT_EQ(str.size(),0);
-    EXPECT_EQ(str.capacity(),7);
+    EXPECT_EQ(str.capacity(),15);
 
     string str1("0123456",5);
     EXPECT_EQ(str1.size(),5);
@@ -52,11 +53,11 @@ TEST(TestString,Size)
     EXPECT_STREQ(str.begin(),"123");
 
     str.resize(8,'a');
-    EXPECT_EQ(8,str.capacity());
+    EXPECT_EQ(15,str.capacity());
     EXPECT_STREQ(str.begin(),"123aaaaa");
 
     str.resize(12);
-    EXPECT_EQ(16,str.capacity());
+    EXPECT_EQ(15,str.capacity());
     EXPECT_STREQ("123aaaaa",str.begin());
 
     EXPECT_EQ(false,str.empty());
@@ -82,22 +83,22 @@ TEST(TestString,Assign)
     str2.assign(str1.begin(),str1.end());
     EXPECT_STREQ(str2.begin(),"0123456");
     EXPECT_EQ(str2.size(),7);
-    EXPECT_EQ(str2.capacity(),12);
+    EXPECT_EQ(str2.capacity(),15);
 
     str3.assign(str1.begin(),str1.end());
     EXPECT_STREQ(str3.begin(),"0123456");
     EXPECT_EQ(str3.size(),7);
-    EXPECT_EQ(str3.capacity(),12);
+    EXPECT_EQ(str3.capacity(),15);
 
     //basic_string& assign(size_type n,CharT c)
     string str4("123456");
     str4.assign(3,'a');
-    EXPECT_EQ(str4.capacity(),6);
+    EXPECT_EQ(str4.capacity(),15);
     EXPECT_EQ(str4.size(),3);
     EXPECT_STREQ(str4.begin(),"aaa");
 
     str4.assign(10,'b');
-    EXPECT_EQ(str4.capacity(),10);
+    EXPECT_EQ(str4.capacity(),15);
     EXPECT_EQ(str4.size(),10);
     EXPECT_STREQ(str4.begin(),"bbbbbbbbbb");
 }
@@ -106,29 +107,29 @@ TEST(TestString,Append)
 {
     //basic_string& append(const CharT* first,const CharT* last)
     string str1("123456");
-    EXPECT_EQ(str1.capacity(),6);
+    EXPECT_EQ(str1.capacity(),15);
 
     string str2("abc");
     str1.append(str2.begin(),str2.end());
-    EXPECT_EQ(str1.capacity(),12);
+    EXPECT_EQ(str1.capacity(),15);
     EXPECT_EQ(str1.size(),9);
     EXPECT_STREQ(str1.begin(),"123456abc");
 
     string str3("de");
     str1.append(str3.begin(),str3.end());
-    EXPECT_EQ(str1.capacity(),12);
+    EXPECT_EQ(str1.capacity(),15);
     EXPECT_EQ(str1.size(),11);
     EXPECT_STREQ(str1.begin(),"123456abcde");
 
     //basic_string& append(size_type n,CharT c)
     string str4("1234567");
     str4.append(3,'a');
-    EXPECT_EQ(str4.capacity(),14);
+    EXPECT_EQ(str4.capacity(),15);
     EXPECT_EQ(str4.size(),10);
     EXPECT_STREQ(str4.begin(),"1234567aaa");
 
     str4.append(2,'b');
-    EXPECT_EQ(str4.capacity(),14);
+    EXPECT_EQ(str4.capacity(),15);
     EXPECT_EQ(str4.size(),12);
     EXPECT_STREQ(str4.begin(),"1234567aaabb");
 
@@ -201,7 +202,7 @@ TEST(TestString,Insert)
     EXPECT_STREQ("1b23456a",str.begin());
     str.assign("123");
     str.reserve(3);
-    EXPECT_EQ(3,str.capacity());
+    EXPECT_EQ(15,str.capacity());
     str.insert(str.begin(),'a');
     EXPECT_STREQ("a123",str.begin());
 }
@@ -353,3 +354,400 @@ TEST(TestString,Compare)
 }
 
 
+
+TEST(TestString,ReverseIterator)
+{
+    string str("abcdef");
+    string reversed;
+    for(string::reverse_iterator iter = str.rbegin();iter != str.rend();++iter)
+        reversed.push_back(*iter);
+    EXPECT_STREQ("fedcba",reversed.c_str());
+    EXPECT_EQ(6,str.rend() - str.rbegin());
+
+    //rfind使用逆向迭代器从后向前查找
+    string str1("abcabcabc");
+    EXPECT_EQ(6u,str1.rfind("abc"));
+    EXPECT_EQ(3u,str1.rfind("abc",5));
+    EXPECT_EQ(string::npos,str1.rfind("abd"));
+}
+
+TEST(TestString,SmallString)
+{
+    //不超过15个字符时保存在对象内部
+    string str;
+    EXPECT_EQ(15u,str.capacity());
+    const char* local = str.c_str();
+    EXPECT_TRUE(local >= (const char*)&str && local < (const char*)(&str + 1));
+
+    str.append("0123456789abcde");
+    EXPECT_EQ(local,str.c_str());
+    EXPECT_STREQ("0123456789abcde",str.c_str());
+
+    //超过之后转到堆内存
+    str.push_back('f');
+    EXPECT_NE(local,str.c_str());
+    EXPECT_STREQ("0123456789abcdef",str.c_str());
+    EXPECT_TRUE(str.capacity() >= 16u);
+
+    //reserve缩小到局部缓冲区
+    str.erase(4,12);
+    str.reserve(0);
+    EXPECT_EQ(local,str.c_str());
+    EXPECT_STREQ("0123",str.c_str());
+
+    //insert从局部模式扩容
+    str.insert(2,"ABCDEFGHIJKLMNOPQRSTUVWXYZ");
+    EXPECT_STREQ("01ABCDEFGHIJKLMNOPQRSTUVWXYZ23",str.c_str());
+    str.assign("xy");
+    str.insert(str.begin() + 1,20,'-');
+    EXPECT_STREQ("x--------------------y",str.c_str());
+
+    //复制和交换局部模式与堆模式的字符串
+    string small("small");
+    string large("a string that does not fit inline");
+    string copy(small);
+    EXPECT_STREQ("small",copy.c_str());
+    small.swap(large);
+    EXPECT_STREQ("a string that does not fit inline",small.c_str());
+    EXPECT_STREQ("small",large.c_str());
+    large.swap(copy);
+    EXPECT_STREQ("small",large.c_str());
+    EXPECT_STREQ("small",copy.c_str());
+}
+
+TEST(TestString,FixedString)
+{
+    //N个字符全部保存在对象内部
+    fixed_string<32> str("key=");
+    EXPECT_EQ(32u,str.capacity());
+    EXPECT_EQ(32u,str.max_size());
+    const char* local = str.c_str();
+    EXPECT_TRUE(local >= (const char*)&str && local < (const char*)(&str + 1));
+
+    str.append("value");
+    str.replace(0,3,"name");
+    str.insert(str.size(),1,';');
+    EXPECT_STREQ("name=value;",str.c_str());
+    EXPECT_EQ(5u,str.find("value"));
+    EXPECT_EQ(4u,str.find('='));
+    EXPECT_EQ(0,str.compare("name=value;"));
+    EXPECT_TRUE(str.compare("name=valuf") < 0);
+    EXPECT_EQ(local,str.c_str());
+
+    str.append(21,'x');
+    EXPECT_EQ(32u,str.size());
+    EXPECT_EQ(local,str.c_str());
+
+    //超出容量时抛出异常，字符串不变
+    EXPECT_THROW(str.push_back('y'),std::length_error);
+    EXPECT_THROW(str.append("yy"),std::length_error);
+    EXPECT_THROW(str.reserve(33),std::length_error);
+    EXPECT_THROW(fixed_string<4>("12345"),std::length_error);
+    EXPECT_EQ(32u,str.size());
+    EXPECT_EQ('x',str[31]);
+
+    //复制、赋值和交换都在对象内部进行
+    fixed_string<32> copy(str);
+    EXPECT_EQ(0,copy.compare(str));
+    fixed_string<32> other("other");
+    other.swap(copy);
+    EXPECT_STREQ("other",copy.c_str());
+    EXPECT_EQ(0,other.compare(str));
+    copy = "abc";
+    EXPECT_STREQ("abc",copy.c_str());
+    copy.reserve(0);
+    EXPECT_EQ(32u,copy.capacity());
+}
+
+TEST(TestString,DefaultInit)
+{
+    string str("head:");
+    str.resize_default_init(100);
+    EXPECT_EQ(100u,str.size());
+    EXPECT_EQ('\0',str.c_str()[100]);
+    memset(&str[5],'x',95);
+    EXPECT_EQ(0,str.compare(0,6,"head:x"));
+    str.resize_default_init(3);
+    EXPECT_STREQ("hea",str.c_str());
+
+    //预留、写入、提交，结尾的空字符由commit写入
+    string buf;
+    for(int round = 0;round < 10;round++)
+    {
+        char* p = buf.append_uninitialized(8);
+        EXPECT_EQ(buf.end(),p);
+        memcpy(p,"abcdefgh",8);
+        buf.commit(round % 2 == 0 ? 8 : 4);
+    }
+    EXPECT_EQ(60u,buf.size());
+    EXPECT_EQ(60u,strlen(buf.c_str()));
+    EXPECT_EQ(0,buf.compare(0,12,"abcdefghabcd"));
+    EXPECT_THROW(buf.append_uninitialized(buf.max_size()),std::length_error);
+    EXPECT_THROW(string("hi").append_uninitialized(size_t(-1) - 1),std::length_error);
+    EXPECT_EQ(60u,buf.size());
+
+    fixed_string<16> fixed;
+    memcpy(fixed.append_uninitialized(16),"0123456789abcdef",16);
+    fixed.commit(16);
+    EXPECT_STREQ("0123456789abcdef",fixed.c_str());
+    EXPECT_THROW(fixed.append_uninitialized(1),std::length_error);
+}
+
+#ifdef STL_CXX11
+TEST(TestString,Move)
+{
+    string str("move semantics on the heap");
+    const char* data = str.c_str();
+
+    //移动构造接管字符数组，原字符串为空
+    string str1(STL_MOVE(str));
+    EXPECT_EQ(data,str1.c_str());
+    EXPECT_STREQ("move semantics on the heap",str1.c_str());
+    EXPECT_EQ(0u,str.size());
+    EXPECT_STREQ("",str.c_str());
+    str.append("reuse");
+    EXPECT_STREQ("reuse",str.c_str());
+
+    //移动赋值
+    string str2("old");
+    str2 = STL_MOVE(str1);
+    EXPECT_EQ(data,str2.c_str());
+    EXPECT_STREQ("move semantics on the heap",str2.c_str());
+
+    str2.swap(str);
+    EXPECT_STREQ("reuse",str2.c_str());
+    EXPECT_STREQ("move semantics on the heap",str.c_str());
+
+    //短字符串移动时复制字符
+    string str3("short");
+    string str4(STL_MOVE(str3));
+    EXPECT_STREQ("short",str4.c_str());
+    EXPECT_STREQ("",str3.c_str());
+
+    //vector<string>扩容时移动字符串
+    vector<string> strs;
+    for(int i = 0;i < 100;i++)
+        strs.push_back(i % 2 ? string("tiny") : string("long enough to need the heap"));
+    EXPECT_STREQ("tiny",strs[99].c_str());
+    EXPECT_STREQ("long enough to need the heap",strs[98].c_str());
+}
+#endif
+
+//朴素查找，用来核对find/rfind的结果
+static size_t naive_find(const char* h,size_t hn,const char* s,size_t n,size_t pos)
+{
+    for(size_t i = pos;i + n <= hn;i++)
+        if(memcmp(h + i,s,n) == 0)
+            return i;
+    return string::npos;
+}
+
+static size_t naive_rfind(const char* h,size_t hn,const char* s,size_t n,size_t pos)
+{
+    if(n > hn)
+        return string::npos;
+    for(size_t i = pos < hn - n ? pos : hn - n;;i--)
+    {
+        if(memcmp(h + i,s,n) == 0)
+            return i;
+        if(i == 0)
+            return string::npos;
+    }
+}
+
+//覆盖memchr、Horspool和Two-Way三种查找器
+TEST(TestString,Search)
+{
+    unsigned seed = 12345;
+    for(int round = 0;round < 300;round++)
+    {
+        //字母表很小时部分匹配和周期模式串较多
+        const int alpha = 2 + round % 3;
+        const size_t hn = 1 + round * 7 % 500;
+        string hay;
+        for(size_t i = 0;i < hn;i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            hay.push_back(char('a' + (seed >> 16) % alpha));
+        }
+
+        const size_t lens[] = {1,2,3,4,5,8,16,31,32,33,48,64,100};
+        for(size_t k = 0;k < sizeof(lens) / sizeof(lens[0]);k++)
+        {
+            const size_t n = lens[k];
+            if(n > hn)
+                break;
+
+            //模式串一半取自原串，一半随机生成
+            string pat;
+            seed = seed * 1103515245 + 12345;
+            if(round % 2 == 0)
+                pat = hay.substr((seed >> 16) % (hn - n + 1),n);
+            else
+                for(size_t i = 0;i < n;i++)
+                {
+                    seed = seed * 1103515245 + 12345;
+                    pat.push_back(char('a' + (seed >> 16) % alpha));
+                }
+
+            const size_t pos = (seed >> 8) % (hn + 1);
+            EXPECT_EQ(naive_find(hay.c_str(),hn,pat.c_str(),n,0),hay.find(pat));
+            EXPECT_EQ(naive_find(hay.c_str(),hn,pat.c_str(),n,pos),hay.find(pat,pos));
+            EXPECT_EQ(naive_rfind(hay.c_str(),hn,pat.c_str(),n,string::npos),
+                      hay.rfind(pat));
+            EXPECT_EQ(naive_rfind(hay.c_str(),hn,pat.c_str(),n,pos),hay.rfind(pat,pos));
+        }
+    }
+
+    //周期模式串，朴素查找在这种输入下是平方复杂度
+    string hay(4096,'a');
+    string pat(100,'a');
+    pat.push_back('b');
+    EXPECT_EQ(string::npos,hay.find(pat));
+    EXPECT_EQ(string::npos,hay.rfind(pat));
+    hay.push_back('b');
+    EXPECT_EQ(hay.size() - pat.size(),hay.find(pat));
+    EXPECT_EQ(hay.size() - pat.size(),hay.rfind(pat));
+
+    //直接使用查找器
+    const char text[] = "the quick brown fox jumps over the lazy dog";
+    const char* end = text + sizeof(text) - 1;
+    const char needle[] = "the lazy";
+    EXPECT_EQ(text + 31,two_way_searcher<const char*>(needle,needle + 8)(text,end));
+    EXPECT_EQ(text + 31,horspool_searcher<const char*>(needle,needle + 8)(text,end));
+    EXPECT_EQ(text + 31,memchr_searcher<const char*>(needle,needle + 8)(text,end));
+    EXPECT_EQ(end,two_way_searcher<const char*>(needle,needle + 8)(text + 32,end));
+}
+
+//单字符扫描，长度覆盖向量化的主体和尾部
+TEST(TestString,CharScan)
+{
+    for(size_t len = 0;len < 200;len += 7)
+    {
+        string str(len,'x');
+        for(size_t i = 3;i < len;i += 11)
+            str[i] = i % 2 ? ',' : '\n';
+
+        size_t expect_count = 0;
+        size_t first_comma = string::npos;
+        size_t last_comma = string::npos;
+        size_t first_any = string::npos;
+        for(size_t i = 0;i < len;i++)
+        {
+            if(str[i] == ',')
+            {
+                ++expect_count;
+                if(first_comma == string::npos)
+                    first_comma = i;
+                last_comma = i;
+            }
+            if(first_any == string::npos && (str[i] == ',' || str[i] == '\n'))
+                first_any = i;
+        }
+
+        EXPECT_EQ(first_comma,str.find(','));
+        EXPECT_EQ(last_comma,str.rfind(','));
+        EXPECT_EQ(expect_count,str.count(','));
+        EXPECT_EQ(first_any,str.find_any_of2(',','\n'));
+        EXPECT_EQ(first_any,str.find_any_of3(',','\n',';'));
+    }
+
+    string line("key=value;next=1\r\n");
+    EXPECT_EQ(3u,line.find('='));
+    EXPECT_EQ(14u,line.find('=',4));
+    EXPECT_EQ(14u,line.rfind('='));
+    EXPECT_EQ(3u,line.rfind('=',13));
+    EXPECT_EQ(string::npos,line.rfind(';',8));
+    EXPECT_EQ(2u,line.count('='));
+    EXPECT_EQ(1u,line.count('=',4));
+    EXPECT_EQ(0u,line.count('=',100));
+    EXPECT_EQ(9u,line.find_any_of2(';','\n'));
+    EXPECT_EQ(16u,line.find_any_of3('\r','\n','#',10));
+    EXPECT_EQ(string::npos,line.find_any_of2('#','!'));
+    EXPECT_EQ(string::npos,line.find('=',line.size()));
+}
+
+//find_first_of/find_last_of/find_first_not_of/find_last_not_of与逐个比较的结果一致，
+//集合大小覆盖1~3个字符、pcmpestri（不超过16个）和位图
+TEST(TestString,FindOf)
+{
+    unsigned seed = 7;
+    for(int round = 0;round < 200;round++)
+    {
+        string str;
+        const size_t len = round % 90;
+        for(size_t i = 0;i < len;i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            str.push_back(char('a' + (seed >> 16) % 20));
+        }
+
+        string chars;
+        const size_t n = round % 21;
+        for(size_t i = 0;i < n;i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            chars.push_back(char('a' + (seed >> 16) % 20));
+        }
+
+        const size_t pos = (seed >> 8) % (len + 2);
+        size_t first_of = string::npos,first_not_of = string::npos;
+        size_t last_of = string::npos,last_not_of = string::npos;
+        for(size_t i = 0;i < len;i++)
+        {
+            const bool in = memchr(chars.c_str(),str[i],n) != 0;
+            if(i >= pos && in && first_of == string::npos)
+                first_of = i;
+            if(i >= pos && !in && first_not_of == string::npos)
+                first_not_of = i;
+            if(i <= pos && in)
+                last_of = i;
+            if(i <= pos && !in)
+                last_not_of = i;
+        }
+
+        EXPECT_EQ(first_of,str.find_first_of(chars,pos));
+        EXPECT_EQ(first_not_of,str.find_first_not_of(chars,pos));
+        EXPECT_EQ(last_of,str.find_last_of(chars,pos));
+        EXPECT_EQ(last_not_of,str.find_last_not_of(chars,pos));
+
+        const char_set set(chars.c_str(),chars.size());
+        EXPECT_EQ(first_of,str.find_first_of(set,pos));
+        EXPECT_EQ(last_not_of,str.find_last_not_of(set,pos));
+    }
+
+    string str("  key = value\t\n");
+    const char_set space(" \t\r\n");
+    EXPECT_EQ(4u,space.size());
+    EXPECT_TRUE(space.contains('\t'));
+    EXPECT_FALSE(space.contains('k'));
+    EXPECT_EQ(2u,str.find_first_not_of(space));
+    EXPECT_EQ(12u,str.find_last_not_of(space));
+    EXPECT_EQ(5u,str.find_first_of(space,2));
+    EXPECT_EQ(14u,str.find_last_of(space));
+    EXPECT_EQ(0u,str.find_last_of(' ',0));
+    EXPECT_EQ(2u,str.find_first_not_of(' '));
+    EXPECT_EQ(13u,str.find_last_not_of('\n'));
+    EXPECT_EQ(string::npos,string().find_last_of(space));
+    EXPECT_EQ(string::npos,str.find_first_of(""));
+
+    //包含'\0'的集合
+    string bin("ab\0cd",5);
+    EXPECT_EQ(2u,bin.find_first_of(string("\0x",2)));
+    EXPECT_EQ(3u,bin.find_first_not_of(string("ab\0",3)));
+
+    //非char的字符不能截断成字节放进char_set，0x161的低字节与'a'相同
+    typedef basic_string<unsigned short,STL_DEFAULT_ALLOCATOR(unsigned short)> wstring16;
+    wstring16 wide,wset;
+    wide.push_back(0x161);
+    wide.push_back('a');
+    wide.push_back(0x162);
+    wide.push_back('a');
+    wset.push_back('a');
+    EXPECT_EQ(1u,wide.find_first_of(wset));
+    EXPECT_EQ(3u,wide.find_last_of(wset));
+    EXPECT_EQ(0u,wide.find_first_not_of(wset));
+    EXPECT_EQ(2u,wide.find_last_not_of(wset));
+    EXPECT_EQ(2u,wide.find_last_not_of(wset,2));
+    EXPECT_EQ(wstring16::npos,wide.find_first_of(wset,4));
+}
@@ -2,6 +2,10 @@
 
 #include <gtest/gtest.h>
 #include "../vector_imp.h"
+#include "../small_vector_imp.h"
+#include <list>
+#include <sstream>
+#include <iterator>
 
 using namespace mini_stl;
 
@@ -171,3 +175,664 @@ TEST(TestVector,ReverseIterator)
     iter = vect.rbegin();
     EXPECT_EQ(1,*(iter+2));
 }
+
+//没有特化__type_traits的类型走逐个复制的路径
+struct Point
+{
+    int x;
+    int y;
+};
+
+TEST(TestVector,Reallocate)
+{
+    //容量不足时插入vector自身的元素
+    vector<int> vect;
+    vect.push_back(7);
+    for(int i = 0;i < 10;i++)
+        vect.push_back(vect[0]);
+    EXPECT_EQ(11,(int)vect.size());
+    for(int i = 0;i < 11;i++)
+        EXPECT_EQ(7,vect[i]);
+
+    //在中间插入并扩容
+    vector<int> vect1;
+    for(int i = 0;i < 4;i++)
+        vect1.push_back(i);
+    EXPECT_EQ(vect1.size(),vect1.capacity());
+    vect1.insert(vect1.begin()+1,vect1[3]);
+    EXPECT_EQ(0,vect1[0]);
+    EXPECT_EQ(3,vect1[1]);
+    EXPECT_EQ(1,vect1[2]);
+    EXPECT_EQ(3,vect1[4]);
+
+    vect1.insert(vect1.begin()+2,10,vect1[0]);
+    EXPECT_EQ(15,(int)vect1.size());
+    EXPECT_EQ(3,vect1[1]);
+    EXPECT_EQ(0,vect1[2]);
+    EXPECT_EQ(0,vect1[11]);
+    EXPECT_EQ(1,vect1[12]);
+    EXPECT_EQ(3,vect1[14]);
+
+    //大块内存使用realloc
+    vector<double,malloc_alloc> vect2;
+    vect2.reserve(10);
+    for(int i = 0;i < 100000;i++)
+        vect2.push_back(i * 0.5);
+    EXPECT_EQ(100000u,vect2.size());
+    EXPECT_EQ(49999.5,vect2[99999]);
+    vect2.reserve(300000);
+    EXPECT_EQ(300000u,vect2.capacity());
+    EXPECT_EQ(0.5,vect2[1]);
+
+    vector<Point> points;
+    for(int i = 0;i < 100;i++)
+    {
+        Point p = {i,-i};
+        points.insert(points.begin(),p);
+    }
+    EXPECT_EQ(99,points[0].x);
+    EXPECT_EQ(0,points[99].y);
+}
+
+//记录存活对象个数，析构函数不平凡
+struct Counted
+{
+    static int alive;
+    int value;
+
+    Counted(int v = 0) : value(v) { ++alive; }
+    Counted(const Counted& x) : value(x.value) { ++alive; }
+    Counted& operator=(const Counted& x)
+    {
+        value = x.value;
+        return *this;
+    }
+    ~Counted() { --alive; }
+};
+int Counted::alive = 0;
+
+inline bool trait_value(__true_type) { return true; }
+inline bool trait_value(__false_type) { return false; }
+
+TEST(TestVector,TypeTraits)
+{
+    EXPECT_TRUE(trait_value(__type_traits<Point>::is_POD_type()));
+    EXPECT_TRUE(trait_value(__type_traits<Point*>::has_trivial_destructor()));
+    EXPECT_TRUE(trait_value(__type_traits<const int>::has_trivial_copy_constructor()));
+    EXPECT_FALSE(trait_value(__type_traits<Counted>::has_trivial_destructor()));
+    EXPECT_FALSE(trait_value(__type_traits<Counted>::is_trivially_relocatable()));
+
+    //平凡类型走memmove/memset路径
+    vector<char> chars(100,'x');
+    EXPECT_EQ('x',chars[99]);
+    vector<Point> points;
+    for(int i = 0;i < 50;i++)
+    {
+        Point p = {i,-i};
+        points.insert(points.begin(),p);
+    }
+    vector<Point> points1(points);
+    EXPECT_EQ(49,points1[0].x);
+    EXPECT_EQ(0,points1[49].y);
+
+    //非平凡类型仍然逐个构造和析构
+    {
+        vector<Counted> vect(10,Counted(3));
+        for(int i = 0;i < 20;i++)
+            vect.push_back(Counted(i));
+        vector<Counted> vect1(vect);
+        EXPECT_EQ(19,vect1[29].value);
+        vect1.erase(vect1.begin(),vect1.begin() + 10);
+        EXPECT_EQ(0,vect1[0].value);
+    }
+    EXPECT_EQ(0,Counted::alive);
+}
+
+#ifdef STL_CXX11
+//记录复制和移动的次数
+struct Tracked
+{
+    static int copies;
+    static int moves;
+    int value;
+
+    Tracked(int v = 0) : value(v) {}
+    Tracked(const Tracked& x) : value(x.value) { ++copies; }
+    Tracked(Tracked&& x) noexcept : value(x.value) { x.value = -1; ++moves; }
+    Tracked& operator=(const Tracked& x) { value = x.value; ++copies; return *this; }
+    Tracked& operator=(Tracked&& x) noexcept { value = x.value; x.value = -1; ++moves; return *this; }
+};
+int Tracked::copies = 0;
+int Tracked::moves = 0;
+
+TEST(TestVector,Move)
+{
+    vector<Tracked> vect;
+    for(int i = 0;i < 100;i++)
+        vect.emplace_back(i);
+    vect.push_back(Tracked(100));
+    Tracked t(101);
+    vect.push_back(STL_MOVE(t));
+    vect.emplace(vect.begin(),-5);
+    vect.insert(vect.begin() + 1,Tracked(-4));
+    vect.erase(vect.begin() + 2);
+
+    //扩容、插入和删除都只移动元素
+    EXPECT_EQ(0,Tracked::copies);
+    EXPECT_EQ(103,(int)vect.size());
+    EXPECT_EQ(-5,vect[0].value);
+    EXPECT_EQ(-4,vect[1].value);
+    EXPECT_EQ(1,vect[2].value);
+    EXPECT_EQ(101,vect[102].value);
+
+    //移动构造和移动赋值接管存储空间
+    const Tracked* data = vect.begin();
+    vector<Tracked> vect1(STL_MOVE(vect));
+    EXPECT_EQ(data,vect1.begin());
+    EXPECT_TRUE(vect.empty());
+    vector<Tracked> vect2;
+    vect2.push_back(Tracked(7));
+    vect2 = STL_MOVE(vect1);
+    EXPECT_EQ(data,vect2.begin());
+    EXPECT_EQ(0,Tracked::copies);
+
+    //元素是vector
+    vector<vector<int> > nested;
+    for(int i = 0;i < 20;i++)
+    {
+        vector<int> inner(i + 1,i);
+        nested.push_back(STL_MOVE(inner));
+        EXPECT_TRUE(inner.empty());
+    }
+    EXPECT_EQ(19,nested[19][19]);
+
+    //插入vector自身的元素
+    vector<Tracked> self;
+    self.emplace_back(1);
+    for(int i = 0;i < 10;i++)
+        self.push_back(self[0]);
+    for(int i = 0;i < 11;i++)
+        EXPECT_EQ(1,self[i].value);
+}
+#endif
+
+TEST(TestVector,TrivialCopy)
+{
+    //中间插入和删除，元素搬移使用memmove
+    vector<int> vect;
+    for(int i = 0;i < 1000;i++)
+        vect.push_back(i);
+    vect.reserve(2000);
+    vect.insert(vect.begin() + 500,3,-1);
+    EXPECT_EQ(499,vect[499]);
+    EXPECT_EQ(-1,vect[502]);
+    EXPECT_EQ(500,vect[503]);
+    EXPECT_EQ(999,vect[1002]);
+    vect.erase(vect.begin() + 500,vect.begin() + 503);
+    for(int i = 0;i < 1000;i++)
+        EXPECT_EQ(i,vect[i]);
+
+    //赋值覆盖已有元素
+    vector<int> vect1(10,7);
+    vect1 = vect;
+    EXPECT_EQ(1000,(int)vect1.size());
+    EXPECT_EQ(999,vect1[999]);
+
+    //单字节类型使用memset，多字节类型使用向量化的循环
+    vector<char> chars(10,'a');
+    chars.assign(5,'b');
+    EXPECT_EQ(5,(int)chars.size());
+    EXPECT_EQ('b',chars[4]);
+    vector<short> shorts(100,1);
+    shorts.assign(50,-2);
+    EXPECT_EQ(-2,shorts[49]);
+    fill_n(shorts.begin(),10,3);
+    EXPECT_EQ(3,shorts[9]);
+    EXPECT_EQ(-2,shorts[10]);
+}
+
+inline bool is_random_access(random_access_iterator_tag) { return true; }
+inline bool is_random_access(input_iterator_tag) { return false; }
+
+TEST(TestVector,Iterator)
+{
+    vector<int> vect;
+    for(int i = 0;i < 10;i++)
+        vect.push_back(i);
+
+    EXPECT_TRUE(is_random_access(iterator_category(vect.begin())));
+    EXPECT_TRUE(is_random_access(iterator_category(vect.rbegin())));
+    EXPECT_EQ(10,distance(vect.begin(),vect.end()));
+    EXPECT_EQ(10,distance(vect.rbegin(),vect.rend()));
+
+    vector<int>::iterator iter = vect.begin();
+    advance(iter,7);
+    EXPECT_EQ(7,*iter);
+    advance(iter,-3);
+    EXPECT_EQ(4,*iter);
+
+    //逆向迭代器
+    vector<int>::reverse_iterator riter = vect.rbegin();
+    EXPECT_EQ(9,*riter);
+    riter += 2;
+    EXPECT_EQ(7,*riter);
+    EXPECT_EQ(2,riter - vect.rbegin());
+    EXPECT_TRUE(vect.rbegin() < riter);
+    EXPECT_EQ(0,*(vect.rend() - 1));
+}
+
+//与逐个元素比较的结果一致
+template<class Tp>
+void check_compare(const vector<Tp>& x,const vector<Tp>& y)
+{
+    bool less = false;
+    size_t i = 0;
+    for(;i < x.size() && i < y.size();i++)
+        if(x[i] != y[i])
+            break;
+    if(i < x.size() && i < y.size())
+        less = x[i] < y[i];
+    else
+        less = x.size() < y.size();
+
+    EXPECT_EQ(less,x < y);
+    EXPECT_EQ(x.size() == y.size() && i == x.size(),x == y);
+}
+
+TEST(TestVector,Compare)
+{
+    vector<int> a;
+    vector<int> b;
+    EXPECT_TRUE(a == b);
+    EXPECT_FALSE(a < b);
+
+    for(int i = 0;i < 100;i++)
+    {
+        a.push_back(i - 50);
+        b.push_back(i - 50);
+    }
+    EXPECT_TRUE(a == b);
+    EXPECT_TRUE(a <= b);
+    b[70] = -1000;      //负数小于正数，不能按字节比较大小
+    EXPECT_TRUE(a != b);
+    EXPECT_TRUE(b < a);
+    EXPECT_TRUE(a > b);
+    b[70] = a[70];
+    b.pop_back();
+    EXPECT_TRUE(b < a);
+
+    //无符号字节大于127
+    vector<unsigned char> c(40,200);
+    vector<unsigned char> d(40,200);
+    d[33] = 10;
+    EXPECT_TRUE(d < c);
+    EXPECT_FALSE(c < d);
+
+    //随机数据在不同位置出现第一个不同的元素
+    srand(1);
+    for(int round = 0;round < 200;round++)
+    {
+        const int n = rand() % 70;
+        vector<int> x,y;
+        vector<char> cx,cy;
+        vector<long long> lx,ly;
+        vector<double> dx,dy;
+        for(int i = 0;i < n;i++)
+        {
+            const int v = rand() % 3 - 1;
+            x.push_back(v);
+            cx.push_back((char)(v * 100));
+            lx.push_back(v * 1000000000000LL);
+            dx.push_back(v * 0.5);
+        }
+        y = x;
+        ly = lx;
+        dy = dx;
+        cy = cx;
+        if(n > 0 && round % 3 != 0)
+        {
+            const int pos = rand() % n;
+            y[pos] = rand() % 3 - 1;
+            cy[pos] = (char)(y[pos] * 100);
+            ly[pos] = y[pos] * 1000000000000LL;
+            dy[pos] = y[pos] * 0.5;
+        }
+        if(round % 5 == 0)
+        {
+            y.push_back(0);
+            cy.push_back(0);
+            ly.push_back(0);
+            dy.push_back(0);
+        }
+        check_compare(x,y);
+        check_compare(y,x);
+        check_compare(cx,cy);
+        check_compare(lx,ly);
+        check_compare(dy,dx);
+    }
+}
+
+//元素是否在对象内部
+template<class Vector>
+bool points_inside(const Vector& v)
+{
+    const char* p = (const char*)v.begin();
+    return p >= (const char*)&v && p < (const char*)(&v + 1);
+}
+
+TEST(TestSmallVector,Basic)
+{
+    small_vector<int,8> vect;
+    EXPECT_TRUE(vect.empty());
+    EXPECT_EQ(8,(int)vect.capacity());
+    EXPECT_TRUE(vect.is_inline());
+
+    for(int i = 0;i < 8;i++)
+        vect.push_back(i);
+    EXPECT_TRUE(vect.is_inline());
+    EXPECT_TRUE(points_inside(vect));
+
+    //超过N个元素后转到堆上
+    vect.push_back(8);
+    EXPECT_FALSE(vect.is_inline());
+    EXPECT_FALSE(points_inside(vect));
+    EXPECT_EQ(16,(int)vect.capacity());
+    for(int i = 0;i < 9;i++)
+        EXPECT_EQ(i,vect[i]);
+
+    //vector的插入和删除
+    vect.insert(vect.begin(),-1);
+    vect.insert(vect.begin() + 5,3,100);
+    vect.erase(vect.begin() + 1);
+    EXPECT_EQ(12,(int)vect.size());
+    EXPECT_EQ(-1,vect.front());
+    EXPECT_EQ(100,vect[4]);
+    EXPECT_EQ(4,vect[7]);
+    EXPECT_EQ(8,vect.back());
+
+    //复制：元素不超过N个时使用内部缓冲区
+    small_vector<int,8> copy(vect);
+    EXPECT_TRUE(copy == vect);
+    EXPECT_FALSE(copy.is_inline());
+    small_vector<int,8> small(vect.begin(),vect.begin() + 3);
+    EXPECT_TRUE(small.is_inline());
+    EXPECT_TRUE(small < vect);
+    copy = small;
+    EXPECT_TRUE(copy == small);
+
+    small.assign(20,7);
+    EXPECT_FALSE(small.is_inline());
+    EXPECT_EQ(20,(int)small.size());
+    EXPECT_EQ(7,small[19]);
+
+    small_vector<int,4> filled(4,1);
+    EXPECT_TRUE(filled.is_inline());
+    filled.reserve(5);
+    EXPECT_FALSE(filled.is_inline());
+    EXPECT_EQ(1,filled[3]);
+}
+
+TEST(TestSmallVector,Swap)
+{
+    typedef small_vector<vector<int>,3> vector_type;
+    vector_type a,b,c,d;
+    for(int i = 0;i < 2;i++)
+        a.push_back(vector<int>(i + 1,i));
+    for(int i = 0;i < 3;i++)
+        b.push_back(vector<int>(i + 1,10 + i));
+    for(int i = 0;i < 5;i++)
+        c.push_back(vector<int>(i + 1,20 + i));
+    for(int i = 0;i < 6;i++)
+        d.push_back(vector<int>(i + 1,30 + i));
+
+    //都在内部缓冲区
+    a.swap(b);
+    EXPECT_EQ(3,(int)a.size());
+    EXPECT_EQ(2,(int)b.size());
+    EXPECT_EQ(12,a[2][2]);
+    EXPECT_EQ(1,b[1][1]);
+    EXPECT_TRUE(a.is_inline() && b.is_inline());
+
+    //内部缓冲区和堆
+    const vector<int>* heap = c.begin();
+    a.swap(c);
+    EXPECT_EQ(heap,a.begin());
+    EXPECT_TRUE(c.is_inline());
+    EXPECT_EQ(3,(int)c.size());
+    EXPECT_EQ(12,c[2][0]);
+    EXPECT_EQ(24,a[4][4]);
+    swap(d,b);
+    EXPECT_TRUE(d.is_inline());
+    EXPECT_EQ(1,d[1][0]);
+    EXPECT_EQ(35,b[5][5]);
+
+    //都在堆上
+    const vector<int>* heap_a = a.begin();
+    const vector<int>* heap_b = b.begin();
+    a.swap(b);
+    EXPECT_EQ(heap_b,a.begin());
+    EXPECT_EQ(heap_a,b.begin());
+}
+
+#ifdef STL_CXX11
+TEST(TestSmallVector,Move)
+{
+    Tracked::copies = 0;
+    small_vector<Tracked,4> inline_vect;
+    for(int i = 0;i < 3;i++)
+        inline_vect.emplace_back(i);
+
+    //内部缓冲区中的元素逐个移动
+    small_vector<Tracked,4> vect1(STL_MOVE(inline_vect));
+    EXPECT_TRUE(inline_vect.empty());
+    EXPECT_TRUE(vect1.is_inline());
+    EXPECT_EQ(2,vect1[2].value);
+
+    //堆空间直接接管
+    small_vector<Tracked,4> heap_vect;
+    for(int i = 0;i < 10;i++)
+        heap_vect.emplace_back(i);
+    const Tracked* data = heap_vect.begin();
+    small_vector<Tracked,4> vect2(STL_MOVE(heap_vect));
+    EXPECT_EQ(data,vect2.begin());
+    EXPECT_TRUE(heap_vect.empty());
+    EXPECT_TRUE(heap_vect.is_inline());
+
+    vect1 = STL_MOVE(vect2);
+    EXPECT_EQ(data,vect1.begin());
+    EXPECT_EQ(9,vect1[9].value);
+    vect2.push_back(Tracked(1));
+    vect1 = STL_MOVE(vect2);
+    EXPECT_TRUE(vect1.is_inline());
+    EXPECT_EQ(1,(int)vect1.size());
+    EXPECT_EQ(0,Tracked::copies);
+
+    small_vector<small_vector<int,2>,2> nested;
+    for(int i = 0;i < 5;i++)
+        nested.push_back(small_vector<int,2>(i + 1,i));
+    EXPECT_EQ(4,nested[4][4]);
+}
+#endif
+
+TEST(TestStaticVector,Basic)
+{
+    static_vector<int,4> vect;
+    EXPECT_EQ(4,(int)vect.capacity());
+    EXPECT_EQ(4,(int)vect.max_size());
+    for(int i = 0;i < 4;i++)
+        vect.push_back(i);
+    EXPECT_TRUE(points_inside(vect));
+
+    //超出容量时抛出异常，原有元素不变
+    EXPECT_THROW(vect.push_back(4),std::length_error);
+    EXPECT_THROW(vect.insert(vect.begin(),2,9),std::length_error);
+    EXPECT_THROW(vect.reserve(5),std::length_error);
+    EXPECT_THROW((static_vector<int,4>(5,0)),std::length_error);
+    EXPECT_EQ(4,(int)vect.size());
+    EXPECT_EQ(3,vect[3]);
+
+    vect.erase(vect.begin());
+    vect.insert(vect.begin() + 1,7);
+    EXPECT_EQ(1,vect[0]);
+    EXPECT_EQ(7,vect[1]);
+    EXPECT_EQ(3,vect[3]);
+
+    static_vector<vector<int>,3> a,b;
+    a.push_back(vector<int>(3,1));
+    b.push_back(vector<int>(2,2));
+    b.push_back(vector<int>(1,3));
+    a.swap(b);
+    EXPECT_EQ(2,(int)a.size());
+    EXPECT_EQ(3,a[1][0]);
+    EXPECT_EQ(1,b[0][2]);
+    static_vector<vector<int>,3> c(a);
+    EXPECT_TRUE(c == a);
+    EXPECT_TRUE(points_inside(c));
+}
+
+TEST(TestVector,DefaultInit)
+{
+    //平凡类型不清零，原有元素保留
+    vector<int> vect(3,7);
+    vect.resize_default_init(1000);
+    EXPECT_EQ(1000,(int)vect.size());
+    EXPECT_EQ(7,vect[2]);
+    for(int i = 0;i < 1000;i++)
+        vect[i] = i;
+    vect.resize_default_init(10);
+    EXPECT_EQ(10,(int)vect.size());
+    EXPECT_EQ(9,vect.back());
+
+    //先预留再写入，最后提交
+    const char text[] = "0123456789";
+    vector<char> buf;
+    for(int round = 0;round < 100;round++)
+    {
+        char* p = buf.append_uninitialized(10);
+        EXPECT_EQ(buf.end(),p);
+        memcpy(p,text,10);
+        buf.commit(10);
+    }
+    EXPECT_EQ(1000,(int)buf.size());
+    EXPECT_EQ('5',buf[995]);
+    char* p = buf.append_uninitialized(24);
+    buf.commit(0);
+    EXPECT_EQ(1000,(int)buf.size());
+    EXPECT_TRUE(buf.capacity() >= 1024u);
+    EXPECT_EQ(buf.end(),p);
+    EXPECT_THROW(buf.append_uninitialized(buf.max_size()),std::length_error);
+    EXPECT_EQ(1000,(int)buf.size());
+
+    //不平凡的类型逐个默认构造
+    vector<vector<int> > nested(2,vector<int>(3,1));
+    nested.resize_default_init(5);
+    EXPECT_EQ(5,(int)nested.size());
+    EXPECT_TRUE(nested[4].empty());
+    EXPECT_EQ(3,(int)nested[1].size());
+
+    small_vector<int,4> small;
+    small.resize_default_init(3);
+    EXPECT_TRUE(small.is_inline());
+    int* q = small.append_uninitialized(2);
+    q[0] = 1;
+    q[1] = 2;
+    small.commit(2);
+    EXPECT_FALSE(small.is_inline());
+    EXPECT_EQ(2,small[4]);
+}
+
+//只能遍历一次的输入迭代器：依次产生[value,last)
+struct counting_input_iterator
+{
+    typedef input_iterator_tag iterator_category;
+    typedef int value_type;
+    typedef ptrdiff_t difference_type;
+    typedef const int* pointer;
+    typedef const int& reference;
+
+    int value;
+
+    explicit counting_input_iterator(int v) : value(v) {}
+    const int& operator*() const { return value; }
+    counting_input_iterator& operator++() { ++value; return *this; }
+    bool operator==(const counting_input_iterator& x) const { return value == x.value; }
+    bool operator!=(const counting_input_iterator& x) const { return value != x.value; }
+};
+
+TEST(TestVector,RangeInsert)
+{
+    //两个整数参数仍然是n个value
+    vector<int> fill(3,7);
+    EXPECT_EQ(3,(int)fill.size());
+    EXPECT_EQ(7,fill[2]);
+    fill.insert(fill.begin(),2,5);
+    fill.assign(4,1);
+    EXPECT_EQ(4,(int)fill.size());
+    EXPECT_EQ(1,fill[3]);
+
+    //前向迭代器：只分配一次，容量等于元素个数
+    std::list<int> lst;
+    for(int i = 0;i < 10;i++)
+        lst.push_back(i);
+    vector<int> from_list(lst.begin(),lst.end());
+    EXPECT_EQ(10,(int)from_list.size());
+    EXPECT_EQ(10,(int)from_list.capacity());
+    EXPECT_EQ(9,from_list[9]);
+
+    //插入到中间，空间足够与不足两种情况
+    from_list.reserve(30);
+    from_list.insert(from_list.begin() + 2,lst.begin(),lst.end());
+    EXPECT_EQ(20,(int)from_list.size());
+    EXPECT_EQ(0,from_list[2]);
+    EXPECT_EQ(9,from_list[11]);
+    EXPECT_EQ(2,from_list[12]);
+    from_list.insert(from_list.begin() + 19,lst.begin(),lst.end());
+    EXPECT_EQ(30,(int)from_list.size());
+    EXPECT_EQ(9,from_list[28]);
+    EXPECT_EQ(9,from_list[29]);
+    from_list.insert(from_list.begin(),lst.begin(),lst.end());
+    EXPECT_EQ(40,(int)from_list.size());
+    EXPECT_EQ(9,from_list[9]);
+    EXPECT_EQ(0,from_list[10]);
+
+    //输入迭代器：添加到最后再旋转到插入位置
+    vector<int> vect(counting_input_iterator(0),counting_input_iterator(5));
+    EXPECT_EQ(5,(int)vect.size());
+    vect.insert(vect.begin() + 1,counting_input_iterator(100),counting_input_iterator(103));
+    const int expected[] = {0,100,101,102,1,2,3,4};
+    EXPECT_EQ(8,(int)vect.size());
+    for(int i = 0;i < 8;i++)
+        EXPECT_EQ(expected[i],vect[i]);
+
+    std::istringstream in("4 5 6 7");
+    vector<int> parsed;
+    parsed.push_back(1);
+    parsed.insert(parsed.begin(),std::istream_iterator<int>(in),std::istream_iterator<int>());
+    EXPECT_EQ(5,(int)parsed.size());
+    EXPECT_EQ(4,parsed[0]);
+    EXPECT_EQ(1,parsed[4]);
+
+    //assign：输入迭代器覆盖已有元素，前向迭代器按长度分三种情况
+    parsed.assign(counting_input_iterator(10),counting_input_iterator(12));
+    EXPECT_EQ(2,(int)parsed.size());
+    EXPECT_EQ(11,parsed[1]);
+    parsed.assign(counting_input_iterator(20),counting_input_iterator(40));
+    EXPECT_EQ(20,(int)parsed.size());
+    EXPECT_EQ(39,parsed[19]);
+    parsed.assign(lst.begin(),lst.end());
+    EXPECT_EQ(10,(int)parsed.size());
+    EXPECT_EQ(9,parsed[9]);
+    vector<vector<int> > nested(3,vector<int>(2,1));
+    std::list<vector<int> > rows(5,vector<int>(4,2));
+    nested.assign(rows.begin(),rows.end());
+    EXPECT_EQ(5,(int)nested.size());
+    EXPECT_EQ(2,nested[4][3]);
+    nested.insert(nested.begin() + 1,rows.begin(),rows.end());
+    EXPECT_EQ(10,(int)nested.size());
+
+    small_vector<int,4> small(lst.begin(),lst.end());
+    EXPECT_EQ(10,(int)small.size());
+    small_vector<int,4> small_fill(2,3);
+    EXPECT_TRUE(small_fill.is_inline());
+    EXPECT_EQ(3,small_fill[1]);
+}
@@ -0,0 +1,368 @@
+//thread_alloc_imp.h
+//线程缓存分配器：每个线程持有各大小类的自由链表，
+//线程之间通过中心缓存按批交换对象
+
+#ifndef THREAD_ALLOC_IMP_H
+#define THREAD_ALLOC_IMP_H
+
+#include "configure.h"
+#include "alloc_imp.h"
+
+#ifndef STL_CXX11
+#   error "thread_alloc_imp.h requires C++11 thread_local"
+#endif
+
+#include <mutex>
+
+STL_BEGIN_NAMESPACE
+
+///////////////////////////
+//线程缓存分配器
+//1.小于等于THREAD_MAX_BYTES的对象按8字节分类，分配和释放只操作本线程的
+//  自由链表，不加锁。
+//2.本线程链表为空时从中心缓存取一批对象；链表过长时把一批对象还给中心缓存。
+//  中心缓存每个大小类一把锁，一次加锁移动一整批，跨线程释放不会逐个争用。
+//3.中心缓存也没有对象时，从全局内存池切出一批新对象。
+//4.线程退出时，本线程缓存的对象全部还给中心缓存，供其他线程使用。
+//5.大对象直接交给malloc_alloc。
+enum {THREAD_MAX_BYTES = 256};
+enum {THREAD_NCLASSES = THREAD_MAX_BYTES / ALIGN};
+enum {THREAD_NSLOTS = 64};                  //中心缓存每个大小类保存的批数
+enum {THREAD_CACHE_BATCHES = 8};            //线程缓存每个大小类最多保存的批数
+enum {THREAD_CHUNK_BYTES = 64 * 1024};      //内存池每次向系统申请的大小
+
+template<int inst>
+class thread_alloc_template
+{
+private:
+    union obj
+    {
+        union obj* free_list_link;
+        char client_data[1];
+    };
+
+    static size_t class_index(size_t bytes)
+    {
+        return (bytes + ALIGN - 1) / ALIGN - 1;
+    }
+
+    static size_t class_size(size_t index)
+    {
+        return (index + 1) * ALIGN;
+    }
+
+    //每批对象个数，小对象一批多一些
+    static size_t batch_size(size_t index)
+    {
+        size_t n = 4096 / class_size(index);
+        return n < 8 ? 8 : (n > 64 ? 64 : n);
+    }
+
+    //中心缓存中的一个大小类
+    //slots中每个元素是一条恰好batch_size个对象的链表，整批存取为O(1)；
+    //slots放满后多余的对象挂到spill链表上
+    struct central_list
+    {
+        std::mutex lock;
+        size_t nslots;
+        obj* slots[THREAD_NSLOTS];
+        obj* spill;
+        size_t spill_length;
+    };
+
+    //线程本地缓存
+    struct thread_cache
+    {
+        obj* free_list[THREAD_NCLASSES];
+        size_t length[THREAD_NCLASSES];
+
+        thread_cache()
+        {
+            for(size_t i = 0;i < THREAD_NCLASSES;i++)
+            {
+                free_list[i] = 0;
+                length[i] = 0;
+            }
+        }
+
+        //线程退出，对象全部还给中心缓存
+        ~thread_cache()
+        {
+            t_cache = 0;
+            t_destroyed = true;
+            for(size_t i = 0;i < THREAD_NCLASSES;i++)
+            {
+                if(free_list[i] != 0)
+                    s_release_list(i,free_list[i]);
+                free_list[i] = 0;
+                length[i] = 0;
+            }
+        }
+    };
+    friend struct thread_cache;
+
+    static central_list s_central[THREAD_NCLASSES];
+
+    //全局内存池
+    //STL_mutex_lock在没有定义STL_THREADS时不加锁，这里总是使用std::mutex
+    static std::mutex s_pool_lock;
+    static char* s_start_free;
+    static char* s_end_free;
+
+    //快速路径只读取这个指针；线程缓存析构后为0
+    static STL_THREAD_LOCAL thread_cache* t_cache;
+    static STL_THREAD_LOCAL bool t_destroyed;
+
+    //获取本线程缓存，线程退出过程中返回0
+    static thread_cache* s_local_cache()
+    {
+        thread_cache* tc = t_cache;
+        if(tc != 0 || t_destroyed)
+            return tc;
+
+        static STL_THREAD_LOCAL thread_cache cache;
+        t_cache = &cache;
+        return &cache;
+    }
+
+    //从内存池切出n个index类对象，连成以0结尾的链表
+    static obj* s_carve(size_t index,size_t n);
+
+    //从中心缓存取一批对象，返回链表头，count为对象个数
+    static obj* s_fetch_batch(size_t index,size_t& count);
+
+    //把一条链表还给中心缓存，count为0表示长度未知
+    static void s_release_list(size_t index,obj* head,size_t count = 0);
+
+    static void s_release_batch(thread_cache* tc,size_t index);
+
+public:
+    static void* allocate(size_t n)
+    {
+        if(n > (size_t)THREAD_MAX_BYTES)
+            return malloc_alloc::allocate(n);
+
+        const size_t index = class_index(n);
+        thread_cache* tc = s_local_cache();
+
+        if(tc != 0)
+        {
+            obj* result = tc->free_list[index];
+            if(result != 0)
+            {
+                tc->free_list[index] = result->free_list_link;
+                --tc->length[index];
+                return result;
+            }
+        }
+
+        //本线程没有可用对象
+        size_t count;
+        obj* head = s_fetch_batch(index,count);
+        obj* rest = head->free_list_link;
+        if(tc != 0)
+        {
+            tc->free_list[index] = rest;
+            tc->length[index] = count - 1;
+        }
+        else if(rest != 0)
+        {
+            s_release_list(index,rest,count - 1);
+        }
+
+        return head;
+    }
+
+    static void deallocate(void* p,size_t n)
+    {
+        if(n > (size_t)THREAD_MAX_BYTES)
+        {
+            malloc_alloc::deallocate(p,n);
+            return;
+        }
+
+        const size_t index = class_index(n);
+        obj* q = (obj*)p;
+        thread_cache* tc = s_local_cache();
+
+        if(tc == 0)
+        {
+            q->free_list_link = 0;
+            s_release_list(index,q,1);
+            return;
+        }
+
+        q->free_list_link = tc->free_list[index];
+        tc->free_list[index] = q;
+
+        //保留最多THREAD_CACHE_BATCHES批，多余的一批还给中心缓存
+        if(++tc->length[index] > THREAD_CACHE_BATCHES * batch_size(index))
+            s_release_batch(tc,index);
+    }
+};
+
+template<int inst>
+typename thread_alloc_template<inst>::obj*
+thread_alloc_template<inst>::s_carve(size_t index,size_t n)
+{
+    const size_t size = class_size(index);
+    const size_t total = size * n;
+    char* chunk;
+    char* left = 0;
+    size_t bytes_left = 0;
+
+    s_pool_lock.lock();
+    if((size_t)(s_end_free - s_start_free) < total)
+    {
+        char* new_chunk;
+        STL_TRY
+        {
+            new_chunk = (char*)malloc_alloc::allocate(THREAD_CHUNK_BYTES);
+        }
+        STL_UNWIND(s_pool_lock.unlock());
+
+        //内存池的零头稍后还给对应的大小类
+        left = s_start_free;
+        bytes_left = s_end_free - s_start_free;
+        s_start_free = new_chunk;
+        s_end_free = new_chunk + THREAD_CHUNK_BYTES;
+    }
+    chunk = s_start_free;
+    s_start_free += total;
+    s_pool_lock.unlock();
+
+    //零头可能超过最大的大小类，切成多个对象
+    while(bytes_left >= (size_t)ALIGN)
+    {
+        const size_t piece = bytes_left > (size_t)THREAD_MAX_BYTES ?
+                    (size_t)THREAD_MAX_BYTES : bytes_left;
+        ((obj*)left)->free_list_link = 0;
+        s_release_list(class_index(piece),(obj*)left,1);
+        left += piece;
+        bytes_left -= piece;
+    }
+
+    //在锁外把对象连成链表
+    obj* head = (obj*)chunk;
+    obj* cur = head;
+    for(size_t i = 1;i < n;i++)
+    {
+        obj* next = (obj*)(chunk + i * size);
+        cur->free_list_link = next;
+        cur = next;
+    }
+    cur->free_list_link = 0;
+
+    return head;
+}
+
+template<int inst>
+typename thread_alloc_template<inst>::obj*
+thread_alloc_template<inst>::s_fetch_batch(size_t index,size_t& count)
+{
+    central_list& central = s_central[index];
+    const size_t batch = batch_size(index);
+
+    central.lock.lock();
+    if(central.nslots > 0)
+    {
+        obj* head = central.slots[--central.nslots];
+        central.lock.unlock();
+        count = batch;
+        return head;
+    }
+
+    if(central.spill != 0)
+    {
+        //从spill链表取最多一批
+        obj* head = central.spill;
+        obj* tail = head;
+        count = 1;
+        while(count < batch && tail->free_list_link != 0)
+        {
+            tail = tail->free_list_link;
+            ++count;
+        }
+        central.spill = tail->free_list_link;
+        central.spill_length -= count;
+        tail->free_list_link = 0;
+        central.lock.unlock();
+        return head;
+    }
+    central.lock.unlock();
+
+    count = batch;
+    return s_carve(index,batch);
+}
+
+template<int inst>
+void thread_alloc_template<inst>::s_release_list(size_t index,obj* head,size_t count)
+{
+    //找到链表尾，在锁外完成
+    obj* tail = head;
+    size_t n = 1;
+    while(tail->free_list_link != 0)
+    {
+        tail = tail->free_list_link;
+        ++n;
+    }
+    if(count == 0)
+        count = n;
+
+    central_list& central = s_central[index];
+    central.lock.lock();
+    if(count == batch_size(index) && central.nslots < (size_t)THREAD_NSLOTS)
+    {
+        central.slots[central.nslots++] = head;
+    }
+    else
+    {
+        tail->free_list_link = central.spill;
+        central.spill = head;
+        central.spill_length += count;
+    }
+    central.lock.unlock();
+}
+
+template<int inst>
+void thread_alloc_template<inst>::s_release_batch(thread_cache* tc,size_t index)
+{
+    //摘下链表头部的一批对象
+    const size_t batch = batch_size(index);
+    obj* head = tc->free_list[index];
+    obj* tail = head;
+    for(size_t i = 1;i < batch;i++)
+        tail = tail->free_list_link;
+
+    tc->free_list[index] = tail->free_list_link;
+    tc->length[index] -= batch;
+    tail->free_list_link = 0;
+
+    s_release_list(index,head,batch);
+}
+
+template<int inst>
+typename thread_alloc_template<inst>::central_list
+thread_alloc_template<inst>::s_central[THREAD_NCLASSES];
+
+template<int inst>
+std::mutex thread_alloc_template<inst>::s_pool_lock;
+
+template<int inst>
+char* thread_alloc_template<inst>::s_start_free = 0;
+
+template<int inst>
+char* thread_alloc_template<inst>::s_end_free = 0;
+
+template<int inst>
+STL_THREAD_LOCAL typename thread_alloc_template<inst>::thread_cache*
+thread_alloc_template<inst>::t_cache = 0;
+
+template<int inst>
+STL_THREAD_LOCAL bool thread_alloc_template<inst>::t_destroyed = false;
+
+typedef thread_alloc_template<0> thread_alloc;
+
+STL_END_NAMESPACE
+
+#endif // THREAD_ALLOC_IMP_H
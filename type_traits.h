@@ -0,0 +1,141 @@
+//type_traits.h
+//类型特性，用于在编译期选择更快的实现
+
+#ifndef TYPE_TRAITS_H
+#define TYPE_TRAITS_H
+
+#include "configure.h"
+
+STL_BEGIN_NAMESPACE
+
+struct __true_type {};
+struct __false_type {};
+
+//两个特性同时成立
+template<class A,class B>
+struct __and_type
+{
+    typedef __false_type type;
+};
+
+STL_TEMPLATE_NULL
+struct __and_type<__true_type,__true_type>
+{
+    typedef __true_type type;
+};
+
+//编译期布尔值转换为__true_type/__false_type
+template<bool b>
+struct __bool_type
+{
+    typedef __false_type type;
+};
+
+STL_TEMPLATE_NULL
+struct __bool_type<true>
+{
+    typedef __true_type type;
+};
+
+//////////////////////////////////////////
+//__type_traits：对象的构造、复制、赋值、析构是否平凡
+//平凡的操作可以用memmove/memset代替，或者完全省略。
+//is_trivially_relocatable：对象可以用memcpy/realloc搬到新地址，
+//搬移后原地址上的对象不再析构。
+//编译器支持时自动识别用户定义的平凡类型，否则自定义类型全部为__false_type，
+//可以为自己的类型特化__type_traits。
+template<class Tp>
+struct __type_traits
+{
+#ifdef STL_HAS_TYPE_TRAITS_INTRINSICS
+    typedef typename __bool_type<__has_trivial_constructor(Tp)>::type has_trivial_default_constructor;
+    typedef typename __bool_type<__has_trivial_copy(Tp)>::type has_trivial_copy_constructor;
+    typedef typename __bool_type<__has_trivial_assign(Tp)>::type has_trivial_assignment_operator;
+    typedef typename __bool_type<__has_trivial_destructor(Tp)>::type has_trivial_destructor;
+    typedef typename __bool_type<__is_pod(Tp)>::type is_POD_type;
+    typedef typename __and_type<has_trivial_copy_constructor,
+                                has_trivial_destructor>::type is_trivially_relocatable;
+#else
+    typedef __false_type has_trivial_default_constructor;
+    typedef __false_type has_trivial_copy_constructor;
+    typedef __false_type has_trivial_assignment_operator;
+    typedef __false_type has_trivial_destructor;
+    typedef __false_type is_POD_type;
+    typedef __false_type is_trivially_relocatable;
+#endif
+};
+
+//所有特性都成立的类型
+struct __trivial_type_traits
+{
+    typedef __true_type has_trivial_default_constructor;
+    typedef __true_type has_trivial_copy_constructor;
+    typedef __true_type has_trivial_assignment_operator;
+    typedef __true_type has_trivial_destructor;
+    typedef __true_type is_POD_type;
+    typedef __true_type is_trivially_relocatable;
+};
+
+#define STL_DEFINE_SCALAR_TRAITS(Tp) \
+    STL_TEMPLATE_NULL struct __type_traits<Tp> : public __trivial_type_traits {};
+
+STL_DEFINE_SCALAR_TRAITS(bool)
+STL_DEFINE_SCALAR_TRAITS(char)
+STL_DEFINE_SCALAR_TRAITS(signed char)
+STL_DEFINE_SCALAR_TRAITS(unsigned char)
+STL_DEFINE_SCALAR_TRAITS(wchar_t)
+STL_DEFINE_SCALAR_TRAITS(short)
+STL_DEFINE_SCALAR_TRAITS(unsigned short)
+STL_DEFINE_SCALAR_TRAITS(int)
+STL_DEFINE_SCALAR_TRAITS(unsigned int)
+STL_DEFINE_SCALAR_TRAITS(long)
+STL_DEFINE_SCALAR_TRAITS(unsigned long)
+STL_DEFINE_SCALAR_TRAITS(long long)
+STL_DEFINE_SCALAR_TRAITS(unsigned long long)
+STL_DEFINE_SCALAR_TRAITS(float)
+STL_DEFINE_SCALAR_TRAITS(double)
+STL_DEFINE_SCALAR_TRAITS(long double)
+
+#undef STL_DEFINE_SCALAR_TRAITS
+
+//指针
+template<class Tp>
+struct __type_traits<Tp*> : public __trivial_type_traits {};
+
+//const对象的特性与原类型相同
+template<class Tp>
+struct __type_traits<const Tp> : public __type_traits<Tp> {};
+
+//////////////////////////////////////////
+//__is_integer：整数类型的对象可以按字节比较是否相等
+template<class Tp>
+struct __is_integer
+{
+    typedef __false_type integral;
+};
+
+#define STL_DEFINE_INTEGER(Tp) \
+    STL_TEMPLATE_NULL struct __is_integer<Tp> \
+    { \
+        typedef __true_type integral; \
+    };
+
+STL_DEFINE_INTEGER(bool)
+STL_DEFINE_INTEGER(char)
+STL_DEFINE_INTEGER(signed char)
+STL_DEFINE_INTEGER(unsigned char)
+STL_DEFINE_INTEGER(wchar_t)
+STL_DEFINE_INTEGER(short)
+STL_DEFINE_INTEGER(unsigned short)
+STL_DEFINE_INTEGER(int)
+STL_DEFINE_INTEGER(unsigned int)
+STL_DEFINE_INTEGER(long)
+STL_DEFINE_INTEGER(unsigned long)
+STL_DEFINE_INTEGER(long long)
+STL_DEFINE_INTEGER(unsigned long long)
+
+#undef STL_DEFINE_INTEGER
+
+STL_END_NAMESPACE
+
+#endif // TYPE_TRAITS_H
@@ -4,11 +4,12 @@
 #define STL_UINITIALIZED_H
 
 #include "configure.h"
+#include "type_traits.h"
+#include "construct.h"
+#include "algobase.h"
 
 STL_BEGIN_NAMESPACE
 
-#include "construct.h"
-
 //这个函数会将first到last的数据区域复制到result开始区域，
 //返回被复制区域的结束位置。
 //注意:这个函数是不安全的，没有对数据重叠区进行保护
@@ -27,6 +28,141 @@ inline ForwardIter uninitialized_copy(InputIter first,InputIter last,
     STL_UNWIND(destroy(result,cur));
 }
 
+template<class Tp>
+inline Tp* __uninitialized_copy_aux(const Tp* first,const Tp* last,
+                                    Tp* result,__false_type)
+{
+    Tp* cur = result;
+    STL_TRY
+    {
+        for(;first != last;++first,++cur)
+            construct(cur,*first);
+        return cur;
+    }
+    STL_UNWIND(destroy(result,cur));
+}
+
+//复制构造函数平凡，按字节复制
+template<class Tp>
+inline Tp* __uninitialized_copy_aux(const Tp* first,const Tp* last,
+                                    Tp* result,__true_type)
+{
+    return __copy_trivial(first,last,result);
+}
+
+//指针区间：按复制构造函数是否平凡分派
+template<class Tp>
+inline Tp* uninitialized_copy(const Tp* first,const Tp* last,Tp* result)
+{
+    typedef typename __type_traits<Tp>::has_trivial_copy_constructor trivial_copy;
+    return __uninitialized_copy_aux(first,last,result,trivial_copy());
+}
+
+template<class Tp>
+inline Tp* uninitialized_copy(Tp* first,Tp* last,Tp* result)
+{
+    typedef typename __type_traits<Tp>::has_trivial_copy_constructor trivial_copy;
+    return __uninitialized_copy_aux((const Tp*)first,(const Tp*)last,
+                                    result,trivial_copy());
+}
+
+//将first到last的元素移动到result开始的未初始化区域，返回结束位置。
+//移动之后first到last的元素仍然需要析构。
+template<class InputIter,class ForwardIter>
+inline ForwardIter uninitialized_move(InputIter first,InputIter last,
+                                      ForwardIter result)
+{
+    ForwardIter cur = result;
+    STL_TRY
+    {
+        for(;first != last;++first,++cur)
+            construct(&*cur,STL_MOVE(*first));
+        return cur;
+    }
+    STL_UNWIND(destroy(result,cur));
+}
+
+template<class Tp>
+inline Tp* __uninitialized_move_aux(Tp* first,Tp* last,Tp* result,__false_type)
+{
+    Tp* cur = result;
+    STL_TRY
+    {
+        for(;first != last;++first,++cur)
+            construct(cur,STL_MOVE(*first));
+        return cur;
+    }
+    STL_UNWIND(destroy(result,cur));
+}
+
+template<class Tp>
+inline Tp* __uninitialized_move_aux(Tp* first,Tp* last,Tp* result,__true_type)
+{
+    return __uninitialized_copy_aux((const Tp*)first,(const Tp*)last,
+                                    result,__true_type());
+}
+
+template<class Tp>
+inline Tp* uninitialized_move(Tp* first,Tp* last,Tp* result)
+{
+    typedef typename __type_traits<Tp>::has_trivial_copy_constructor trivial_copy;
+    return __uninitialized_move_aux(first,last,result,trivial_copy());
+}
+
+//扩容时搬移元素：移动构造函数不抛出异常（或者元素不能复制）时移动，
+//否则复制，搬移失败时原来的元素保持不变
+#ifdef STL_CXX11
+template<class InputIter,class ForwardIter>
+inline ForwardIter uninitialized_move_if_noexcept(InputIter first,InputIter last,
+                                                  ForwardIter result)
+{
+    ForwardIter cur = result;
+    STL_TRY
+    {
+        for(;first != last;++first,++cur)
+            construct(&*cur,std::move_if_noexcept(*first));
+        return cur;
+    }
+    STL_UNWIND(destroy(result,cur));
+}
+
+template<class Tp>
+inline Tp* __uninitialized_move_if_noexcept_aux(Tp* first,Tp* last,Tp* result,
+                                                __false_type)
+{
+    Tp* cur = result;
+    STL_TRY
+    {
+        for(;first != last;++first,++cur)
+            construct(cur,std::move_if_noexcept(*first));
+        return cur;
+    }
+    STL_UNWIND(destroy(result,cur));
+}
+
+template<class Tp>
+inline Tp* __uninitialized_move_if_noexcept_aux(Tp* first,Tp* last,Tp* result,
+                                                __true_type)
+{
+    return __uninitialized_copy_aux((const Tp*)first,(const Tp*)last,
+                                    result,__true_type());
+}
+
+template<class Tp>
+inline Tp* uninitialized_move_if_noexcept(Tp* first,Tp* last,Tp* result)
+{
+    typedef typename __type_traits<Tp>::has_trivial_copy_constructor trivial_copy;
+    return __uninitialized_move_if_noexcept_aux(first,last,result,trivial_copy());
+}
+#else
+template<class InputIter,class ForwardIter>
+inline ForwardIter uninitialized_move_if_noexcept(InputIter first,InputIter last,
+                                                  ForwardIter result)
+{
+    return uninitialized_copy(first,last,result);
+}
+#endif
+
 //这个函数运行在finish之前已经初始化的区域
 //template<class InputIter,class ForwardIter>
 //inline ForwardIter copy(InputIter first,InputIter last,ForwardIter result)
@@ -49,6 +185,61 @@ inline ForwardIter uninitialized_fill_n(ForwardIter first,Size n,const Tp& x)
     STL_UNWIND(destroy(first,cur));
 }
 
+template<class Tp,class Size,class Up>
+inline Tp* __uninitialized_fill_n_aux(Tp* first,Size n,const Up& x,__false_type)
+{
+    Tp* cur = first;
+    STL_TRY
+    {
+        for(;n > 0;--n,++cur)
+            construct(cur,x);
+        return cur;
+    }
+    STL_UNWIND(destroy(first,cur));
+}
+
+template<class Tp,class Size,class Up>
+inline Tp* __uninitialized_fill_n_aux(Tp* first,Size n,const Up& x,__true_type)
+{
+    return __fill_n_trivial(first,n,Tp(x));
+}
+
+//指针区间：按复制构造函数是否平凡分派
+template<class Tp,class Size,class Up>
+inline Tp* uninitialized_fill_n(Tp* first,Size n,const Up& x)
+{
+    typedef typename __type_traits<Tp>::has_trivial_copy_constructor trivial_copy;
+    return __uninitialized_fill_n_aux(first,n,x,trivial_copy());
+}
+
+//在未初始化区域默认构造n个元素，返回结束位置。
+//默认构造函数平凡的类型（int、char、POD结构）什么也不写，内容不确定
+template<class Tp,class Size>
+inline Tp* __uninitialized_default_n_aux(Tp* first,Size n,__false_type)
+{
+    Tp* cur = first;
+    STL_TRY
+    {
+        for(;n > 0;--n,++cur)
+            construct(cur);
+        return cur;
+    }
+    STL_UNWIND(destroy(first,cur));
+}
+
+template<class Tp,class Size>
+inline Tp* __uninitialized_default_n_aux(Tp* first,Size n,__true_type)
+{
+    return first + n;
+}
+
+template<class Tp,class Size>
+inline Tp* uninitialized_default_n(Tp* first,Size n)
+{
+    typedef typename __type_traits<Tp>::has_trivial_default_constructor trivial_default;
+    return __uninitialized_default_n_aux(first,n,trivial_default());
+}
+
 STL_END_NAMESPACE
 
 #endif // STL_UINITIALIZED_H
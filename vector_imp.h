@@ -5,11 +5,14 @@
 #define VECTOR_IMP_H
 
 #include "configure.h"
+#include "type_traits.h"
 #include "alloc_imp.h"
 #include "construct.h"
 #include "uninitialized.h"
 #include "algobase.h"
+#include "algo.h"
 #include "iterator_imp.h"
+#include "growth_policy.h"
 
 
 //定义命名空间
@@ -18,24 +21,27 @@ STL_BEGIN_NAMESPACE
 ////////////////////////////////////
 //vector的基类有两个目的：
 //1.提供内存的分配和释放
-//2.封装不同种类的内存分配和释放器
+//2.封装不同种类的内存分配和释放器，分配器实例保存在alloc_holder中
 template <class Tp,class Alloc>
-class vector_base
+class vector_base : protected alloc_holder<Tp,Alloc>
 {
+protected:
+    typedef alloc_holder<Tp,Alloc> data_allocator;
+
 public:
     //返回分配器函数
     typedef Alloc allocator_type;
     allocator_type get_allocator() const
     {
-        return allocator_type();
+        return data_allocator::get_allocator();
     }
 
     //默认构造函数
-    vector_base(const Alloc&)
-        : start(0),finish(0),end_of_storage(0) {}
+    vector_base(const Alloc& a)
+        : data_allocator(a),start(0),finish(0),end_of_storage(0) {}
 
-    vector_base(size_t n,const Alloc&)
-        : start(0),finish(0),end_of_storage(0)
+    vector_base(size_t n,const Alloc& a)
+        : data_allocator(a),start(0),finish(0),end_of_storage(0)
     {
         start = allocate(n);
         finish = start;
@@ -52,8 +58,6 @@ protected:
     Tp* finish;
     Tp* end_of_storage;
 
-    typedef simple_alloc<Tp,Alloc> data_allocator;
-
     //分配n个元素内存空间
     Tp* allocate(size_t n)
     {
@@ -70,7 +74,8 @@ protected:
 
 ////////////////////////////////////
 //vector类实现
-template <class Tp,class Alloc = STL_DEFAULT_ALLOCATOR(Tp)>
+//Growth为空间不足时的扩容策略，见growth_policy.h
+template <class Tp,class Alloc = STL_DEFAULT_ALLOCATOR(Tp),class Growth = growth_double>
 class vector : protected vector_base<Tp,Alloc>
 {
 private:
@@ -99,9 +104,10 @@ public:
     }
 
     //反向迭代器
-    typedef reverse_iterator<const_iterator,value_type,const_reference,
+    //typedef与类模板同名，使用限定名称引用类模板
+    typedef mini_stl::reverse_iterator<const_iterator,value_type,const_reference,
         difference_type> const_reverse_iterator;
-    typedef reverse_iterator<iterator,value_type,reference,difference_type>
+    typedef mini_stl::reverse_iterator<iterator,value_type,reference,difference_type>
         reverse_iterator;
 
 protected:
@@ -112,11 +118,109 @@ protected:
     using Base::end_of_storage;
     using Base::allocate;
     using Base::deallocate;
+    using Base::reallocate;
 
+    //元素可以按位搬移并且分配器提供reallocate时，扩容使用realloc：
+    //可以原地扩充，大块内存由系统重新映射，不需要逐个复制元素
+    typedef typename __and_type<
+        typename __type_traits<Tp>::is_trivially_relocatable,
+        typename alloc_traits<Alloc>::has_reallocate>::type use_reallocate;
 
 protected:
+#ifdef STL_CXX11
+    //在position构造一个新元素，参数转发给元素的构造函数
+    template<class... Args>
+    void insert_aux(iterator position,Args&&... args);
+
+    //空间不足时在position构造新元素
+    template<class... Args>
+    void grow_insert(iterator position,__true_type,Args&&... args);
+    template<class... Args>
+    void grow_insert(iterator position,__false_type,Args&&... args);
+#else
     void insert_aux(iterator position,const Tp& x);
-    void insert_aux(iterator position);
+    void insert_aux(iterator position)
+    {
+        insert_aux(position,Tp());
+    }
+
+    //空间不足时在position插入x
+    void grow_insert(iterator position,__true_type,const Tp& x);
+    void grow_insert(iterator position,__false_type,const Tp& x);
+#endif
+
+    //空间不足时在position插入n个x，新容量为len
+    void grow_fill_insert(iterator position,size_type n,const Tp& x,size_type len,__true_type);
+    void grow_fill_insert(iterator position,size_type n,const Tp& x,size_type len,__false_type);
+
+    //将容量调整为len
+    void reallocate_storage(size_type len)
+    {
+        const size_type old_size = size();
+        start = reallocate(start,capacity(),len);
+        finish = start + old_size;
+        end_of_storage = start + len;
+    }
+
+    //空间不足、需要容纳n个元素时新的容量
+    size_type grow_to(size_type n) const
+    {
+        return __grow_capacity<Growth,Alloc>(size(),n,sizeof(Tp));
+    }
+
+    void reserve_aux(size_type n,__true_type)
+    {
+        reallocate_storage(n);
+    }
+
+    //构造函数：参数为两个整数时是n个value，否则是迭代器区间
+    template<class Integer>
+    void initialize_dispatch(Integer n,Integer value,__true_type)
+    {
+        start = allocate(n);
+        end_of_storage = start + n;
+        finish = uninitialized_fill_n(start,n,value);
+    }
+
+    template<class InputIter>
+    void initialize_dispatch(InputIter first,InputIter last,__false_type)
+    {
+        range_initialize(first,last,iterator_category(first));
+    }
+
+    //输入迭代器只能遍历一次，逐个添加
+    template<class InputIter>
+    void range_initialize(InputIter first,InputIter last,input_iterator_tag)
+    {
+        STL_TRY
+        {
+            for(;first != last;++first)
+                push_back(*first);
+        }
+        STL_UNWIND(clear());
+    }
+
+    //前向迭代器先计算长度，只分配一次
+    template<class ForwardIter>
+    void range_initialize(ForwardIter first,ForwardIter last,forward_iterator_tag)
+    {
+        size_type n = 0;
+        mini_stl::distance(first,last,n);
+        start = allocate(n);
+        end_of_storage = start + n;
+        finish = mini_stl::uninitialized_copy(first,last,start);
+    }
+
+    void reserve_aux(size_type n,__false_type)
+    {
+        const size_type old_size = size();
+        iterator tmp = allocate_and_move(n,start,finish);
+        destroy(start,finish);
+        deallocate(start,end_of_storage-start);
+        start = tmp;
+        finish = tmp + old_size;
+        end_of_storage = start + n;
+    }
 
 public:
 
@@ -139,16 +243,28 @@ public:
     }
 
     //复制构造函数
-    explicit vector(const vector<Tp,Alloc>& x)
+    vector(const vector<Tp,Alloc,Growth>& x)
         : Base(x.size(),x.get_allocator())
     {
         finish = uninitialized_copy(x.begin(),x.end(),start);
     }
 
-    vector(const Tp* first,const Tp* last,const allocator_type& a = allocator_type())
-        : Base(last - first,a)
+#ifdef STL_CXX11
+    //移动构造函数：接管x的存储空间，x变为空
+    vector(vector<Tp,Alloc,Growth>&& x) STL_NOEXCEPT
+        : Base(x.get_allocator())
     {
-        finish = uninitialized_copy(first,last,start);
+        swap(x);
+    }
+#endif
+
+    //使用first到last的元素构造，两个参数都是整数时与vector(n,value)相同
+    template<class InputIter>
+    vector(InputIter first,InputIter last,const allocator_type& a = allocator_type())
+        : Base(a)
+    {
+        typedef typename __is_integer<InputIter>::integral integral;
+        initialize_dispatch(first,last,integral());
     }
 
     ~vector()
@@ -156,7 +272,17 @@ public:
         destroy(start,finish);
     }
 
-    vector<Tp,Alloc>& operator= (const vector<Tp,Alloc>& x);
+    vector<Tp,Alloc,Growth>& operator= (const vector<Tp,Alloc,Growth>& x);
+
+#ifdef STL_CXX11
+    //移动赋值：原来的元素随临时对象析构
+    vector<Tp,Alloc,Growth>& operator= (vector<Tp,Alloc,Growth>&& x) STL_NOEXCEPT
+    {
+        vector<Tp,Alloc,Growth> tmp(STL_MOVE(x));
+        swap(tmp);
+        return *this;
+    }
+#endif
 
     iterator begin()
     {
@@ -235,15 +361,7 @@ public:
     void reserve(size_type n)
     {
         if(capacity() < n)
-        {
-            const size_type old_size = size();
-            iterator tmp = allocate_and_copy(n,start,finish);
-            destroy(start,finish);
-            deallocate(start,end_of_storage-start);
-            start = tmp;
-            finish = tmp + old_size;
-            end_of_storage = start + n;
-        }
+            reserve_aux(n,use_reallocate());
     }
 
     //将vector设置具有n元素，每个元素值为val
@@ -254,6 +372,35 @@ public:
 
     void fill_assign(size_type n,const Tp& val);
 
+    //将vector设置为first到last的元素
+    template<class InputIter>
+    void assign(InputIter first,InputIter last)
+    {
+        typedef typename __is_integer<InputIter>::integral integral;
+        assign_dispatch(first,last,integral());
+    }
+
+protected:
+    template<class Integer>
+    void assign_dispatch(Integer n,Integer val,__true_type)
+    {
+        fill_assign((size_type)n,(Tp)val);
+    }
+
+    template<class InputIter>
+    void assign_dispatch(InputIter first,InputIter last,__false_type)
+    {
+        assign_aux(first,last,iterator_category(first));
+    }
+
+    template<class InputIter>
+    void assign_aux(InputIter first,InputIter last,input_iterator_tag);
+
+    template<class ForwardIter>
+    void assign_aux(ForwardIter first,ForwardIter last,forward_iterator_tag);
+
+public:
+
     //返回第一个元素
     reference front()
     {
@@ -289,6 +436,27 @@ public:
             insert_aux(end(),x);    //内存不够，需要插入元素，很耗时
     }
 
+#ifdef STL_CXX11
+    //移动x到最后
+    void push_back(Tp&& x)
+    {
+        emplace_back(STL_MOVE(x));
+    }
+
+    //在最后直接构造一个元素，参数转发给元素的构造函数
+    template<class... Args>
+    void emplace_back(Args&&... args)
+    {
+        if(finish != end_of_storage)
+        {
+            construct(finish,std::forward<Args>(args)...);
+            ++finish;
+        }
+        else
+            insert_aux(end(),std::forward<Args>(args)...);
+    }
+#endif
+
     //添加一个元素，但是没有设置该元素数值
     void push_back()
     {
@@ -301,9 +469,10 @@ public:
             insert_aux(end());
     }
 
-    //与一个相同类型的vector交换空间,交换空间就可以了
-    void swap(vector<Tp,Alloc>& x)
+    //与一个相同类型的vector交换空间，分配器随空间一起交换
+    void swap(vector<Tp,Alloc,Growth>& x)
     {
+        this->swap_allocator(x);
         std::swap(start,x.start);
         std::swap(finish,x.finish);
         std::swap(end_of_storage,x.end_of_storage);
@@ -327,6 +496,31 @@ public:
         return begin()+n;
     }
 
+#ifdef STL_CXX11
+    //在指定位置移动插入一个元素
+    iterator insert(iterator position,Tp&& x)
+    {
+        return emplace(position,STL_MOVE(x));
+    }
+
+    //在指定位置直接构造一个元素
+    template<class... Args>
+    iterator emplace(iterator position,Args&&... args)
+    {
+        size_type n = position - begin();
+
+        if(finish != end_of_storage && position == end())
+        {
+            construct(finish,std::forward<Args>(args)...);
+            ++finish;
+        }
+        else
+            insert_aux(position,std::forward<Args>(args)...);
+
+        return begin()+n;
+    }
+#endif
+
     //插入一个空元素
      iterator insert(iterator position)
      {
@@ -343,8 +537,13 @@ public:
          return begin() + n;
      }
 
-     //将first到last数据插入到position位置
-     void insert(iterator position,const_iterator first,const_iterator last);
+     //将first到last数据插入到position位置，两个参数都是整数时与insert(position,n,x)相同
+     template<class InputIter>
+     void insert(iterator position,InputIter first,InputIter last)
+     {
+         typedef typename __is_integer<InputIter>::integral integral;
+         insert_dispatch(position,first,last,integral());
+     }
 
      void insert(iterator position,size_type n,const Tp& x)
      {
@@ -366,7 +565,7 @@ public:
      {
          //将position后面所有元素向前移动一位
          if(position + 1 != end())
-             copy(position+1,finish,position);
+             move(position+1,finish,position);
 
          //释放最后一个元素
          --finish;
@@ -378,7 +577,7 @@ public:
      iterator erase(iterator first,iterator last)
      {
          //将last到finish之间的数据覆盖到first
-         iterator i = copy(last,finish,first);
+         iterator i = move(last,finish,first);
 
          //删除已经不被使用的数据
          destroy(i,finish);
@@ -402,6 +601,39 @@ public:
          resize(new_size,Tp());
      }
 
+     //调整大小，新增的元素默认初始化：int、char等平凡类型不写入，内容不确定。
+     //用于随后整体覆盖的缓冲区，例如read()的目标，省去清零
+     void resize_default_init(size_type new_size)
+     {
+         if(new_size < size())
+             erase(begin()+new_size,end());
+         else
+         {
+             if(new_size > capacity())
+                 reserve(grow_to(new_size));
+             finish = uninitialized_default_n(finish,new_size-size());
+         }
+     }
+
+     //在末尾预留n个元素的未初始化空间，返回它的开始位置，size()不变。
+     //调用者在[p,p+n)中构造元素（平凡类型直接写入）之后，用commit计入size()
+     pointer append_uninitialized(size_type n)
+     {
+         if(n > max_size() || size() > max_size() - n)
+         {
+             THROW_LENGTH_ERROR("vector::append_uninitialized");
+         }
+         if(size_type(end_of_storage - finish) < n)
+             reserve(grow_to(size() + n));
+         return finish;
+     }
+
+     //append_uninitialized返回的空间中前n个元素已经构造
+     void commit(size_type n)
+     {
+         finish += n;
+     }
+
      //清空vector
      void clear()
      {
@@ -410,14 +642,47 @@ public:
 
 protected:
 
+     template<class Integer>
+     void insert_dispatch(iterator position,Integer n,Integer x,__true_type)
+     {
+         fill_insert(position,(size_type)n,(Tp)x);
+     }
+
+     template<class InputIter>
+     void insert_dispatch(iterator position,InputIter first,InputIter last,__false_type)
+     {
+         range_insert(position,first,last,iterator_category(first));
+     }
+
+     template<class InputIter>
+     void range_insert(iterator position,InputIter first,InputIter last,input_iterator_tag);
+
+     template<class ForwardIter>
+     void range_insert(iterator position,ForwardIter first,ForwardIter last,
+                       forward_iterator_tag);
+
      //新建一个n个Tp元素空间，将first到last区域复制到新建空间
-     iterator allocate_and_copy(size_type n,const_iterator first,const_iterator last)
+     template<class ForwardIter>
+     iterator allocate_and_copy(size_type n,ForwardIter first,ForwardIter last)
+     {
+         iterator result = allocate(n);
+
+         STL_TRY
+         {
+             mini_stl::uninitialized_copy(first,last,result);
+             return result;
+         }
+         STL_UNWIND(deallocate(result,n))
+     }
+
+     //新建一个n个Tp元素空间，将first到last区域搬移到新建空间
+     iterator allocate_and_move(size_type n,iterator first,iterator last)
      {
          iterator result = allocate(n);
 
          STL_TRY
          {
-             uninitialized_copy(first,last,result);
+             uninitialized_move_if_noexcept(first,last,result);
              return result;
          }
          STL_UNWIND(deallocate(result,n))
@@ -425,57 +690,57 @@ protected:
 };
 
 //重载操作符：==，基础 注意函数参数。
-template<class Tp,class Alloc>
-inline bool operator==(const vector<Tp,Alloc>& x,const vector<Tp,Alloc>& y)
+template<class Tp,class Alloc,class Growth>
+inline bool operator==(const vector<Tp,Alloc,Growth>& x,const vector<Tp,Alloc,Growth>& y)
 {
     return x.size() == y.size() && equal(x.begin(),x.end(),y.begin());
 }
 
 //重载操作符：< 基础
-template<class Tp,class Alloc>
-inline bool operator<(const vector<Tp,Alloc>& x,const vector<Tp,Alloc>& y)
+template<class Tp,class Alloc,class Growth>
+inline bool operator<(const vector<Tp,Alloc,Growth>& x,const vector<Tp,Alloc,Growth>& y)
 {
     return lexicographical_compare(x.begin(),x.end(),y.begin(),y.end());
 }
 
-template<class Tp,class Alloc>
-inline void swap(vector<Tp,Alloc>& x,vector<Tp,Alloc>& y)
+template<class Tp,class Alloc,class Growth>
+inline void swap(vector<Tp,Alloc,Growth>& x,vector<Tp,Alloc,Growth>& y)
 {
     x.swap(y);
 }
 
 //重载操作符：!=
-template<class Tp,class Alloc>
-inline bool operator!=(const vector<Tp,Alloc>& x,const vector<Tp,Alloc>& y)
+template<class Tp,class Alloc,class Growth>
+inline bool operator!=(const vector<Tp,Alloc,Growth>& x,const vector<Tp,Alloc,Growth>& y)
 {
     return !(x == y);
 }
 
 //重载操作符：>
-template<class Tp,class Alloc>
-inline bool operator>(const vector<Tp,Alloc>& x,const vector<Tp,Alloc>& y)
+template<class Tp,class Alloc,class Growth>
+inline bool operator>(const vector<Tp,Alloc,Growth>& x,const vector<Tp,Alloc,Growth>& y)
 {
     return y < x;
 }
 
 //重载操作符：<=
-template<class Tp,class Alloc>
-inline bool operator<=(const vector<Tp,Alloc>& x,const vector<Tp,Alloc>& y)
+template<class Tp,class Alloc,class Growth>
+inline bool operator<=(const vector<Tp,Alloc,Growth>& x,const vector<Tp,Alloc,Growth>& y)
 {
     return !(y < x);
 }
 
 //重载操作符：>=
-template<class Tp,class Alloc>
-inline bool operator >=(const vector<Tp,Alloc>& x,const vector<Tp,Alloc>& y)
+template<class Tp,class Alloc,class Growth>
+inline bool operator >=(const vector<Tp,Alloc,Growth>& x,const vector<Tp,Alloc,Growth>& y)
 {
     return !(x < y);
 }
 
 //vector重载操作符：=,注意返回类型和参数类型
 //返回vector本身
-template<class Tp,class Alloc>
-vector<Tp,Alloc>& vector<Tp,Alloc>::operator=(const vector<Tp,Alloc>& x)
+template<class Tp,class Alloc,class Growth>
+vector<Tp,Alloc,Growth>& vector<Tp,Alloc,Growth>::operator=(const vector<Tp,Alloc,Growth>& x)
 {
     if(&x != this)
     {
@@ -516,13 +781,13 @@ vector<Tp,Alloc>& vector<Tp,Alloc>::operator=(const vector<Tp,Alloc>& x)
     return *this;
 }
 
-template<class Tp,class Alloc>
-void vector<Tp,Alloc>::fill_assign(size_type n,const value_type& val)
+template<class Tp,class Alloc,class Growth>
+void vector<Tp,Alloc,Growth>::fill_assign(size_type n,const value_type& val)
 {
     if(n > capacity())
     {
         //没有空间容纳数据,tmp结束后会调用析构函数
-        vector<Tp,Alloc> tmp(n,val,get_allocator());
+        vector<Tp,Alloc,Growth> tmp(n,val,get_allocator());
         tmp.swap(*this);
     }
     else if(n > size())
@@ -537,9 +802,78 @@ void vector<Tp,Alloc>::fill_assign(size_type n,const value_type& val)
 }
 
 
+#ifdef STL_CXX11
+//插入辅助（auxiliary）函数，在任意元素位置构造一个新的元素
+template <class Tp,class Alloc,class Growth>
+template <class... Args>
+void vector<Tp,Alloc,Growth>::insert_aux(iterator position,Args&&... args)
+{
+    if(finish != end_of_storage)
+    {
+        //参数可能引用vector中的元素，先构造新元素再移动
+        Tp x_copy(std::forward<Args>(args)...);
+        construct(finish,STL_MOVE(*(finish-1)));
+        finish++;
+        move_backward(position,finish-2,finish-1);
+        *position = STL_MOVE(x_copy);
+    }
+    else
+        grow_insert(position,use_reallocate(),std::forward<Args>(args)...);
+}
+
+//元素可以按位搬移：realloc扩充后把position后面的元素整体后移
+template <class Tp,class Alloc,class Growth>
+template <class... Args>
+void vector<Tp,Alloc,Growth>::grow_insert(iterator position,__true_type,Args&&... args)
+{
+    const size_type old_size = size();
+    const size_type len = grow_to(old_size + 1);
+    const size_type elems_before = position - start;
+
+    //参数可能引用vector中的元素，realloc之后就失效了
+    Tp x_copy(std::forward<Args>(args)...);
+    reallocate_storage(len);
+
+    position = start + elems_before;
+    memmove(position + 1,position,(finish - position) * sizeof(Tp));
+    construct(position,STL_MOVE(x_copy));
+    ++finish;
+}
+
+template <class Tp,class Alloc,class Growth>
+template <class... Args>
+void vector<Tp,Alloc,Growth>::grow_insert(iterator position,__false_type,Args&&... args)
+{
+    const size_type old_size = size();
+    const size_type len = grow_to(old_size + 1);
+    iterator new_start = allocate(len);
+    iterator new_pos = new_start + (position - start);
+    iterator new_first = new_pos;   //新空间中已经构造的区间[new_first,new_finish)
+    iterator new_finish = new_pos;
+
+    STL_TRY
+    {
+        //先构造新元素，参数引用的旧元素此时还没有被移动
+        construct(new_pos,std::forward<Args>(args)...);
+        new_finish = new_pos + 1;
+
+        //移动构造函数不抛出异常时移动原有元素，否则复制
+        uninitialized_move_if_noexcept(start,position,new_start);
+        new_first = new_start;
+        new_finish = uninitialized_move_if_noexcept(position,finish,new_finish);
+    }
+    STL_UNWIND((destroy(new_first,new_finish),deallocate(new_start,len)));
+
+    destroy(begin(),end());
+    deallocate(start,end_of_storage-start);
+    start = new_start;
+    finish = new_finish;
+    end_of_storage = new_start+len;
+}
+#else
 //插入辅助（auxiliary）函数，在任意元素位置插入一个新的元素
-template <class Tp,class Alloc>
-void vector<Tp,Alloc>::insert_aux(iterator position,const Tp& x)
+template <class Tp,class Alloc,class Growth>
+void vector<Tp,Alloc,Growth>::insert_aux(iterator position,const Tp& x)
 {
     if(finish != end_of_storage)
     {
@@ -555,83 +889,66 @@ void vector<Tp,Alloc>::insert_aux(iterator position,const Tp& x)
         *position = x_copy;
     }
     else
-    {
-        //没有位置添加新的元素，需要扩充大小
-        const size_type old_size = size();
-
-        //如果还没有建立数据就分配一个元素空间。
-        //如果已经存在元素，需要将原有空间扩充一倍。
-        const size_type len = old_size != 0 ? 2*old_size : 1;
-        iterator new_start = allocate(len);
-        iterator new_finish = new_start;
-
-        STL_TRY
-        {
-            //复制position之前的数据
-            new_finish = uninitialized_copy(start,position,new_start);
-
-            //在position建立数据元素
-            construct(new_finish,x);
-            ++new_finish;
-
-            //复制position后面的元素
-            new_finish = uninitialized_copy(position,finish,new_finish);
-        }
-        STL_UNWIND((destroy(new_start,new_finish),(deallocate(new_start,len))));
+        grow_insert(position,use_reallocate(),x);
+}
 
-        //调用原来对象的析构函数
-        //从这里我们看到使用默认复制函数多么危险，而且申请释放内存也很耗时。
-        //最好一开始就给足内存
-        destroy(begin(),end());
-        deallocate(start,end_of_storage-start);
-        start = new_start;
-        finish = new_finish;
-        end_of_storage = new_start+len;
-    }
+//元素可以按位搬移：realloc扩充后把position后面的元素整体后移
+template <class Tp,class Alloc,class Growth>
+void vector<Tp,Alloc,Growth>::grow_insert(iterator position,__true_type,const Tp& x)
+{
+    const size_type old_size = size();
+    const size_type len = grow_to(old_size + 1);
+    const size_type elems_before = position - start;
+
+    //x可能是vector中的元素，realloc之后就失效了
+    Tp x_copy = x;
+    reallocate_storage(len);
+
+    position = start + elems_before;
+    memmove(position + 1,position,(finish - position) * sizeof(Tp));
+    construct(position,x_copy);
+    ++finish;
 }
 
-template<class Tp,class Alloc>
-void vector<Tp,Alloc>::insert_aux(iterator position)
+template <class Tp,class Alloc,class Growth>
+void vector<Tp,Alloc,Growth>::grow_insert(iterator position,__false_type,const Tp& x)
 {
-    if(finish != end_of_storage)
-    {
-        //有足够空间
-        construct(finish,*(finish-1));
-        ++finish;
-        copy_backward(position,finish-2,finish-1);
-        *position = Tp();
-    }
-    else
-    {
-        //没有足够空间
-        const size_type old_size = size();
-        const size_type len = old_size != 0 ? old_size * 2 : 1;
-        iterator new_start = allocate(len);
-        iterator new_finish = new_start;
+    //没有位置添加新的元素，需要扩充大小
+    const size_type old_size = size();
 
-        STL_TRY
-        {
-            new_finish = uninitialized_copy(start,position,new_start);
-            construct(new_finish);
-            ++new_finish;
-            new_finish = uninitialized_copy(position,finish,new_finish);
-        }
-        STL_UNWIND((destroy(new_start,new_finish),deallocate(new_start,new_finish)));
+    //新的容量由Growth决定，默认为原来的一倍，没有元素时为1
+    const size_type len = grow_to(old_size + 1);
+    iterator new_start = allocate(len);
+    iterator new_finish = new_start;
 
-        destroy(begin(),end());
-        deallocate(start,end_of_storage-start);
-        start = new_start;
-        finish = new_finish;
-        end_of_storage = new_start + len;
+    STL_TRY
+    {
+        //复制position之前的数据
+        new_finish = uninitialized_move_if_noexcept(start,position,new_start);
 
+        //在position建立数据元素
+        construct(new_finish,x);
+        ++new_finish;
+
+        //复制position后面的元素
+        new_finish = uninitialized_move_if_noexcept(position,finish,new_finish);
     }
+    STL_UNWIND((destroy(new_start,new_finish),(deallocate(new_start,len))));
+
+    //调用原来对象的析构函数
+    //从这里我们看到使用默认复制函数多么危险，而且申请释放内存也很耗时。
+    //最好一开始就给足内存
+    destroy(begin(),end());
+    deallocate(start,end_of_storage-start);
+    start = new_start;
+    finish = new_finish;
+    end_of_storage = new_start+len;
 }
-
-
+#endif
 
 //从positon位置开始添加n个新元素，每个元素都使用x初始化
-template<class Tp,class Alloc>
-void vector<Tp,Alloc>::fill_insert(iterator position,size_type n,const Tp& x)
+template<class Tp,class Alloc,class Growth>
+void vector<Tp,Alloc,Growth>::fill_insert(iterator position,size_type n,const Tp& x)
 {
     if(n != 0)
     {
@@ -649,11 +966,11 @@ void vector<Tp,Alloc>::fill_insert(iterator position,size_type n,const Tp& x)
                 //重叠区域进行保护
 
                 //先将finish-n和finish数据复制到finish开始地址
-                uninitialized_copy(finish-n,finish,finish);
+                uninitialized_move(finish-n,finish,finish);
                 finish += n;
 
-                //将postion到old_finish-n数据复制到以old_finish结束地址
-                copy_backward(position,old_finish-n,old_finish);
+                //将postion到old_finish-n数据移动到以old_finish结束地址
+                move_backward(position,old_finish-n,old_finish);
 
                 //填充position到potion+n为x
                 fill(position,position+n,x_copy);
@@ -664,8 +981,8 @@ void vector<Tp,Alloc>::fill_insert(iterator position,size_type n,const Tp& x)
                 uninitialized_fill_n(finish,n-elems_after,x_copy);
                 finish += n-elems_after;
 
-                //将原来的数据复制finish+n-elems_after后
-                uninitialized_copy(position,old_finish,finish);
+                //将原来的数据移动到finish+n-elems_after后
+                uninitialized_move(position,old_finish,finish);
                 finish += elems_after;
 
                 //填充position到old_finish之间的数据
@@ -676,39 +993,124 @@ void vector<Tp,Alloc>::fill_insert(iterator position,size_type n,const Tp& x)
         {
             //空间不够，需要分配新的空间
             const size_type old_size = size();
-            const size_type len = old_size + std::max(old_size,n);
-            iterator new_start = allocate(len);
-            iterator new_finish = new_start;
+            const size_type len = grow_to(old_size + n);
+            grow_fill_insert(position,n,x,len,use_reallocate());
+        }
+    }
+}
 
-            //依次安装各个区域
-            STL_TRY
-            {
-                new_finish = uninitialized_copy(start,position,new_start);
-                new_finish = uninitialized_fill_n(new_finish,n,x);
-                new_finish = uninitialized_copy(position,finish,new_finish);
-            }
-            STL_UNWIND((destroy(new_start,new_finish),deallocate(new_start,len)));
+template<class Tp,class Alloc,class Growth>
+void vector<Tp,Alloc,Growth>::grow_fill_insert(iterator position,size_type n,const Tp& x,
+                                        size_type len,__true_type)
+{
+    const size_type elems_before = position - start;
+    Tp x_copy = x;
+    reallocate_storage(len);
+
+    position = start + elems_before;
+    memmove(position + n,position,(finish - position) * sizeof(Tp));
+    uninitialized_fill_n(position,n,x_copy);
+    finish += n;
+}
 
-            //释放原来的数据区间
-            destroy(start,finish);
-            deallocate(start,end_of_storage-start);
-            start = new_start;
-            finish = new_finish;
-            end_of_storage = new_start+len;
+template<class Tp,class Alloc,class Growth>
+void vector<Tp,Alloc,Growth>::grow_fill_insert(iterator position,size_type n,const Tp& x,
+                                        size_type len,__false_type)
+{
+    iterator new_start = allocate(len);
+    iterator new_pos = new_start + (position - start);
+    iterator new_first = new_pos;   //新空间中已经构造的区间[new_first,new_finish)
+    iterator new_finish = new_pos;
 
-        }
+    //先填充新元素，x可能引用原有元素；再搬移原有元素
+    STL_TRY
+    {
+        new_finish = uninitialized_fill_n(new_pos,n,x);
+        uninitialized_move_if_noexcept(start,position,new_start);
+        new_first = new_start;
+        new_finish = uninitialized_move_if_noexcept(position,finish,new_finish);
     }
+    STL_UNWIND((destroy(new_first,new_finish),deallocate(new_start,len)));
+
+    //释放原来的数据区间
+    destroy(start,finish);
+    deallocate(start,end_of_storage-start);
+    start = new_start;
+    finish = new_finish;
+    end_of_storage = new_start+len;
+}
+
+template<class Tp,class Alloc,class Growth>
+template<class InputIter>
+void vector<Tp,Alloc,Growth>::assign_aux(InputIter first,InputIter last,input_iterator_tag)
+{
+    //先覆盖已有的元素，多余的删除，不够的添加到最后
+    iterator cur = begin();
+    for(;first != last && cur != end();++cur,++first)
+        *cur = *first;
+
+    if(first == last)
+        erase(cur,end());
+    else
+        range_insert(end(),first,last,input_iterator_tag());
 }
 
-//将first到last的元素插入到position位置
-template<class Tp,class Alloc>
-void vector<Tp,Alloc>::insert(iterator position,
-                              const_iterator first,const_iterator last)
+template<class Tp,class Alloc,class Growth>
+template<class ForwardIter>
+void vector<Tp,Alloc,Growth>::assign_aux(ForwardIter first,ForwardIter last,
+                                         forward_iterator_tag)
+{
+    size_type n = 0;
+    mini_stl::distance(first,last,n);
+
+    if(n > capacity())
+    {
+        iterator tmp = allocate_and_copy(n,first,last);
+        destroy(start,finish);
+        deallocate(start,end_of_storage - start);
+        start = tmp;
+        finish = tmp + n;
+        end_of_storage = tmp + n;
+    }
+    else if(size() >= n)
+    {
+        iterator new_finish = mini_stl::copy(first,last,start);
+        destroy(new_finish,finish);
+        finish = new_finish;
+    }
+    else
+    {
+        ForwardIter mid = first;
+        mini_stl::advance(mid,size());
+        mini_stl::copy(first,mid,start);
+        finish = mini_stl::uninitialized_copy(mid,last,finish);
+    }
+}
+
+//输入迭代器不能预先计算长度：逐个添加到最后，扩容按Growth分摊，
+//最后把添加的元素整体旋转到position
+template<class Tp,class Alloc,class Growth>
+template<class InputIter>
+void vector<Tp,Alloc,Growth>::range_insert(iterator position,InputIter first,InputIter last,
+                                           input_iterator_tag)
+{
+    const size_type elems_before = position - start;
+    const size_type old_size = size();
+    for(;first != last;++first)
+        push_back(*first);
+    rotate(start + elems_before,start + old_size,finish);
+}
+
+//将first到last的元素插入到position位置，长度已知，最多分配一次
+template<class Tp,class Alloc,class Growth>
+template<class ForwardIter>
+void vector<Tp,Alloc,Growth>::range_insert(iterator position,ForwardIter first,ForwardIter last,
+                                           forward_iterator_tag)
 {
     if(first != last)
     {
         size_type n = 0;
-        distance(first,last,n);
+        mini_stl::distance(first,last,n);
 
         if(size_type(end_of_storage - finish) >= n)
         {
@@ -719,46 +1121,50 @@ void vector<Tp,Alloc>::insert(iterator position,
             if(elems_after > n)
             {
                 //从position到finish足以保持n个数据
-                uninitialized_copy(finish-n,finish,finish);
+                uninitialized_move(finish-n,finish,finish);
                 finish += n;
-                copy_backward(position,old_finish - n,old_finish);
-                copy(first,last,position);
+                move_backward(position,old_finish - n,old_finish);
+                mini_stl::copy(first,last,position);
             }
             else
             {
                 //操作未初始化区域必须使用uninitialized_copy
                 //finish之前的区域才能使用copy函数。
-                uninitialized_copy(first+elems_after,last,finish);
+                ForwardIter mid = first;
+                mini_stl::advance(mid,elems_after);
+                mini_stl::uninitialized_copy(mid,last,finish);
                 finish += n - elems_after;
-                uninitialized_copy(position,old_finish,finish);
+                uninitialized_move(position,old_finish,finish);
                 finish += elems_after;
-                copy(first,first+elems_after,position);
+                mini_stl::copy(first,mid,position);
             }
         }
         else
         {
             const size_type old_size = size();
-            const size_type len = old_size + std::max(old_size,n);
+            const size_type len = grow_to(old_size + n);
             iterator new_start = allocate(len);
-            iterator new_finish = new_start;
+            iterator new_pos = new_start + (position - start);
+            iterator new_first = new_pos;   //新空间中已经构造的区间[new_first,new_finish)
+            iterator new_finish = new_pos;
 
+            //先复制新元素，再搬移原有元素
             STL_TRY
             {
-                new_finish = uninitialized_copy(start,position,new_start);
-                new_finish = uninitialized_copy(first,last,new_finish);
-                new_finish = uninitialized_copy(position,finish,new_finish);
+                new_finish = mini_stl::uninitialized_copy(first,last,new_pos);
+                uninitialized_move_if_noexcept(start,position,new_start);
+                new_first = new_start;
+                new_finish = uninitialized_move_if_noexcept(position,finish,new_finish);
             }
-            STL_UNWIND((destroy(new_start,new_finish),deallocate(new_start,len)));
+            STL_UNWIND((destroy(new_first,new_finish),deallocate(new_start,len)));
 
             destroy(start,finish);
             deallocate(start,end_of_storage-start);
             start = new_start;
             finish = new_finish;
             end_of_storage = new_start + len;
-
         }
     }
-
 }
 
 